@@ -0,0 +1,125 @@
+#!/usr/bin/env bash
+#@file    bench.sh
+#@brief   runs the OAAR solver on the benchmark families and compares the results with the baseline
+#@author  He Xingqiu
+#
+# usage: bench.sh BINARY [TIMELIMIT] [TOLERANCE] [UPDATE]
+#
+# The instances listed in bench/families.list are generated once into bench/instances. Each one is solved with the
+# given time limit; wall time, root bound, pricing rounds, columns, B&B nodes and peak memory are written to
+# results/bench.<date>.csv. A run is a regression if it is slower or needs more pricing rounds, columns or nodes than
+# the baseline bench/baseline.csv by more than TOLERANCE (relative), or if the root bound changed. With UPDATE=true,
+# or if there is no baseline yet, the results become the new baseline.
+
+BINARY=$1
+TIMELIMIT=${2:-600}
+TOLERANCE=${3:-0.2}
+UPDATE=${4:-false}
+
+GENERATOR=../data/Topology/main
+FAMILIES=bench/families.list
+BASELINE=bench/baseline.csv
+INSTDIR=bench/instances
+
+if test -z "$BINARY" || test ! -x "$BINARY"
+then
+    echo "usage: $0 BINARY [TIMELIMIT] [TOLERANCE] [UPDATE]"
+    exit 1
+fi
+if test ! -x $GENERATOR
+then
+    echo "instance generator $GENERATOR not found, run 'make generator' first"
+    exit 1
+fi
+
+mkdir -p $INSTDIR results
+RESULTS=results/bench.`date +%Y%m%d_%H%M%S`.csv
+echo "instance,status,walltime,rootbound,pricingrounds,columns,nodes,peakmemkb" > $RESULTS
+
+while read -r NAME OPTIONS
+do
+    # skip comments and empty lines
+    case "$NAME" in
+        ""|\#*) continue ;;
+    esac
+
+    INSTANCE=$INSTDIR/$NAME.oaar
+    if test ! -f $INSTANCE
+    then
+        $GENERATOR $OPTIONS -p $NAME -O $INSTANCE || exit 1
+    fi
+
+    LOG=results/bench.$NAME.log
+    echo "solving $NAME"
+
+    START=`date +%s.%N`
+    if test -x /usr/bin/time
+    then
+        /usr/bin/time -f "%M" -o $LOG.mem $BINARY -c "set limits time $TIMELIMIT read $INSTANCE optimize display statistics quit" > $LOG 2>&1
+        PEAKMEM=`tail -1 $LOG.mem`
+        rm -f $LOG.mem
+    else
+        $BINARY -c "set limits time $TIMELIMIT read $INSTANCE optimize display statistics quit" > $LOG 2>&1
+        PEAKMEM=NA
+    fi
+    END=`date +%s.%N`
+
+    # the values are taken from SCIP's statistics output
+    awk -v name=$NAME -v start=$START -v end=$END -v peakmem=$PEAKMEM '
+        BEGIN { status = "unknown"; rootbound = "NA"; rounds = "NA"; columns = "NA"; nodes = "NA"; section = "" }
+        /^SCIP Status *:/ { status = $0; sub(/^[^[]*\[/, "", status); sub(/\].*$/, "", status); gsub(/[ ,]/, "_", status) }
+        /^[A-Za-z&]/ { section = $0; sub(/ *:.*$/, "", section) }
+        section == "Root Node" && /^  Final Dual Bound *:/ { split($0, a, ":"); rootbound = a[2] + 0 }
+        section == "B&B Tree" && /^  nodes *:/ && nodes == "NA" { split($0, a, ":"); split(a[2], b, " "); nodes = b[1] }
+        section == "Pricers" && /^  OAAR *:/ { rounds = $(NF-1); columns = $NF }
+        END { printf("%s,%s,%.2f,%s,%s,%s,%s,%s\n", name, status, end - start, rootbound, rounds, columns, nodes, peakmem) }
+    ' $LOG >> $RESULTS
+done < $FAMILIES
+
+echo "results written to $RESULTS"
+
+if test "$UPDATE" = "true" || test ! -f $BASELINE
+then
+    cp $RESULTS $BASELINE
+    echo "baseline $BASELINE updated"
+    exit 0
+fi
+
+# compare with the baseline; times below one second are too noisy to be compared
+awk -F, -v tol=$TOLERANCE '
+    function worse(new, old) { return new != "NA" && old != "NA" && new + 0 > (old + 0) * (1 + tol) }
+    FNR == 1 { next }
+    NR == FNR { base[$1] = $0; next }
+    !($1 in base) { printf("%-24s new instance, not in the baseline\n", $1); next }
+    {
+        split(base[$1], b, ",")
+        msg = ""
+        if( $2 != b[2] )
+            msg = msg sprintf(" status %s (was %s)", $2, b[2])
+        if( worse($3, b[3]) && $3 - b[3] >= 1.0 )
+            msg = msg sprintf(" time %.2f (was %.2f)", $3, b[3])
+        if( $4 != b[4] )
+            msg = msg sprintf(" root bound %s (was %s)", $4, b[4])
+        if( worse($5, b[5]) )
+            msg = msg sprintf(" pricing rounds %s (was %s)", $5, b[5])
+        if( worse($6, b[6]) )
+            msg = msg sprintf(" columns %s (was %s)", $6, b[6])
+        if( worse($7, b[7]) )
+            msg = msg sprintf(" nodes %s (was %s)", $7, b[7])
+        if( worse($8, b[8]) )
+            msg = msg sprintf(" memory %s kB (was %s kB)", $8, b[8])
+        if( msg != "" )
+        {
+            printf("%-24s REGRESSION:%s\n", $1, msg)
+            nregressions++
+        }
+    }
+    END {
+        if( nregressions > 0 )
+        {
+            printf("%d instances regressed against the baseline\n", nregressions)
+            exit 1
+        }
+        printf("no regressions against the baseline\n")
+    }
+' $BASELINE $RESULTS
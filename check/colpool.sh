@@ -0,0 +1,81 @@
+#!/usr/bin/env bash
+#@file    colpool.sh
+#@brief   checks that the column pool of the OAAR pricer adds deleted columns to the master problem again
+#@author  He Xingqiu
+#
+# usage: colpool.sh BINARY
+#
+# A small instance is solved twice: once with the default settings, and once with settings/colpool.set and an LP
+# column age limit of zero, so that every column which is not in the LP solution is removed from the LP and deleted
+# from the master at the first cleanup. The test fails if the second run restores no column from the pool or if the
+# optimal values differ.
+
+BINARY=$1
+
+GENERATOR=../data/Topology/main
+INSTDIR=bench/instances
+NAME=colpool_ring_n20_f10
+OPTIONS="-m ringtree -n 20 -o 6 -f 10 -s 1"
+
+if test -z "$BINARY" || test ! -x "$BINARY"
+then
+    echo "usage: $0 BINARY"
+    exit 1
+fi
+if test ! -x $GENERATOR
+then
+    echo "instance generator $GENERATOR not found, run 'make generator' first"
+    exit 1
+fi
+
+mkdir -p $INSTDIR results
+INSTANCE=$INSTDIR/$NAME.oaar
+if test ! -f $INSTANCE
+then
+    $GENERATOR $OPTIONS -p $NAME -O $INSTANCE || exit 1
+fi
+
+DEFAULTLOG=results/colpool.default.log
+CLEANUPLOG=results/colpool.cleanup.log
+
+$BINARY -c "read $INSTANCE optimize display statistics quit" > $DEFAULTLOG 2>&1
+$BINARY -c "set load ../settings/colpool.set set lp colagelimit 0 set lp cleanupcols TRUE set lp cleanupcolsroot TRUE \
+    read $INSTANCE optimize display statistics quit" > $CLEANUPLOG 2>&1
+
+# optimal value and number of columns restored from the pool, taken from the statistics output
+getvalues()
+{
+    awk '
+        BEGIN { status = "unknown"; primal = "NA"; restored = "NA" }
+        /^SCIP Status *:/ { status = $0; sub(/^[^[]*\[/, "", status); sub(/\].*$/, "", status) }
+        /^  Primal Bound *:/ && primal == "NA" { split($0, a, ":"); split(a[2], b, " "); primal = b[1] }
+        /^  pool columns *:/ { sub(/^[^(]*\(/, ""); restored = $1 }
+        END { printf("%s,%s,%s\n", status, primal, restored) }
+    ' $1
+}
+
+DEFAULT=`getvalues $DEFAULTLOG`
+CLEANUP=`getvalues $CLEANUPLOG`
+echo "default run (status,primal bound,restored columns): $DEFAULT"
+echo "cleanup run (status,primal bound,restored columns): $CLEANUP"
+
+echo "$DEFAULT,$CLEANUP" | awk -F, '
+    {
+        if( $1 != "optimal solution found" || $4 != "optimal solution found" )
+        {
+            printf("FAILED: instance not solved to optimality, see the logs in results/\n")
+            exit 1
+        }
+        if( $2 - $5 > 1e-6 * (1 + ($2 < 0 ? -$2 : $2)) || $5 - $2 > 1e-6 * (1 + ($2 < 0 ? -$2 : $2)) )
+        {
+            printf("FAILED: optimal values differ: %s with cleanup, %s without\n", $5, $2)
+            exit 1
+        }
+        if( $6 == "NA" || $6 + 0 == 0 )
+        {
+            printf("FAILED: no column was restored from the pool\n")
+            exit 1
+        }
+        printf("passed: %d columns restored from the pool\n", $6)
+    }
+'
@@ -0,0 +1,86 @@
+#!/usr/bin/env bash
+#@file    earlystop.sh
+#@brief   checks that the OAAR pricer stops pricing early by its Lagrangian bound
+#@author  He Xingqiu
+#
+# usage: earlystop.sh BINARY
+#
+# A small instance is solved twice: once without early stopping, and once with pricing/oaar/lagrangegap set to 5%, so
+# that pricing at a node stops as soon as the Lagrangian bound is within 5% of the LP value. Both runs use the default
+# dual smoothing. The test fails if the second run never stops early, if no Lagrangian bound is computed, or if the
+# optimal values differ.
+
+BINARY=$1
+
+GENERATOR=../data/Topology/main
+INSTDIR=bench/instances
+NAME=earlystop_ring_n20_f10
+OPTIONS="-m ringtree -n 20 -o 6 -f 10 -s 2"
+
+if test -z "$BINARY" || test ! -x "$BINARY"
+then
+    echo "usage: $0 BINARY"
+    exit 1
+fi
+if test ! -x $GENERATOR
+then
+    echo "instance generator $GENERATOR not found, run 'make generator' first"
+    exit 1
+fi
+
+mkdir -p $INSTDIR results
+INSTANCE=$INSTDIR/$NAME.oaar
+if test ! -f $INSTANCE
+then
+    $GENERATOR $OPTIONS -p $NAME -O $INSTANCE || exit 1
+fi
+
+EXACTLOG=results/earlystop.exact.log
+EARLYLOG=results/earlystop.early.log
+
+$BINARY -c "read $INSTANCE optimize display statistics quit" > $EXACTLOG 2>&1
+$BINARY -c "set pricing oaar lagrangegap 0.05 read $INSTANCE optimize display statistics quit" > $EARLYLOG 2>&1
+
+# optimal value, number of Lagrangian bounds and number of early stops, taken from the statistics output
+getvalues()
+{
+    awk '
+        BEGIN { status = "unknown"; primal = "NA"; bounds = "NA"; stops = "NA" }
+        /^SCIP Status *:/ { status = $0; sub(/^[^[]*\[/, "", status); sub(/\].*$/, "", status) }
+        /^  Primal Bound *:/ && primal == "NA" { split($0, a, ":"); split(a[2], b, " "); primal = b[1] }
+        /^  Lagrangian bounds *:/ { split($0, a, ":"); split(a[2], b, " "); bounds = b[1];
+            sub(/^.*stopped early at /, ""); stops = $1 }
+        END { printf("%s,%s,%s,%s\n", status, primal, bounds, stops) }
+    ' $1
+}
+
+EXACT=`getvalues $EXACTLOG`
+EARLY=`getvalues $EARLYLOG`
+echo "exact run (status,primal bound,Lagrangian bounds,early stops): $EXACT"
+echo "early run (status,primal bound,Lagrangian bounds,early stops): $EARLY"
+
+echo "$EXACT,$EARLY" | awk -F, '
+    {
+        if( $1 != "optimal solution found" || $5 != "optimal solution found" )
+        {
+            printf("FAILED: instance not solved to optimality, see the logs in results/\n")
+            exit 1
+        }
+        if( $2 - $6 > 1e-6 * (1 + ($2 < 0 ? -$2 : $2)) || $6 - $2 > 1e-6 * (1 + ($2 < 0 ? -$2 : $2)) )
+        {
+            printf("FAILED: optimal values differ: %s with early stopping, %s without\n", $6, $2)
+            exit 1
+        }
+        if( $7 == "NA" || $7 + 0 == 0 )
+        {
+            printf("FAILED: no Lagrangian bound was computed\n")
+            exit 1
+        }
+        if( $8 == "NA" || $8 + 0 == 0 )
+        {
+            printf("FAILED: pricing never stopped early\n")
+            exit 1
+        }
+        printf("passed: %d Lagrangian bounds, pricing stopped early at %d nodes\n", $7, $8)
+    }
+'
@@ -1,279 +1,569 @@
-#include <time.h>
+/**@file   main.c
+ * @brief  generator of OAAR instances
+ * @author He Xingqiu
+ *
+ * Writes a random instance in the .oaar format (see ../OAARformat) to standard output or to a file. All random numbers
+ * come from a generator seeded by the command line, so the same parameters always give the same instance.
+ *
+ * Topology models:
+ *  - waxman   : nodes in the unit square, an edge (u,v) exists with probability beta*exp(-d(u,v)/(alpha*sqrt(2)));
+ *               a spanning tree drawn with the same probabilities keeps the network connected
+ *  - ba       : Barabasi-Albert preferential attachment, every new node is connected to m existing nodes
+ *  - ringtree : the optical nodes form rings which are joined by a ring over their first nodes (ring of rings); the
+ *               electrical nodes form access trees hanging off the optical nodes
+ *
+ * The optical nodes are the nodes 0,...,nOpticalNodes-1. An edge between two electrical nodes becomes an electrical
+ * link, every other edge an optical link. Each edge gives a link in both directions; optical links are written first.
+ *
+ * Traffic follows a gravity model: every node gets a random weight, source and destination of a flow are drawn with
+ * probability proportional to their weights and the bandwidth of a flow is proportional to the product of the weights.
+ * If there are electrical nodes, only they send and receive traffic.
+ *
+ * Flows are written while they are generated, hence their number is only limited by the disk space.
+ */
+
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <malloc.h>
+#include <string.h>
+#include <unistd.h>
 
-typedef struct {
-   double ProcDelay;
-   double QueueDelay;
-   double Jitter;
-   int IsOptical;
-   int nConnLinks;
-   int* ConnLinks;
-} OAARNode;
-
-typedef struct  {
-   int Capacity; 
-   double PropDelay;
-   double BandCost;
-   int IsOptical;
-   int Head;
-   int Tail;
-} OAARLink;
+#define OUTBUFSIZE    (1 << 20)             /* size of the output buffer in bytes */
+
+/* default parameters */
+#define DEFAULT_MODEL         "ringtree"
+#define DEFAULT_NODES         20
+#define DEFAULT_OPTICALNODES  6
+#define DEFAULT_LINKS         60            /* number of links (both directions) for the waxman model */
+#define DEFAULT_FLOWS         10
+#define DEFAULT_SEED          1
+#define DEFAULT_ALPHA         0.4           /* waxman: decay of the edge probability with the distance */
+#define DEFAULT_BETA          0.6           /* waxman: maximal edge probability */
+#define DEFAULT_ATTACH        2             /* ba: number of edges of every new node */
+#define DEFAULT_RINGSIZE      4             /* ringtree: number of optical nodes per ring */
+#define DEFAULT_BANDWIDTH     100.0         /* mean bandwidth of a flow */
 
 typedef struct {
-   int Source;
-   int Destination;
-   double Priority;
-   int BandWidth;
-   double DelayPrice;
-   double JitterPrice;
-} OAARFlow;
-
-void createOpticalNode(OAARNode* Node);
-void createElecNode(OAARNode* Node);
-void createOpticalLink(OAARLink* Link, int Head, int Tail, int i);
-void createElecLink(OAARLink* Link, int Head, int Tail, int i);
-void createFlow(OAARFlow* Flow);
-int intRandom(int low, int high);
-
-OAARNode* Nodes;
-OAARLink* Links;
-OAARFlow* Flows;
-char probName[16] = "data1";
-int nNodes, nOpticalNodes, nLinks, nOpticalLinks, nFlows;
-
-int main()
+   int nNodes;
+   int nOpticalNodes;
+   int nEdges;
+   int sizeEdges;
+   int* Ends;                               /* the two end nodes of each edge */
+   int* Degree;                             /* number of outgoing links of each node */
+   unsigned long long* Hash;                /* hash set of the edges, 0 marks an empty slot */
+   int sizeHash;
+} Graph;
+
+static unsigned long long rngState;
+
+/** returns the next random number of a xorshift64* generator */
+static
+unsigned long long rngNext(void)
+{
+   rngState ^= rngState >> 12;
+   rngState ^= rngState << 25;
+   rngState ^= rngState >> 27;
+   return rngState * 2685821657736338717ULL;
+}
+
+/** returns a uniform random number in [0,1) */
+static
+double realRandom(void)
 {
-   int nElecNodes, nElecNodes1, nElecNodes2, nElecLinks;
-   int i,j,k;
-   int head, tail;
-
-   /* read nNodes, nOpticalNodes, nLinks, nOpticalLinks, nFlows */
-   //printf("Set prob name:\n");
-   //scanf("%s", probName);
-   //printf("\n");
-   //printf("Set nNodes, nOpticalNodes, nLinks, nOpticalLinks, nFlows:\n");
-   //scanf("%d %d %d %d %d", &nNodes, &nOpticalNodes, &nLinks, &nOpticalLinks, &nFlows);
-   //printf("\n");
-
-   nNodes = 5;
-   nOpticalNodes = 2;
-   nLinks = 8;
-   nOpticalLinks = 3;
-   nFlows = 2;
-
-
-   nElecNodes = nNodes - nOpticalNodes;
-   nElecLinks = nLinks - nOpticalLinks;
-   nElecNodes1 = intRandom((int)(0.2*nElecNodes), (int)(0.6*nElecNodes));
-   if(nElecNodes1 == 0) nElecNodes1 = 1;
-   nElecNodes2 = nElecNodes - nElecNodes1;
-
-   /* alloc memory for Nodes, Links, Flows */
-   Nodes = (OAARNode*)malloc(nNodes*sizeof(OAARNode));
-   Links = (OAARLink*)malloc(nLinks*sizeof(OAARLink));
-   Flows = (OAARFlow*)malloc(nFlows*sizeof(OAARFlow));
-
-   srand((int)time(NULL));
-
-   /* create network topology
-    * 1.create a tree for nOpticalNodes 
-    *   including nOpticalNodes optical nodes and nOpticalNodes-1 optical links
-    * 2.add nElecNodes1 (20%~60% of total nElecNodes) elec nodes to the network
-    *   these elec nodes are connected to optical nodes with optical links
-    *   so we will add nElecNodes1 elec nodes and nElecNodes1 optical links here
-    * 3.add remaining elec nodes to the network with elec links(only connected to elec nodes)
-    *   nElecNodes2 = nElecNodes - nElecNodes1
-    *   including nElecNodes2 elec nodes and nElecNodes2 elec links 
-    * 4.to this step, we have already added all optical nodes and elce nodes.
-    *   so we need to add remaining optical links(may between any nodes)
-    *   including nOpticalLinks - (nOpticalNodes-1) - (nElecNodes1) - (0)
-    * 5.add remaining elec links(only between elec nodes)
-    *   including nElecLinks - (0) - (0) - (nElecNodes2)
-    **/
-   for( i = 0; i < nOpticalNodes; i++)
+   return (rngNext() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/** returns a uniform random integer in [low,high] */
+static
+int intRandom(int low, int high)
+{
+   return low + (int)((rngNext() >> 11) % (unsigned long long)(high - low + 1));
+}
+
+/** returns the key of the edge {u,v} in the hash set */
+static
+unsigned long long edgeKey(int u, int v)
+{
+   if( u > v )
    {
-      createOpticalNode(&Nodes[i]);
-      if(i == 0) continue;
-      /* create an optical link with head=i and tail<i */
-      createOpticalLink(&Links[i-1], i, intRandom(0, i-1), i-1); 
+      int t = u;
+      u = v;
+      v = t;
    }
-   for(i = nOpticalNodes; i < nOpticalNodes+nElecNodes1; i++)
+   return ((unsigned long long)u << 32 | (unsigned long long)v) + 1;
+}
+
+/** returns the slot of the edge {u,v} in the hash set; it is empty if the edge does not exist */
+static
+int edgeSlot(Graph* graph, int u, int v)
+{
+   unsigned long long key = edgeKey(u, v);
+   unsigned long long h = key * 0x9E3779B97F4A7C15ULL;
+   int slot = (int)(h >> 33) & (graph->sizeHash - 1);
+
+   while( graph->Hash[slot] != 0 && graph->Hash[slot] != key )
+      slot = (slot + 1) & (graph->sizeHash - 1);
+
+   return slot;
+}
+
+/** allocates the memory of a graph for up to maxEdges edges */
+static
+void graphCreate(Graph* graph, int nNodes, int nOpticalNodes, int maxEdges)
+{
+   graph->nNodes = nNodes;
+   graph->nOpticalNodes = nOpticalNodes;
+   graph->nEdges = 0;
+   graph->sizeEdges = maxEdges;
+   graph->Ends = (int*)malloc(2 * (size_t)maxEdges * sizeof(int));
+   graph->Degree = (int*)calloc((size_t)nNodes, sizeof(int));
+   graph->sizeHash = 1;
+   while( graph->sizeHash < 2 * maxEdges )
+      graph->sizeHash *= 2;
+   graph->Hash = (unsigned long long*)calloc((size_t)graph->sizeHash, sizeof(unsigned long long));
+
+   if( graph->Ends == NULL || graph->Degree == NULL || graph->Hash == NULL )
    {
-      createElecNode(&Nodes[i]);
-	  do{tail = intRandom(0, nOpticalNodes-1);} while(i == tail);
-      createOpticalLink(&Links[i-1], i, tail, i-1);
+      fprintf(stderr, "out of memory\n");
+      exit(1);
    }
-   for(i = nOpticalNodes+nElecNodes1; i < nOpticalNodes+nElecNodes1+nElecNodes2; i++)
+}
+
+/** frees the memory of a graph */
+static
+void graphFree(Graph* graph)
+{
+   free(graph->Hash);
+   free(graph->Degree);
+   free(graph->Ends);
+}
+
+/** adds the edge {u,v}; returns 0 if it is a loop, already exists or the graph is full */
+static
+int addEdge(Graph* graph, int u, int v)
+{
+   int slot;
+
+   if( u == v || graph->nEdges == graph->sizeEdges )
+      return 0;
+
+   slot = edgeSlot(graph, u, v);
+   if( graph->Hash[slot] != 0 )
+      return 0;
+
+   graph->Hash[slot] = edgeKey(u, v);
+   graph->Ends[2*graph->nEdges] = u;
+   graph->Ends[2*graph->nEdges+1] = v;
+   graph->Degree[u]++;
+   graph->Degree[v]++;
+   graph->nEdges++;
+
+   return 1;
+}
+
+/** returns whether the edge with index e is an optical link */
+static
+int isOpticalEdge(Graph* graph, int e)
+{
+   return graph->Ends[2*e] < graph->nOpticalNodes || graph->Ends[2*e+1] < graph->nOpticalNodes;
+}
+
+/** waxman model with nEdges edges */
+static
+void createWaxman(Graph* graph, int nEdges, double alpha, double beta)
+{
+   double* x;
+   double* y;
+   double scale;
+   double d;
+   int u, v;
+   long long ntries;
+
+   x = (double*)malloc((size_t)graph->nNodes * sizeof(double));
+   y = (double*)malloc((size_t)graph->nNodes * sizeof(double));
+   for( u = 0; u < graph->nNodes; u++ )
    {
-      createElecNode(&Nodes[i]);
-	  do{tail = intRandom(nOpticalNodes, i-1);} while(i == tail);
-      createElecLink(&Links[i-1], i, tail, i-1+nOpticalLinks+nElecNodes2-nOpticalNodes+1-nElecNodes);
+      x[u] = realRandom();
+      y[u] = realRandom();
    }
-   for(i = nOpticalNodes-1+nElecNodes; i < nOpticalLinks+nElecNodes2; i++)
+   scale = alpha * sqrt(2.0);
+
+   /* spanning tree: each node is connected to an earlier node drawn by the same rule */
+   for( u = 1; u < graph->nNodes; u++ )
    {
-       head = intRandom(0, nNodes-1);
-	   do{tail = intRandom(0, nNodes-1);} while(i == tail);
-	   createOpticalLink(&Links[i], head, tail, i-nElecNodes2);
+      do
+      {
+         v = intRandom(0, u-1);
+         d = sqrt((x[u]-x[v])*(x[u]-x[v]) + (y[u]-y[v])*(y[u]-y[v]));
+      }
+      while( realRandom() >= beta * exp(-d / scale) );
+      (void) addEdge(graph, u, v);
    }
-   for(i = nOpticalLinks+nElecNodes2; i < nOpticalLinks+nElecLinks; i++)
+
+   /* remaining edges by rejection sampling of random node pairs; stop if the graph is (almost) complete */
+   ntries = 0;
+   while( graph->nEdges < nEdges && ntries < 1000LL * nEdges )
    {
-       head = intRandom(nOpticalNodes, nNodes-1);
-	   do{tail = intRandom(nOpticalNodes, nNodes-1);} while(i == tail);
-	   createElecLink(&Links[i], head, tail, i);
+      ntries++;
+      u = intRandom(0, graph->nNodes-1);
+      v = intRandom(0, graph->nNodes-1);
+      d = sqrt((x[u]-x[v])*(x[u]-x[v]) + (y[u]-y[v])*(y[u]-y[v]));
+      if( realRandom() < beta * exp(-d / scale) )
+         (void) addEdge(graph, u, v);
    }
 
-   /* generate random flow */
-   for(i = 0; i < nFlows; i++)
+   free(y);
+   free(x);
+}
+
+/** Barabasi-Albert model: the first m+1 nodes form a clique, every further node gets m edges */
+static
+void createBarabasiAlbert(Graph* graph, int m)
+{
+   int* endpoints;
+   int nendpoints;
+   int ninit;
+   int u, v;
+   int j;
+
+   /* every edge puts both end nodes into the list, so drawing from it prefers nodes with a large degree */
+   endpoints = (int*)malloc(2 * (size_t)graph->sizeEdges * sizeof(int));
+   nendpoints = 0;
+
+   ninit = m + 1 < graph->nNodes ? m + 1 : graph->nNodes;
+   for( u = 0; u < ninit; u++ )
    {
-      createFlow(&Flows[i]);
+      for( v = 0; v < u; v++ )
+      {
+         if( addEdge(graph, u, v) )
+         {
+            endpoints[nendpoints++] = u;
+            endpoints[nendpoints++] = v;
+         }
+      }
    }
 
-   /* print the result */
-   printf("# probname\n");
-   printf("%s\n", probName);
-   printf("# nNodes nOpticalNodes nLinks nOpticalLinks nFlows\n");
-   printf("%d %d %d %d %d\n", nNodes, nOpticalNodes, nLinks, nOpticalLinks, nFlows);
-   printf("####################\n");
-   k = 0;
-   for(i = 0; i < nNodes; i++)
+   for( u = ninit; u < graph->nNodes; u++ )
    {
-      printf("# node %d\n", k); k++;
-      printf("%lf %lf %lf %d\n", Nodes[i].ProcDelay, Nodes[i].QueueDelay, Nodes[i].Jitter,
-         Nodes[i].IsOptical);
-      printf("%d ", Nodes[i].nConnLinks);
-      for(j = 0; j < Nodes[i].nConnLinks; j++) printf("%d ", Nodes[i].ConnLinks[j]);
-      printf("\n");
+      for( j = 0; j < m; )
+      {
+         v = endpoints[intRandom(0, nendpoints-1)];
+         if( addEdge(graph, u, v) )
+         {
+            endpoints[nendpoints++] = u;
+            endpoints[nendpoints++] = v;
+            j++;
+         }
+      }
    }
-   printf("####################\n");
-   j = 0;
-   for(i = 0; i < nOpticalNodes-1+nElecNodes1; i++)
-   {
-      printf("# link %d\n", j); j++;
-      printf("%d %lf %lf %d\n", Links[i].Capacity, Links[i].PropDelay, Links[i].BandCost,
-         Links[i].IsOptical);
-      printf("%d %d\n", Links[i].Head, Links[i].Tail);
-      /*
-      printf("# link %d\n", j); j++;
-      printf("%d %lf %lf %d\n", Links[i].Capacity, Links[i].PropDelay, Links[i].BandCost,
-         Links[i].IsOptical);
-      printf("%d %d\n", Links[i].Tail, Links[i].Head);
-      */
-  }
-  for(i = nOpticalNodes-1+nElecNodes; i < nOpticalLinks+nElecNodes2; i++)
-  {
-      printf("# link %d\n", j); j++;
-      printf("%d %lf %lf %d\n", Links[i].Capacity, Links[i].PropDelay, Links[i].BandCost,
-         Links[i].IsOptical);
-      printf("%d %d\n", Links[i].Head, Links[i].Tail);
-      /*
-      printf("# link %d\n", j); j++;
-      printf("%d %lf %lf %d\n", Links[i].Capacity, Links[i].PropDelay, Links[i].BandCost,
-         Links[i].IsOptical);
-      printf("%d %d\n", Links[i].Tail, Links[i].Head);
-      */
-  }
-  for(i = nOpticalNodes-1+nElecNodes1; i < nOpticalNodes-1+nElecNodes; i++)
-  {
-      printf("# link %d\n", j); j++;
-      printf("%d %lf %lf %d\n", Links[i].Capacity, Links[i].PropDelay, Links[i].BandCost,
-         Links[i].IsOptical);
-      printf("%d %d\n", Links[i].Head, Links[i].Tail);
-      /*
-      printf("# link %d\n", j); j++;
-      printf("%d %lf %lf %d\n", Links[i].Capacity, Links[i].PropDelay, Links[i].BandCost,
-         Links[i].IsOptical);
-      printf("%d %d\n", Links[i].Tail, Links[i].Head);
-      */
-
-  }
-  for(i = nOpticalLinks+nElecNodes2; i < nOpticalLinks+nElecLinks; i++)
-  {
-      printf("# link %d\n", j); j++;
-      printf("%d %lf %lf %d\n", Links[i].Capacity, Links[i].PropDelay, Links[i].BandCost,
-         Links[i].IsOptical);
-      printf("%d %d\n", Links[i].Head, Links[i].Tail);
-      /*
-      printf("# link %d\n", j); j++;
-      printf("%d %lf %lf %d\n", Links[i].Capacity, Links[i].PropDelay, Links[i].BandCost,
-         Links[i].IsOptical);
-      printf("%d %d\n", Links[i].Tail, Links[i].Head);
-      */
-
-  }
-  printf("####################\n");
-  for(i = 0; i < nFlows; i++)
-  {
-     printf("# flow %d\n", i);
-     printf("%d %d %lf %d %lf %lf\n", Flows[i].Source, Flows[i].Destination, Flows[i].Priority,
-        Flows[i].BandWidth, Flows[i].DelayPrice, Flows[i].JitterPrice);
-  }
-
-  return 0;
+
+   free(endpoints);
 }
 
-void createOpticalNode(OAARNode* Node)
+/** ring of rings of optical nodes with electrical access trees */
+static
+void createRingTree(Graph* graph, int ringsize)
 {
-   Node->ProcDelay = 0;
-   Node->QueueDelay = 0;
-   Node->Jitter = 0;
-   Node->IsOptical = 1;
-   Node->nConnLinks = 0;
-   Node->ConnLinks = (int*)malloc(20*sizeof(int));
+   int nrings;
+   int first, last;
+   int r;
+   int u;
+
+   /* rings of ringsize optical nodes; the last ring takes the remaining ones */
+   nrings = graph->nOpticalNodes / ringsize;
+   if( nrings == 0 && graph->nOpticalNodes > 0 )
+      nrings = 1;
+   for( r = 0; r < nrings; r++ )
+   {
+      first = r * ringsize;
+      last = r == nrings - 1 ? graph->nOpticalNodes - 1 : first + ringsize - 1;
+      for( u = first; u < last; u++ )
+         (void) addEdge(graph, u, u+1);
+      if( last - first >= 2 )
+         (void) addEdge(graph, last, first);
+
+      /* the first nodes of the rings form the outer ring */
+      if( r > 0 )
+         (void) addEdge(graph, (r-1) * ringsize, first);
+   }
+   if( nrings >= 3 )
+      (void) addEdge(graph, (nrings-1) * ringsize, 0);
+
+   /* access trees: an electrical node is attached to an optical node or to an earlier electrical node */
+   for( u = graph->nOpticalNodes; u < graph->nNodes; u++ )
+   {
+      if( graph->nOpticalNodes > 0 && (u == graph->nOpticalNodes || realRandom() < 0.3) )
+         (void) addEdge(graph, u, intRandom(0, graph->nOpticalNodes-1));
+      else if( u > 0 )
+         (void) addEdge(graph, u, intRandom(graph->nOpticalNodes > 0 ? graph->nOpticalNodes : 0, u-1));
+   }
 }
 
-void createElecNode(OAARNode* Node)
+/** draws an index with probability proportional to its weight, given the prefix sums of the weights */
+static
+int drawNode(double* cumweight, int n)
 {
-   Node->ProcDelay = 1;
-   Node->QueueDelay = 1;
-   Node->Jitter = 1;
-   Node->IsOptical = 0;
-   Node->nConnLinks = 0;
-   Node->ConnLinks = (int*)malloc(20*sizeof(int));
+   double r;
+   int lo, hi, mid;
+
+   r = realRandom() * cumweight[n-1];
+   lo = 0;
+   hi = n - 1;
+   while( lo < hi )
+   {
+      mid = (lo + hi) / 2;
+      if( cumweight[mid] <= r )
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+
+   return lo;
 }
 
-void createOpticalLink(OAARLink* Link, int Head, int Tail, int i)
+/** writes the link of edge e from head to tail */
+static
+void printLink(FILE* out, Graph* graph, int e, int head, int tail, int index)
 {
-   Link->Capacity = 1000;
-   Link->PropDelay = 0;
-   Link->BandCost = 1;
-   Link->IsOptical = 1;
-   Link->Head = Head;
-   Link->Tail = Tail;
-
-   Nodes[Head].ConnLinks[Nodes[Head].nConnLinks] = i;
-   Nodes[Head].nConnLinks++;
+   if( isOpticalEdge(graph, e) )
+      fprintf(out, "# link %d\n1000 0 1 1\n%d %d\n", index, head, tail);
+   else
+      fprintf(out, "# link %d\n1000 0.5 2 0\n%d %d\n", index, head, tail);
 }
 
-void createElecLink(OAARLink* Link, int Head, int Tail, int i)
+/** writes the instance; the flows are generated on the fly */
+static
+void printInstance(FILE* out, Graph* graph, const char* probName, int nFlows, double bandwidth)
 {
-   Link->Capacity = 1000;
-   Link->PropDelay = 0.5;
-   Link->BandCost = 2;
-   Link->IsOptical = 0;
-   Link->Head = Head;
-   Link->Tail = Tail;
-
-   Nodes[Head].ConnLinks[Nodes[Head].nConnLinks] = i;
-   Nodes[Head].nConnLinks++;
+   double* weight;
+   double* cumweight;
+   double totalweight;
+   double sumsquares;
+   double norm;
+   int firstEnd;
+   int nEnds;
+   int nOpticalLinks;
+   int index;
+   int source, dest;
+   int bw;
+   int e;
+   int i;
+
+   nOpticalLinks = 0;
+   for( e = 0; e < graph->nEdges; e++ )
+      nOpticalLinks += isOpticalEdge(graph, e) ? 2 : 0;
+
+   fprintf(out, "# probname\n%s\n", probName);
+   fprintf(out, "# nNodes nOpticalNodes nLinks nOpticalLinks nFlows\n");
+   fprintf(out, "%d %d %d %d %d\n", graph->nNodes, graph->nOpticalNodes, 2*graph->nEdges, nOpticalLinks, nFlows);
+   fprintf(out, "####################\n");
+
+   /* only the number of outgoing links is written, the reader builds the adjacency from the links */
+   for( i = 0; i < graph->nNodes; i++ )
+   {
+      if( i < graph->nOpticalNodes )
+         fprintf(out, "# node %d\n0 0 0 1\n%d\n", i, graph->Degree[i]);
+      else
+         fprintf(out, "# node %d\n1 1 1 0\n%d\n", i, graph->Degree[i]);
+   }
+   fprintf(out, "####################\n");
+
+   index = 0;
+   for( e = 0; e < graph->nEdges; e++ )
+   {
+      if( isOpticalEdge(graph, e) )
+      {
+         printLink(out, graph, e, graph->Ends[2*e], graph->Ends[2*e+1], index++);
+         printLink(out, graph, e, graph->Ends[2*e+1], graph->Ends[2*e], index++);
+      }
+   }
+   for( e = 0; e < graph->nEdges; e++ )
+   {
+      if( !isOpticalEdge(graph, e) )
+      {
+         printLink(out, graph, e, graph->Ends[2*e], graph->Ends[2*e+1], index++);
+         printLink(out, graph, e, graph->Ends[2*e+1], graph->Ends[2*e], index++);
+      }
+   }
+   fprintf(out, "####################\n");
+
+   /* gravity model over the nodes which send traffic */
+   firstEnd = graph->nOpticalNodes < graph->nNodes ? graph->nOpticalNodes : 0;
+   nEnds = graph->nNodes - firstEnd;
+   weight = (double*)malloc((size_t)nEnds * sizeof(double));
+   cumweight = (double*)malloc((size_t)nEnds * sizeof(double));
+   totalweight = 0.0;
+   sumsquares = 0.0;
+   for( i = 0; i < nEnds; i++ )
+   {
+      weight[i] = -log(1.0 - realRandom());
+      totalweight += weight[i];
+      sumsquares += weight[i] * weight[i];
+      cumweight[i] = totalweight;
+   }
+   /* expected product of the weights of a pair drawn by the gravity model, which then gets the mean bandwidth */
+   norm = (sumsquares / totalweight) * (sumsquares / totalweight);
+
+   for( i = 0; i < nFlows; i++ )
+   {
+      do
+      {
+         source = drawNode(cumweight, nEnds);
+         dest = drawNode(cumweight, nEnds);
+      }
+      while( source == dest && nEnds > 1 );
+
+      bw = (int)(bandwidth * weight[source] * weight[dest] / norm + 0.5);
+      if( bw < 1 )
+         bw = 1;
+
+      fprintf(out, "# flow %d\n%d %d 1 %d 200 500\n", i, firstEnd + source, firstEnd + dest, bw);
+   }
+
+   free(cumweight);
+   free(weight);
 }
 
-void createFlow(OAARFlow* Flow)
+/** prints the command line options */
+static
+void printUsage(const char* name)
 {
-   Flow->Source = intRandom(0, nNodes-1);
-   Flow->Destination = intRandom(0, nNodes-1);
-   while(Flow->Source == Flow->Destination) Flow->Destination = intRandom(0, nNodes-1);
-   Flow->Priority = 1.0;
-   Flow->BandWidth = 400;
-   Flow->DelayPrice = 200;
-   Flow->JitterPrice = 500;
+   fprintf(stderr,
+      "usage: %s [options]\n"
+      "  -m model     topology model: waxman, ba or ringtree (default %s)\n"
+      "  -n nodes     number of nodes (default %d)\n"
+      "  -o nodes     number of optical nodes (default %d)\n"
+      "  -l links     waxman: number of links, counting both directions (default %d)\n"
+      "  -a alpha     waxman: decay of the edge probability with the distance (default %g)\n"
+      "  -b beta      waxman: maximal edge probability (default %g)\n"
+      "  -k edges     ba: number of edges of every new node (default %d)\n"
+      "  -r size      ringtree: number of optical nodes per ring (default %d)\n"
+      "  -f flows     number of flows (default %d)\n"
+      "  -w bw        mean bandwidth of a flow (default %g)\n"
+      "  -s seed      random seed (default %d)\n"
+      "  -p name      problem name (default: derived from the parameters)\n"
+      "  -O file      output file (default: standard output)\n",
+      name, DEFAULT_MODEL, DEFAULT_NODES, DEFAULT_OPTICALNODES, DEFAULT_LINKS, DEFAULT_ALPHA, DEFAULT_BETA,
+      DEFAULT_ATTACH, DEFAULT_RINGSIZE, DEFAULT_FLOWS, DEFAULT_BANDWIDTH, DEFAULT_SEED);
 }
 
-int intRandom(int low, int high)
+int main(int argc, char** argv)
 {
-   
-   //return low+(int)( (double)(high-low) * (double)rand()/(double)RAND_MAX );
-   if(high == low) return low;
-   else return rand()%(high-low+1)+low;
+   Graph graph;
+   FILE* out;
+   char* outbuf;
+   char probName[256];
+   const char* model = DEFAULT_MODEL;
+   const char* outName = NULL;
+   const char* name = NULL;
+   int nNodes = DEFAULT_NODES;
+   int nOpticalNodes = DEFAULT_OPTICALNODES;
+   int nLinks = DEFAULT_LINKS;
+   int nFlows = DEFAULT_FLOWS;
+   int attach = DEFAULT_ATTACH;
+   int ringsize = DEFAULT_RINGSIZE;
+   double alpha = DEFAULT_ALPHA;
+   double beta = DEFAULT_BETA;
+   double bandwidth = DEFAULT_BANDWIDTH;
+   unsigned long seed = DEFAULT_SEED;
+   int maxEdges;
+   int c;
+
+   while( (c = getopt(argc, argv, "m:n:o:l:a:b:k:r:f:w:s:p:O:h")) != -1 )
+   {
+      switch( c )
+      {
+      case 'm': model = optarg; break;
+      case 'n': nNodes = atoi(optarg); break;
+      case 'o': nOpticalNodes = atoi(optarg); break;
+      case 'l': nLinks = atoi(optarg); break;
+      case 'a': alpha = atof(optarg); break;
+      case 'b': beta = atof(optarg); break;
+      case 'k': attach = atoi(optarg); break;
+      case 'r': ringsize = atoi(optarg); break;
+      case 'f': nFlows = atoi(optarg); break;
+      case 'w': bandwidth = atof(optarg); break;
+      case 's': seed = strtoul(optarg, NULL, 10); break;
+      case 'p': name = optarg; break;
+      case 'O': outName = optarg; break;
+      default:
+         printUsage(argv[0]);
+         return c == 'h' ? 0 : 1;
+      }
+   }
+
+   if( nNodes < 2 || nOpticalNodes < 0 || nOpticalNodes > nNodes || nFlows < 0 || attach < 1 || ringsize < 2
+      || alpha <= 0.0 || beta <= 0.0 || beta > 1.0 || bandwidth <= 0.0 )
+   {
+      fprintf(stderr, "invalid parameters\n");
+      printUsage(argv[0]);
+      return 1;
+   }
+
+   /* splitmix64 step, such that small seeds give unrelated streams and the state is never zero */
+   rngState = (unsigned long long)seed + 0x9E3779B97F4A7C15ULL;
+   rngState = (rngState ^ (rngState >> 30)) * 0xBF58476D1CE4E5B9ULL;
+   rngState = (rngState ^ (rngState >> 27)) * 0x94D049BB133111EBULL;
+   rngState ^= rngState >> 31;
+   if( rngState == 0 )
+      rngState = 1;
+
+   if( strcmp(model, "waxman") == 0 )
+   {
+      maxEdges = nLinks / 2 > nNodes - 1 ? nLinks / 2 : nNodes - 1;
+      graphCreate(&graph, nNodes, nOpticalNodes, maxEdges);
+      createWaxman(&graph, nLinks / 2, alpha, beta);
+   }
+   else if( strcmp(model, "ba") == 0 )
+   {
+      maxEdges = attach * (attach + 1) / 2 + attach * nNodes;
+      graphCreate(&graph, nNodes, nOpticalNodes, maxEdges);
+      createBarabasiAlbert(&graph, attach);
+   }
+   else if( strcmp(model, "ringtree") == 0 )
+   {
+      maxEdges = 2 * nNodes;
+      graphCreate(&graph, nNodes, nOpticalNodes, maxEdges);
+      createRingTree(&graph, ringsize);
+   }
+   else
+   {
+      fprintf(stderr, "unknown topology model <%s>\n", model);
+      return 1;
+   }
+
+   if( name == NULL )
+   {
+      snprintf(probName, sizeof(probName), "%s_n%d_o%d_f%d_s%lu", model, nNodes, nOpticalNodes, nFlows, seed);
+      name = probName;
+   }
+
+   out = stdout;
+   if( outName != NULL )
+   {
+      out = fopen(outName, "w");
+      if( out == NULL )
+      {
+         fprintf(stderr, "cannot open file <%s> for writing\n", outName);
+         graphFree(&graph);
+         return 1;
+      }
+   }
+   outbuf = (char*)malloc(OUTBUFSIZE);
+   if( outbuf != NULL )
+      (void) setvbuf(out, outbuf, _IOFBF, OUTBUFSIZE);
+
+   printInstance(out, &graph, name, nFlows, bandwidth);
+
+   if( fclose(out) != 0 )
+   {
+      fprintf(stderr, "error while writing the instance\n");
+      free(outbuf);
+      graphFree(&graph);
+      return 1;
+   }
+   free(outbuf);
+   graphFree(&graph);
+
+   return 0;
 }
@@ -4,15 +4,8 @@
 
 void printNode(OAARNode Node)
 {
-   int i;
    printf("ProcDleay:%f, QueueDelay:%f, Jitter:%f, IsOptical:%d, nConnLinks:%d\n",
       Node.ProcDelay, Node.QueueDelay, Node.Jitter, Node.IsOptical, Node.nConnLinks);
-   printf("ConnLinks:");
-   for(i = 0; i < Node.nConnLinks; i++)
-   {
-      printf("%d ", Node.ConnLinks[i]);
-   }
-   printf("\n");
 }
 void printLink(OAARLink Link)
 {
@@ -46,3 +39,35 @@ void printFlows(OAARFlow* Flows, int nFlows)
 }
 //#endif
 
+
+/* the flow terms are hoisted out of the loops, which only stream over the arrays of the topology */
+void computeLinkCosts(const OAARTopology* Topology, const OAARFlow* Flow, int first, int last, double* cost)
+{
+   const double* Delay = Topology->Delay;
+   const double* Jitter = Topology->Jitter;
+   const double* BandCost = Topology->BandCost;
+   double priority = Flow->Priority;
+   double delayprice = Flow->DelayPrice;
+   double jitterprice = Flow->JitterPrice;
+   double bandwidth = Flow->BandWidth;
+   int i;
+
+   for(i = first; i < last; i++)
+      cost[i] = priority * (delayprice * Delay[i] + jitterprice * Jitter[i] + bandwidth * BandCost[i]);
+}
+void computeLinkRedcosts(const OAARTopology* Topology, const OAARFlow* Flow, const double* alpha, int first,
+   int last, double* cost)
+{
+   const double* Delay = Topology->Delay;
+   const double* Jitter = Topology->Jitter;
+   const double* BandCost = Topology->BandCost;
+   double priority = Flow->Priority;
+   double delayprice = Flow->DelayPrice;
+   double jitterprice = Flow->JitterPrice;
+   double bandwidth = Flow->BandWidth;
+   int i;
+
+   for(i = first; i < last; i++)
+      cost[i] = priority * (delayprice * Delay[i] + jitterprice * Jitter[i] + bandwidth * BandCost[i])
+         - alpha[i-first] * bandwidth;
+}
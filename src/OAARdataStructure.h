@@ -14,7 +14,6 @@ typedef struct {
    double Jitter;
    int IsOptical;
    int nConnLinks;
-   int* ConnLinks;
 } OAARNode;
 
 typedef struct  {
@@ -27,6 +26,32 @@ typedef struct  {
    int Tail;
 } OAARLink;
 
+/* compressed adjacency of the topology, built once by the problem data.
+ * The links of a node are sorted by index, so its optical links come first:
+ * OutLinks[OutBeg[v]..OutOptEnd[v]) are the optical and OutLinks[OutOptEnd[v]..OutBeg[v+1])
+ * the electrical (and artificial) links leaving node v; the in-links are stored the same way. */
+typedef struct {
+   int* OutBeg;     /* start of the out-links of each node in OutLinks (size nNodes+1) */
+   int* OutOptEnd;  /* end of the optical out-links of each node */
+   int* OutLinks;   /* links grouped by their Head */
+   int* InBeg;      /* start of the in-links of each node in InLinks (size nNodes+1) */
+   int* InOptEnd;   /* end of the optical in-links of each node */
+   int* InLinks;    /* links grouped by their Tail */
+} OAARAdjacency;
+
+/* struct-of-arrays view of the links, built once by the problem data. The parts of the cost of a link which do not
+ * depend on the flow are precomputed, so the cost of routing a flow over link i is
+ * Priority * (DelayPrice * Delay[i] + JitterPrice * Jitter[i] + BandWidth * BandCost[i]). */
+typedef struct {
+   int* Head;         /* Head of each link */
+   int* Tail;         /* Tail of each link */
+   int* Capacity;     /* Capacity of each link */
+   double* Delay;     /* ProcDelay + QueueDelay of the Head plus PropDelay + TransDelay of each link */
+   double* Jitter;    /* Jitter of the Head of each link */
+   double* BandCost;  /* BandCost of each link */
+   int nLinks;        /* number of links, including the artificial ones */
+} OAARTopology;
+
 typedef struct {
    int Source;
    int Destination;
@@ -52,5 +77,11 @@ extern void printLinks(OAARLink* Links, int nLinks);
 extern void printFlows(OAARFlow* Flows, int nFlows);
 //#endif
 
+/* stores in cost[i] the cost of routing Flow over link i, for the links first..last-1 */
+extern void computeLinkCosts(const OAARTopology* Topology, const OAARFlow* Flow, int first, int last, double* cost);
+/* like computeLinkCosts, but subtracts alpha[i-first] * BandWidth, i.e., the dual values of the capacities */
+extern void computeLinkRedcosts(const OAARTopology* Topology, const OAARFlow* Flow, const double* alpha, int first,
+   int last, double* cost);
+
 #endif
 
@@ -3,17 +3,34 @@
  * @brief  branch on the original variable
  * @author He Xingqiu
  *
+ * The value of the original variable x_k_j is the sum of the LP values of the columns of flow k in which variable j is
+ * one. These values are aggregated for all flows in one pass over the fractional columns: all columns of a flow with
+ * a fractional column are fractional, since they sum up to one. The result is kept until the LP changes, so it is
+ * computed at most once per LP solution.
+ *
+ * The candidate x_k_j is chosen by the parameter branching/originalvar/scoring:
+ *  - 'f': the first fractional original variable,
+ *  - 'm': the most fractional original variable,
+ *  - 'p': the best pseudocost score; the pseudocosts of each pair (k, j) are the average increase of the node bound per
+ *         unit of change of x_k_j, learned from the children created for the pair in the ZERO and the ONE direction,
+ *  - 's': strong branching on the candidates with the best pseudocost scores; each child is evaluated by a probing LP
+ *         with a limited number of pricing rounds, in which the pricer respects the branching decision of the child.
+ *
+ * The pseudocosts are only learned if the scoring is 'p' or 's' at the start of the solving process.
  */
 
 /*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
 
-#define SCIP_DEBUG
+//#define SCIP_DEBUG
 
 #include <assert.h>
+#include <limits.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "branch_originalvar.h"
 #include "cons_zeroone.h"
+#include "pricer_OAAR.h"
 #include "probdata_OAAR.h"
 #include "vardata_OAAR.h"
 #include "OAARdataStructure.h"
@@ -29,46 +46,831 @@
 #define BRANCHRULE_MAXDEPTH        -1
 #define BRANCHRULE_MAXBOUNDDIST    1.0
 
+#define EVENTHDLR_NAME             "originalvarpsc"
+#define EVENTHDLR_DESC             "event handler for learning the pseudocosts of the original variables"
+
+/* a child which is pruned without being solved is reported by the node deletion event, which older versions of SCIP
+ * do not have; there, such children are removed from the pending ones when the tree is much smaller than their number
+ */
+#if SCIP_VERSION >= 700
+#define EVENTHDLR_EVENTTYPE        (SCIP_EVENTTYPE_NODESOLVED | SCIP_EVENTTYPE_NODEDELETE)
+#else
+#define EVENTHDLR_EVENTTYPE        SCIP_EVENTTYPE_NODESOLVED
+#endif
+
+#define DEFAULT_SCORING            'f'  /**< scoring of the candidates ('f'irst, 'm'ost fractional, 'p'seudocost,
+                                         *   's'trong branching) */
+#define DEFAULT_SBMAXCANDS         8    /**< number of candidates with the best pseudocost score evaluated by strong
+                                         *   branching */
+#define DEFAULT_SBPRICEROUNDS      2    /**< pricing rounds of a strong branching LP (-1: no limit) */
+
+#define MINGAIN                    1e-6 /**< lower bound of a gain in the product score */
+
 /**@} */
 
-/**@name Callback methods
+/*
+ * Data structures
+ */
+
+/** child of a branching on an original variable whose bound is not yet known */
+typedef struct
+{
+   SCIP_Longint          node;               /**< number of the child node */
+   int                   flow;               /**< flow of the original variable */
+   int                   arc;                /**< index of the original variable */
+   int                   dir;                /**< direction of the child: 0 for ZERO, 1 for ONE */
+   SCIP_Real             parentobj;          /**< LP value of the parent node */
+   SCIP_Real             frac;               /**< value of the original variable in the parent node */
+} PSCPENDING;
+
+/** @brief Branching rule data
+ *
+ *  The aggregated values of the original variables are stored per flow as sparse vectors:
+ *  arcs[flowbeg[k]..flowbeg[k+1]) are the original variables with nonzero value of flow k, in increasing order, and
+ *  arcvals their values.
+ */
+struct SCIP_BranchruleData
+{
+   int*                  flowbeg;            /**< start of the original variables of each flow (size nflows+1) */
+   int*                  arcs;               /**< original variables with nonzero value, grouped by flow */
+   SCIP_Real*            arcvals;            /**< value of each original variable in arcs */
+   int                   arcssize;           /**< size of arcs and arcvals */
+   int                   nflows;             /**< number of flows the arrays are allocated for */
+   SCIP_Real*            xval;               /**< dense accumulator of one flow, zero between uses */
+   int                   nxvals;             /**< size of xval, the number of original variables of a column */
+   SCIP_Longint          cachenode;          /**< number of the node the aggregated values belong to, or -1 */
+   SCIP_Longint          cachelps;           /**< number of LPs solved when the aggregated values were computed */
+
+   char                  scoring;            /**< scoring of the candidates */
+   int                   sbmaxcands;         /**< number of candidates evaluated by strong branching */
+   int                   sbpricerounds;      /**< pricing rounds of a strong branching LP (-1: no limit) */
+
+   SCIP_HASHMAP*         pscmap;             /**< maps a pair (flow, original variable) to its position+1 in pscsum */
+   SCIP_Real*            pscsum;             /**< sum of the unit gains of each pair, ZERO at 2p and ONE at 2p+1 */
+   int*                  psccount;           /**< number of unit gains of each pair, in the same order */
+   int                   npscs;              /**< number of pairs with pseudocosts */
+   int                   pscssize;           /**< size of the pseudocost arrays, in pairs */
+   SCIP_Real             psctotal[2];        /**< sum of all unit gains of each direction */
+   int                   psctotalcount[2];   /**< number of all unit gains of each direction */
+
+   SCIP_HASHMAP*         pendmap;            /**< maps the number of a child node to its position+1 in pending */
+   PSCPENDING*           pending;            /**< children whose bound is not yet known */
+   int                   npending;           /**< number of children whose bound is not yet known */
+   int                   pendingsize;        /**< size of pending */
+   int                   filterpos;          /**< position of the node event in the event filter, or -1 */
+};
+
+
+/**@name Local methods
  *
  * @{
  */
 
-/** branching execution method for fractional LP solutions */
+/** frees the arrays of the aggregated values */
 static
-SCIP_DECL_BRANCHEXECLP(branchExeclpOriginalvar)
-{  /*lint --e{715}*/
-   SCIP_PROBDATA* probdata;
+void freeArcFlows(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_BRANCHRULEDATA*  branchruledata      /**< branching rule data */
+   )
+{
+   SCIPfreeMemoryArrayNull(scip, &branchruledata->flowbeg);
+   SCIPfreeMemoryArrayNull(scip, &branchruledata->arcs);
+   SCIPfreeMemoryArrayNull(scip, &branchruledata->arcvals);
+   SCIPfreeMemoryArrayNull(scip, &branchruledata->xval);
+   branchruledata->arcssize = 0;
+   branchruledata->nflows = 0;
+   branchruledata->nxvals = 0;
+   branchruledata->cachenode = -1;
+}
 
+/** computes the values of the original variables of all flows from the fractional LP candidates, unless they were
+ *  already computed for the current LP solution
+ */
+static
+SCIP_RETCODE computeArcFlows(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_BRANCHRULEDATA*  branchruledata      /**< branching rule data */
+   )
+{
+   SCIP_PROBDATA* probdata;
    SCIP_VAR** lpcands;
    SCIP_Real* lpcandsfrac;
+   SCIP_VARDATA* vardata;
+   SCIP_Real* xval;
+   int* order;
+   int* fill;
+   int* oriVars;
+   int nOriVars;
    int nlpcands;
+   int nFlows;
+   int nOriFlowVars;
+   int narcs;
+   int c;
+   int j;
+   int k;
+   int p;
+   int q;
+
+   assert(branchruledata != NULL);
+
+   if( branchruledata->cachenode == SCIPnodeGetNumber(SCIPgetCurrentNode(scip))
+      && branchruledata->cachelps == SCIPgetNLPs(scip) )
+      return SCIP_OKAY;
+
+   probdata = SCIPgetProbData(scip);
+   assert(probdata != NULL);
+
+   nFlows = SCIPprobdataGetNFlows(probdata);
+   nOriFlowVars = SCIPprobdataGetNLinks(probdata) + 2 * SCIPprobdataGetNOpticalLinks(probdata) * nWaveLength;
+
+   if( branchruledata->nflows != nFlows || branchruledata->nxvals != nOriFlowVars )
+   {
+      freeArcFlows(scip, branchruledata);
+      SCIP_CALL( SCIPallocMemoryArray(scip, &branchruledata->flowbeg, nFlows+1) );
+      SCIP_CALL( SCIPallocClearMemoryArray(scip, &branchruledata->xval, nOriFlowVars) );
+      branchruledata->nflows = nFlows;
+      branchruledata->nxvals = nOriFlowVars;
+   }
+   xval = branchruledata->xval;
+
+   SCIP_CALL( SCIPgetLPBranchCands(scip, &lpcands, NULL, &lpcandsfrac, NULL, &nlpcands, NULL) );
+
+   /* group the candidates by their flow */
+   SCIP_CALL( SCIPallocBufferArray(scip, &order, nlpcands) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &fill, nFlows+1) );
+   for( k = 0; k <= nFlows; k++ )
+      fill[k] = 0;
+   for( c = 0; c < nlpcands; c++ )
+      fill[SCIPvardataGetFlow(SCIPvarGetData(lpcands[c])) + 1]++;
+   for( k = 0; k < nFlows; k++ )
+      fill[k+1] += fill[k];
+   for( c = 0; c < nlpcands; c++ )
+   {
+      k = SCIPvardataGetFlow(SCIPvarGetData(lpcands[c]));
+      order[fill[k]] = c;
+      fill[k]++;
+   }
+
+   /* accumulate the columns of each flow in the dense accumulator and move its nonzeros to the sparse vector */
+   narcs = 0;
+   p = 0;
+   for( k = 0; k < nFlows; k++ )
+   {
+      branchruledata->flowbeg[k] = narcs;
+
+      for( ; p < fill[k]; p++ )
+      {
+         vardata = SCIPvarGetData(lpcands[order[p]]);
+         oriVars = SCIPvardataGetOriVars(vardata);
+         nOriVars = SCIPvardataGetNOriVars(vardata);
+         assert(SCIPvardataGetNOriFlowVars(vardata) == nOriFlowVars);
+
+         for( q = 0; q < nOriVars; q++ )
+         {
+            j = oriVars[q];
+            if( xval[j] == 0.0 )
+            {
+               if( narcs == branchruledata->arcssize )
+               {
+                  branchruledata->arcssize = MAX(1024, 2 * branchruledata->arcssize);
+                  SCIP_CALL( SCIPreallocMemoryArray(scip, &branchruledata->arcs, branchruledata->arcssize) );
+                  SCIP_CALL( SCIPreallocMemoryArray(scip, &branchruledata->arcvals, branchruledata->arcssize) );
+               }
+               branchruledata->arcs[narcs] = j;
+               narcs++;
+            }
+            xval[j] += lpcandsfrac[order[p]];
+         }
+      }
+
+      for( q = branchruledata->flowbeg[k]; q < narcs; q++ )
+      {
+         branchruledata->arcvals[q] = xval[branchruledata->arcs[q]];
+         xval[branchruledata->arcs[q]] = 0.0;
+      }
+      q = branchruledata->flowbeg[k];
+      SCIPsortIntReal(&branchruledata->arcs[q], &branchruledata->arcvals[q], narcs - q);
+   }
+   branchruledata->flowbeg[nFlows] = narcs;
+
+   SCIPfreeBufferArray(scip, &fill);
+   SCIPfreeBufferArray(scip, &order);
+
+   branchruledata->cachenode = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+   branchruledata->cachelps = SCIPgetNLPs(scip);
+
+   SCIPdebugMessage("aggregated %d candidates into %d nonzero original variables\n", nlpcands, narcs);
+
+   return SCIP_OKAY;
+}
+
+/** returns the flow whose original variables in the sparse vectors contain the given position */
+static
+int findFlow(
+   SCIP_BRANCHRULEDATA*  branchruledata,     /**< branching rule data */
+   int                   p                   /**< position in arcs */
+   )
+{
+   int left;
+   int right;
+   int mid;
+
+   /* find the last flow k with flowbeg[k] <= p; flows without nonzero are skipped since flowbeg[k] == flowbeg[k+1] */
+   left = 0;
+   right = branchruledata->nflows - 1;
+   while( left < right )
+   {
+      mid = (left + right + 1) / 2;
+      if( branchruledata->flowbeg[mid] <= p )
+         left = mid;
+      else
+         right = mid - 1;
+   }
+   assert(branchruledata->flowbeg[left] <= p && p < branchruledata->flowbeg[left+1]);
+
+   return left;
+}
+
+/** returns the hash map key of the pair of flow k and original variable j */
+static
+void* pscKey(
+   SCIP_BRANCHRULEDATA*  branchruledata,     /**< branching rule data */
+   int                   k,                  /**< index of the flow */
+   int                   j                   /**< index of the original variable */
+   )
+{
+   return (void*)(size_t)((size_t)k * (size_t)branchruledata->nxvals + (size_t)j + 1);
+}
+
+/** frees the pseudocosts and the children whose bound is not yet known */
+static
+void freePseudocosts(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_BRANCHRULEDATA*  branchruledata      /**< branching rule data */
+   )
+{
+   if( branchruledata->pscmap != NULL )
+      SCIPhashmapFree(&branchruledata->pscmap);
+   if( branchruledata->pendmap != NULL )
+      SCIPhashmapFree(&branchruledata->pendmap);
+   SCIPfreeMemoryArrayNull(scip, &branchruledata->pscsum);
+   SCIPfreeMemoryArrayNull(scip, &branchruledata->psccount);
+   SCIPfreeMemoryArrayNull(scip, &branchruledata->pending);
+   branchruledata->npscs = 0;
+   branchruledata->pscssize = 0;
+   branchruledata->psctotal[0] = 0.0;
+   branchruledata->psctotal[1] = 0.0;
+   branchruledata->psctotalcount[0] = 0;
+   branchruledata->psctotalcount[1] = 0;
+   branchruledata->npending = 0;
+   branchruledata->pendingsize = 0;
+}
+
+/** returns the pseudocost of the pair of flow k and original variable j in the given direction; pairs without
+ *  observation get the average of all pairs, or 1 if there is none, which turns the score into most fractional
+ */
+static
+SCIP_Real getPseudocost(
+   SCIP_BRANCHRULEDATA*  branchruledata,     /**< branching rule data */
+   int                   k,                  /**< index of the flow */
+   int                   j,                  /**< index of the original variable */
+   int                   dir                 /**< direction: 0 for ZERO, 1 for ONE */
+   )
+{
+   int p;
+
+   if( branchruledata->pscmap != NULL )
+   {
+      p = (int)(size_t)SCIPhashmapGetImage(branchruledata->pscmap, pscKey(branchruledata, k, j)) - 1;
+      if( p >= 0 && branchruledata->psccount[2*p+dir] > 0 )
+         return branchruledata->pscsum[2*p+dir] / branchruledata->psccount[2*p+dir];
+   }
+
+   if( branchruledata->psctotalcount[dir] > 0 )
+      return branchruledata->psctotal[dir] / branchruledata->psctotalcount[dir];
+
+   return 1.0;
+}
+
+/** adds the bound increase of a child to the pseudocosts of the pair of flow k and original variable j */
+static
+SCIP_RETCODE updatePseudocost(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_BRANCHRULEDATA*  branchruledata,     /**< branching rule data */
+   int                   k,                  /**< index of the flow */
+   int                   j,                  /**< index of the original variable */
+   int                   dir,                /**< direction: 0 for ZERO, 1 for ONE */
+   SCIP_Real             gain,               /**< increase of the bound of the child */
+   SCIP_Real             frac                /**< value of the original variable in the parent */
+   )
+{
+   SCIP_Real delta;
+   SCIP_Real unitgain;
+   void* key;
+   int p;
+
+   assert(branchruledata->pscmap != NULL);
+
+   delta = (dir == 0 ? frac : 1.0 - frac);
+   if( SCIPisFeasZero(scip, delta) )
+      return SCIP_OKAY;
+   unitgain = MAX(gain, 0.0) / delta;
+
+   key = pscKey(branchruledata, k, j);
+   p = (int)(size_t)SCIPhashmapGetImage(branchruledata->pscmap, key) - 1;
+   if( p < 0 )
+   {
+      if( branchruledata->npscs == branchruledata->pscssize )
+      {
+         branchruledata->pscssize = MAX(64, 2 * branchruledata->pscssize);
+         SCIP_CALL( SCIPreallocMemoryArray(scip, &branchruledata->pscsum, 2 * branchruledata->pscssize) );
+         SCIP_CALL( SCIPreallocMemoryArray(scip, &branchruledata->psccount, 2 * branchruledata->pscssize) );
+      }
+      p = branchruledata->npscs;
+      branchruledata->pscsum[2*p] = 0.0;
+      branchruledata->pscsum[2*p+1] = 0.0;
+      branchruledata->psccount[2*p] = 0;
+      branchruledata->psccount[2*p+1] = 0;
+      branchruledata->npscs++;
+      SCIP_CALL( SCIPhashmapInsert(branchruledata->pscmap, key, (void*)(size_t)(p+1)) );
+   }
+
+   branchruledata->pscsum[2*p+dir] += unitgain;
+   branchruledata->psccount[2*p+dir]++;
+   branchruledata->psctotal[dir] += unitgain;
+   branchruledata->psctotalcount[dir]++;
+
+   SCIPdebugMessage("pseudocost of x_%d_%d in direction %d: unit gain %g, average %g\n", k, j, dir, unitgain,
+      branchruledata->pscsum[2*p+dir] / branchruledata->psccount[2*p+dir]);
+
+   return SCIP_OKAY;
+}
+
+/** remembers a child of a branching on the pair of flow k and original variable j until its bound is known */
+static
+SCIP_RETCODE addPending(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_BRANCHRULEDATA*  branchruledata,     /**< branching rule data */
+   SCIP_NODE*            child,              /**< child node */
+   int                   k,                  /**< index of the flow */
+   int                   j,                  /**< index of the original variable */
+   int                   dir,                /**< direction of the child: 0 for ZERO, 1 for ONE */
+   SCIP_Real             parentobj,          /**< LP value of the parent */
+   SCIP_Real             frac                /**< value of the original variable in the parent */
+   )
+{
+   PSCPENDING* pending;
+
+   assert(branchruledata->pendmap != NULL);
+
+   if( branchruledata->npending == branchruledata->pendingsize )
+   {
+      branchruledata->pendingsize = MAX(64, 2 * branchruledata->pendingsize);
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &branchruledata->pending, branchruledata->pendingsize) );
+   }
+
+   pending = &branchruledata->pending[branchruledata->npending];
+   pending->node = SCIPnodeGetNumber(child);
+   pending->flow = k;
+   pending->arc = j;
+   pending->dir = dir;
+   pending->parentobj = parentobj;
+   pending->frac = frac;
+   branchruledata->npending++;
+
+   SCIP_CALL( SCIPhashmapInsert(branchruledata->pendmap, (void*)(size_t)pending->node,
+         (void*)(size_t)branchruledata->npending) );
+
+   return SCIP_OKAY;
+}
+
+/** removes the child at the given position of the pending children; the last one takes its place */
+static
+SCIP_RETCODE removePending(
+   SCIP_BRANCHRULEDATA*  branchruledata,     /**< branching rule data */
+   int                   p                   /**< position of the child */
+   )
+{
+   PSCPENDING* last;
+
+   assert(0 <= p && p < branchruledata->npending);
+
+   SCIP_CALL( SCIPhashmapRemove(branchruledata->pendmap, (void*)(size_t)branchruledata->pending[p].node) );
+
+   branchruledata->npending--;
+   if( p < branchruledata->npending )
+   {
+      last = &branchruledata->pending[branchruledata->npending];
+      branchruledata->pending[p] = *last;
+      SCIP_CALL( SCIPhashmapRemove(branchruledata->pendmap, (void*)(size_t)last->node) );
+      SCIP_CALL( SCIPhashmapInsert(branchruledata->pendmap, (void*)(size_t)last->node, (void*)(size_t)(p+1)) );
+   }
+
+   return SCIP_OKAY;
+}
+
+#if SCIP_VERSION < 700
+/** removes the pending children which were pruned without being solved, i.e., which are neither open nor the focus
+ *  node; this is only done if there are considerably more pending children than open nodes
+ */
+static
+SCIP_RETCODE removeStalePending(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_BRANCHRULEDATA*  branchruledata      /**< branching rule data */
+   )
+{
+   SCIP_NODE** leaves;
+   SCIP_NODE** children;
+   SCIP_NODE** siblings;
+   SCIP_Longint* open;
+   int nleaves;
+   int nchildren;
+   int nsiblings;
+   int nopen;
+   int pos;
+   int p;
+
+   if( branchruledata->npending <= 2 * (SCIPgetNNodesLeft(scip) + 1) )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPgetOpenNodesData(scip, &leaves, &children, &siblings, &nleaves, &nchildren, &nsiblings) );
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &open, nleaves + nchildren + nsiblings + 1) );
+   nopen = 0;
+   for( p = 0; p < nleaves; p++ )
+      open[nopen++] = SCIPnodeGetNumber(leaves[p]);
+   for( p = 0; p < nchildren; p++ )
+      open[nopen++] = SCIPnodeGetNumber(children[p]);
+   for( p = 0; p < nsiblings; p++ )
+      open[nopen++] = SCIPnodeGetNumber(siblings[p]);
+   open[nopen++] = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+   SCIPsortLong(open, nopen);
+
+   /* removing a child moves the last one to its position, which is checked next */
+   p = 0;
+   while( p < branchruledata->npending )
+   {
+      if( SCIPsortedvecFindLong(open, branchruledata->pending[p].node, nopen, &pos) )
+         p++;
+      else
+      {
+         SCIP_CALL( removePending(branchruledata, p) );
+      }
+   }
+
+   SCIPfreeBufferArray(scip, &open);
+
+   return SCIP_OKAY;
+}
+#endif
+
+/** evaluates the child of a branching on the pair of flow k and original variable j by a probing LP with restricted
+ *  pricing; the columns of flow k violating the decision are fixed to zero and the pricer only generates columns
+ *  respecting it
+ */
+static
+SCIP_RETCODE evaluateChild(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_BRANCHRULEDATA*  branchruledata,     /**< branching rule data */
+   int                   k,                  /**< index of the flow */
+   int                   j,                  /**< index of the original variable */
+   CONSTYPE              type,               /**< decision of the child */
+   SCIP_Real             lpobjval,           /**< LP value of the current node */
+   SCIP_Real*            gain,               /**< pointer to store the increase of the LP value */
+   SCIP_Bool*            valid,              /**< pointer to store whether the gain is a valid observation */
+   SCIP_Bool*            cutoff              /**< pointer to store whether the child is infeasible */
+   )
+{
+   SCIP_PROBDATA* probdata;
+   SCIP_VAR** vars;
+   SCIP_VAR* var;
+   uint64_t* bits;
+   int* cols;
+   SCIP_Bool lperror;
+   SCIP_Bool isone;
+   int ncols;
+   int c;
+
+   *gain = 0.0;
+   *valid = FALSE;
+   *cutoff = FALSE;
+   lperror = FALSE;
+
+   SCIP_CALL( SCIPnewProbingNode(scip) );
+
+   probdata = SCIPgetProbData(scip);
+   vars = SCIPprobdataGetVars(probdata);
+   cols = SCIPprobdataGetFlowVars(probdata, k);
+   ncols = SCIPprobdataGetNFlowVars(probdata, k);
+   bits = SCIPprobdataGetFlowVarBits(probdata, k, j);
+
+   for( c = 0; c < ncols && !(*cutoff); c++ )
+   {
+      isone = (bits != NULL && ((bits[c / 64] >> (c % 64)) & 1) != 0);
+      if( isone == (type == ONE) )
+         continue;
+
+      var = vars[cols[c]];
+      if( SCIPvarGetUbLocal(var) < 0.5 || SCIPvarIsDeleted(var) )
+         continue;
+      if( SCIPvarGetLbLocal(var) > 0.5 )
+         *cutoff = TRUE;
+      else
+      {
+         SCIP_CALL( SCIPchgVarUbProbing(scip, var, 0.0) );
+      }
+   }
+
+   if( !(*cutoff) )
+   {
+      SCIP_CALL( SCIPpricerOAARSetProbingDecision(scip, k, j, type) );
+      SCIP_CALL( SCIPsolveProbingLPWithPricing(scip, FALSE, FALSE, branchruledata->sbpricerounds, &lperror, cutoff) );
+      SCIP_CALL( SCIPpricerOAARSetProbingDecision(scip, -1, -1, type) );
+   }
+
+   /* with a pricing round limit, the LP value only estimates the bound of the child, which is enough for scoring */
+   if( !(*cutoff) && !lperror && SCIPgetLPSolstat(scip) == SCIP_LPSOLSTAT_OPTIMAL )
+   {
+      *gain = MAX(SCIPgetLPObjval(scip) - lpobjval, 0.0);
+      *valid = TRUE;
+   }
+
+   SCIP_CALL( SCIPbacktrackProbing(scip, 0) );
+
+   return SCIP_OKAY;
+}
+
+/** selects the original variable to branch on among the fractional ones according to the scoring parameter */
+static
+SCIP_RETCODE selectCandidate(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_BRANCHRULEDATA*  branchruledata,     /**< branching rule data */
+   SCIP_Real             lpobjval,           /**< LP value of the current node */
+   int*                  index1,             /**< pointer to store the flow of the chosen variable, or -1 */
+   int*                  index2,             /**< pointer to store the index of the chosen variable */
+   SCIP_Real*            fracOriVal          /**< pointer to store the value of the chosen variable */
+   )
+{
+   SCIP_Real* scores;
+   int* cands;
+   SCIP_Real score;
+   SCIP_Real bestscore;
+   SCIP_Real x;
+   SCIP_Real gain[2];
+   SCIP_Bool valid[2];
+   SCIP_Bool cutoff[2];
+   int ncands;
+   int nsbcands;
+   int best;
+   int dir;
+   int c;
+   int k;
+   int p;
+
+   *index1 = -1;
+   *index2 = -1;
+   *fracOriVal = 0.0;
+
+   /* collect the fractional original variables as positions in the sparse vectors and score them */
+   SCIP_CALL( SCIPallocBufferArray(scip, &cands, branchruledata->flowbeg[branchruledata->nflows] + 1) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &scores, branchruledata->flowbeg[branchruledata->nflows] + 1) );
+   ncands = 0;
+   best = -1;
+   bestscore = -1.0;
+   for( k = 0; k < branchruledata->nflows; k++ )
+   {
+      for( p = branchruledata->flowbeg[k]; p < branchruledata->flowbeg[k+1]; p++ )
+      {
+         x = branchruledata->arcvals[p];
+         if( SCIPisFeasIntegral(scip, x) )
+            continue;
+
+         switch( branchruledata->scoring )
+         {
+         case 'f':
+            score = -ncands;
+            break;
+         case 'm':
+            score = MIN(x, 1.0 - x);
+            break;
+         default:
+            score = MAX(getPseudocost(branchruledata, k, branchruledata->arcs[p], 0) * x, MINGAIN)
+               * MAX(getPseudocost(branchruledata, k, branchruledata->arcs[p], 1) * (1.0 - x), MINGAIN);
+            break;
+         }
+
+         if( best < 0 || score > bestscore )
+         {
+            best = p;
+            bestscore = score;
+         }
+         cands[ncands] = p;
+         scores[ncands] = score;
+         ncands++;
+
+         if( branchruledata->scoring == 'f' )
+            break;
+      }
+      if( branchruledata->scoring == 'f' && ncands > 0 )
+         break;
+   }
+
+   /* evaluate the candidates with the best pseudocost scores by strong branching */
+   if( branchruledata->scoring == 's' && ncands > 1 && branchruledata->sbmaxcands > 0 )
+   {
+      SCIPsortDownRealInt(scores, cands, ncands);
+      nsbcands = MIN(ncands, branchruledata->sbmaxcands);
+
+      SCIP_CALL( SCIPstartProbing(scip) );
+
+      best = cands[0];
+      bestscore = -1.0;
+      for( c = 0; c < nsbcands; c++ )
+      {
+         p = cands[c];
+         x = branchruledata->arcvals[p];
+         k = findFlow(branchruledata, p);
+
+         for( dir = 0; dir < 2; dir++ )
+         {
+            SCIP_CALL( evaluateChild(scip, branchruledata, k, branchruledata->arcs[p], dir == 0 ? ZERO : ONE, lpobjval,
+                  &gain[dir], &valid[dir], &cutoff[dir]) );
+            if( valid[dir] && branchruledata->pscmap != NULL )
+            {
+               SCIP_CALL( updatePseudocost(scip, branchruledata, k, branchruledata->arcs[p], dir, gain[dir], x) );
+            }
+         }
+
+         SCIPdebugMessage("strong branching on x_%d_%d: gains %g%s, %g%s\n", k, branchruledata->arcs[p],
+            gain[0], cutoff[0] ? " (cutoff)" : "", gain[1], cutoff[1] ? " (cutoff)" : "");
+
+         /* a child which is infeasible is pruned right away, so this candidate is taken */
+         if( cutoff[0] || cutoff[1] )
+         {
+            best = p;
+            break;
+         }
+
+         score = MAX(gain[0], MINGAIN) * MAX(gain[1], MINGAIN);
+         if( score > bestscore )
+         {
+            best = p;
+            bestscore = score;
+         }
+      }
+
+      SCIP_CALL( SCIPendProbing(scip) );
+   }
+
+   if( best >= 0 )
+   {
+      *index1 = findFlow(branchruledata, best);
+      *index2 = branchruledata->arcs[best];
+      *fracOriVal = branchruledata->arcvals[best];
+   }
+
+   SCIPfreeBufferArray(scip, &scores);
+   SCIPfreeBufferArray(scip, &cands);
+
+   return SCIP_OKAY;
+}
+
+/**@} */
+
+/**@name Event handler callback methods
+ *
+ * @{
+ */
+
+/** execution method of the event handler: learns the pseudocosts from the bound of a solved child and forgets
+ *  children which are deleted without being solved
+ */
+static
+SCIP_DECL_EVENTEXEC(eventExecOriginalvarPsc)
+{  /*lint --e{715}*/
+   SCIP_BRANCHRULEDATA* branchruledata;
+   SCIP_BRANCHRULE* branchrule;
+   SCIP_NODE* node;
+   PSCPENDING* pending;
+   SCIP_Real lowerbound;
+   int p;
+
+   assert(eventhdlr != NULL);
+   assert(strcmp(SCIPeventhdlrGetName(eventhdlr), EVENTHDLR_NAME) == 0);
+   assert(event != NULL);
+
+   branchrule = SCIPfindBranchrule(scip, BRANCHRULE_NAME);
+   assert(branchrule != NULL);
+   branchruledata = SCIPbranchruleGetData(branchrule);
+   assert(branchruledata != NULL);
+
+   if( branchruledata->pendmap == NULL )
+      return SCIP_OKAY;
+
+   node = SCIPeventGetNode(event);
+   p = (int)(size_t)SCIPhashmapGetImage(branchruledata->pendmap, (void*)(size_t)SCIPnodeGetNumber(node)) - 1;
+   if( p < 0 )
+      return SCIP_OKAY;
+
+   /* an infeasible child has no finite bound and a deleted one was pruned without being solved; neither counts as an
+    * observation
+    */
+   pending = &branchruledata->pending[p];
+   lowerbound = SCIPnodeGetLowerbound(node);
+   if( (SCIPeventGetType(event) & SCIP_EVENTTYPE_NODESOLVED) != 0
+      && SCIPeventGetType(event) != SCIP_EVENTTYPE_NODEINFEASIBLE && !SCIPisInfinity(scip, lowerbound) )
+   {
+      SCIP_CALL( updatePseudocost(scip, branchruledata, pending->flow, pending->arc, pending->dir,
+            lowerbound - pending->parentobj, pending->frac) );
+   }
+
+   SCIP_CALL( removePending(branchruledata, p) );
+
+   return SCIP_OKAY;
+}
+
+/**@} */
+
+/**@name Callback methods
+ *
+ * @{
+ */
+
+/** destructor of branching rule to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_BRANCHFREE(branchFreeOriginalvar)
+{  /*lint --e{715}*/
+   SCIP_BRANCHRULEDATA* branchruledata;
+
+   branchruledata = SCIPbranchruleGetData(branchrule);
+   assert(branchruledata != NULL);
+
+   freeArcFlows(scip, branchruledata);
+   freePseudocosts(scip, branchruledata);
+   SCIPfreeMemory(scip, &branchruledata);
+   SCIPbranchruleSetData(branchrule, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of branching rule (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_BRANCHINITSOL(branchInitsolOriginalvar)
+{  /*lint --e{715}*/
+   SCIP_BRANCHRULEDATA* branchruledata;
+
+   branchruledata = SCIPbranchruleGetData(branchrule);
+   assert(branchruledata != NULL);
+   assert(branchruledata->pscmap == NULL);
+   assert(branchruledata->filterpos == -1);
+
+   if( branchruledata->scoring != 'p' && branchruledata->scoring != 's' )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPhashmapCreate(&branchruledata->pscmap, SCIPblkmem(scip), 1024) );
+   SCIP_CALL( SCIPhashmapCreate(&branchruledata->pendmap, SCIPblkmem(scip), 1024) );
+   SCIP_CALL( SCIPcatchEvent(scip, EVENTHDLR_EVENTTYPE, SCIPfindEventhdlr(scip, EVENTHDLR_NAME), NULL,
+         &branchruledata->filterpos) );
+
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of branching rule (called before branch and bound process data is freed) */
+static
+SCIP_DECL_BRANCHEXITSOL(branchExitsolOriginalvar)
+{  /*lint --e{715}*/
+   SCIP_BRANCHRULEDATA* branchruledata;
+
+   branchruledata = SCIPbranchruleGetData(branchrule);
+   assert(branchruledata != NULL);
+
+   if( branchruledata->filterpos >= 0 )
+   {
+      SCIP_CALL( SCIPdropEvent(scip, EVENTHDLR_EVENTTYPE, SCIPfindEventhdlr(scip, EVENTHDLR_NAME), NULL,
+            branchruledata->filterpos) );
+      branchruledata->filterpos = -1;
+   }
+
+   freeArcFlows(scip, branchruledata);
+   freePseudocosts(scip, branchruledata);
+
+   return SCIP_OKAY;
+}
+
+/** branching execution method for fractional LP solutions */
+static
+SCIP_DECL_BRANCHEXECLP(branchExeclpOriginalvar)
+{  /*lint --e{715}*/
+   SCIP_BRANCHRULEDATA* branchruledata;
 
    SCIP_NODE* childzero;
    SCIP_NODE* childone;
    SCIP_CONS* conszero;
    SCIP_CONS* consone;
 
-   SCIP_VARDATA* vardata;
-   int* consids;
-   int nconsids;
-   int* oriFlowVars;
-   int nOriFlowVars;
-
-   SCIP_VAR** lambda_i;
-   int nlambda_i;
-   int nread;
-   int tempI, tempJ;
-   char* tempStr;
-
-   int nLinks, nOpticalLinks, nNodes, nOpticalNodes;
-   int nFlows;
-
-   int i,j,k;
    int index1, index2;
    double fracOriVal;
+   SCIP_Real lpobjval;
 
    assert(scip != NULL);
    assert(branchrule != NULL);
@@ -79,69 +881,31 @@ SCIP_DECL_BRANCHEXECLP(branchExeclpOriginalvar)
 
    *result = SCIP_DIDNOTRUN;
 
-   probdata = SCIPgetProbData(scip);
-   assert(probdata != NULL);
+   branchruledata = SCIPbranchruleGetData(branchrule);
+   assert(branchruledata != NULL);
 
-   //nitems = SCIPprobdataGetNItems(probdata);
-   nNodes = SCIPprobdataGetNNodes(probdata);
-   nOpticalNodes = SCIPprobdataGetNOpticalNodes(probdata);
-   nLinks = SCIPprobdataGetNLinks(probdata);
-   nOpticalLinks = SCIPprobdataGetNOpticalLinks(probdata);
-   nFlows = SCIPprobdataGetNFlows(probdata);
+   SCIP_CALL( computeArcFlows(scip, branchruledata) );
 
-   /* get fractional LP candidates */
-   SCIP_CALL( SCIPgetLPBranchCands(scip, &lpcands, NULL, &lpcandsfrac, NULL, &nlpcands, NULL) );
-   assert(nlpcands > 0);
+   lpobjval = SCIPgetLPObjval(scip);
+   SCIP_CALL( selectCandidate(scip, branchruledata, lpobjval, &index1, &index2, &fracOriVal) );
 
-   //compute the first fractional original variable
-   for(i = 0; i < nFlows; i++)
+   /* all original variables are integral, which only happens if two columns describe the same path */
+   if( index1 < 0 )
    {
-      //get lambda_i
-      fracOriVal = 0;
-      SCIP_CALL( SCIPduplicateMemoryArray(scip, &lambda_i, lpcands, nlpcands) );
-      for(j = 0; j < nlpcands; j++)
-      {
-	 tempStr = SCIPvarGetName(lambda_i[j]);
-         nread = sscanf(tempStr, "lambda_%d_%d", &tempI, &tempJ);
-	 if(nread == 0) 
-	 {
-	    SCIPwarningMessage(scip, "branch_originalvar.c, error when parsing lambda name\n");
-	 }
-	 //if current lambda does not belong to flow i
-	 if(tempI != i) 
-	 {
-	    lambda_i[j] = NULL;
-	 }
-      }
-      for(j = 0; j < nLinks+nOpticalLinks*nWaveLength*2; j++)
-      {
-         for(k = 0; k < nlpcands; k++)
-	 {
-	    if(lambda_i[k] != NULL) 
-	    {
-	       vardata = SCIPvarGetData(lambda_i[k]);
-	       oriFlowVars = SCIPvardataGetOriFlowVars(vardata);
-	       fracOriVal += lpcandsfrac[k] * oriFlowVars[j];
-	    }
-	 }
-	 if(SCIPisFeasEQ(scip, fracOriVal, 1.0) || SCIPisFeasEQ(scip, fracOriVal, 0.0))
-	 {
-	    continue;
-	 }
-	 else
-	 {
-	    index1 = i;
-	    index2 = j;
-	    goto label;
-	 }
-      }
-      SCIPfreeMemoryArray(scip, &lambda_i);
+      SCIPdebugMessage("no fractional original variable\n");
+      return SCIP_OKAY;
    }
 
-   label: 
    SCIPdebugMessage("branch on original variable x_%d_%d\n", index1, index2);
    SCIPdebugMessage("current value of x_%d_%d is %lf \n", index1, index2, fracOriVal);
 
+#if SCIP_VERSION < 700
+   if( branchruledata->pendmap != NULL )
+   {
+      SCIP_CALL( removeStalePending(scip, branchruledata) );
+   }
+#endif
+
    /* create the branch-and-bound tree child nodes of the current node */
    SCIP_CALL( SCIPcreateChild(scip, &childzero, 0.0, SCIPgetLocalTransEstimate(scip)) );
    SCIP_CALL( SCIPcreateChild(scip, &childone, 0.0, SCIPgetLocalTransEstimate(scip)) );
@@ -152,6 +916,13 @@ SCIP_DECL_BRANCHEXECLP(branchExeclpOriginalvar)
    SCIP_CALL( SCIPcreateConsZeroone(scip, &consone, "one", index1, 
       index2, ONE, childone, TRUE) );
 
+   /* remember the children to learn the pseudocosts from their bounds */
+   if( branchruledata->pendmap != NULL )
+   {
+      SCIP_CALL( addPending(scip, branchruledata, childzero, index1, index2, 0, lpobjval, fracOriVal) );
+      SCIP_CALL( addPending(scip, branchruledata, childone, index1, index2, 1, lpobjval, fracOriVal) );
+   }
+
   /* add constraints to nodes */
    SCIP_CALL( SCIPaddConsNode(scip, childzero, conszero, NULL) );
    SCIP_CALL( SCIPaddConsNode(scip, childone, consone, NULL) );
@@ -180,16 +951,48 @@ SCIP_RETCODE SCIPincludeBranchruleOriginalvar(
    SCIP_BRANCHRULEDATA* branchruledata;
    SCIP_BRANCHRULE* branchrule;
 
-   /* create ryan foster branching rule data */
-   branchruledata = NULL;
+   /* create branching rule data */
+   SCIP_CALL( SCIPallocMemory(scip, &branchruledata) );
+   branchruledata->flowbeg = NULL;
+   branchruledata->arcs = NULL;
+   branchruledata->arcvals = NULL;
+   branchruledata->xval = NULL;
+   branchruledata->arcssize = 0;
+   branchruledata->nflows = 0;
+   branchruledata->nxvals = 0;
+   branchruledata->cachenode = -1;
+   branchruledata->cachelps = -1;
+   branchruledata->pscmap = NULL;
+   branchruledata->pscsum = NULL;
+   branchruledata->psccount = NULL;
+   branchruledata->pendmap = NULL;
+   branchruledata->pending = NULL;
+   branchruledata->filterpos = -1;
+   freePseudocosts(scip, branchruledata);
    branchrule = NULL;
    /* include branching rule */
    SCIP_CALL( SCIPincludeBranchruleBasic(scip, &branchrule, BRANCHRULE_NAME, BRANCHRULE_DESC, BRANCHRULE_PRIORITY, BRANCHRULE_MAXDEPTH,
          BRANCHRULE_MAXBOUNDDIST, branchruledata) );
    assert(branchrule != NULL);
 
+   SCIP_CALL( SCIPsetBranchruleFree(scip, branchrule, branchFreeOriginalvar) );
+   SCIP_CALL( SCIPsetBranchruleInitsol(scip, branchrule, branchInitsolOriginalvar) );
+   SCIP_CALL( SCIPsetBranchruleExitsol(scip, branchrule, branchExitsolOriginalvar) );
    SCIP_CALL( SCIPsetBranchruleExecLp(scip, branchrule, branchExeclpOriginalvar) );
 
+   /* include event handler for learning the pseudocosts from the bounds of the children */
+   SCIP_CALL( SCIPincludeEventhdlrBasic(scip, NULL, EVENTHDLR_NAME, EVENTHDLR_DESC, eventExecOriginalvarPsc, NULL) );
+
+   SCIP_CALL( SCIPaddCharParam(scip, "branching/"BRANCHRULE_NAME"/scoring",
+         "scoring of the fractional original variables ('f'irst, 'm'ost fractional, 'p'seudocost, 's'trong branching)",
+         &branchruledata->scoring, FALSE, DEFAULT_SCORING, "fmps", NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "branching/"BRANCHRULE_NAME"/sbmaxcands",
+         "number of candidates with the best pseudocost scores evaluated by strong branching",
+         &branchruledata->sbmaxcands, FALSE, DEFAULT_SBMAXCANDS, 1, INT_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "branching/"BRANCHRULE_NAME"/sbpricerounds",
+         "maximal number of pricing rounds of a strong branching LP (-1: no limit)",
+         &branchruledata->sbpricerounds, FALSE, DEFAULT_SBPRICEROUNDS, -1, INT_MAX, NULL, NULL) );
+
    return SCIP_OKAY;
 }
 
@@ -15,6 +15,8 @@
 #include "cons_zeroone.h" 
 #include "pricer_OAAR.h"
 #include "reader_OAAR.h"
+#include "reader_OAARB.h"
+#include "table_OAAR.h"
 
 /** creates a SCIP instance with default plugins, evaluates command line parameters, runs SCIP appropriately,
  *  and frees the SCIP instance
@@ -38,6 +40,9 @@ SCIP_RETCODE runShell(
    /* include OAAR reader */
    SCIP_CALL( SCIPincludeReaderOAAR(scip) );
 
+   /* include OAAR binary reader and writer */
+   SCIP_CALL( SCIPincludeReaderOAARB(scip) );
+
    /* include binpacking branching and branching data */
    SCIP_CALL( SCIPincludeBranchruleOriginalvar(scip) );
    SCIP_CALL( SCIPincludeConshdlrZeroone(scip) );
@@ -45,6 +50,9 @@ SCIP_RETCODE runShell(
   /* include OAAR pricer  */
    SCIP_CALL( SCIPincludePricerOAAR(scip) );
 
+   /* include OAAR pricing statistics table */
+   SCIP_CALL( SCIPincludeTableOAAR(scip) );
+
    /* include default SCIP plugins */
    SCIP_CALL( SCIPincludeDefaultPlugins(scip) );
  
@@ -0,0 +1,377 @@
+/**@file   colpool_OAAR.c
+ * @brief  Pool of the path columns generated for each flow
+ * @author He Xingqiu
+ *
+ * A column is stored as the flow index and its master variable. The sorted indices of the original variables with value
+ * one are not copied, the pool refers to the list in the variable data, which stays alive as long as the pool captures
+ * the variable. Columns are found by a hash table over these indices.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <string.h>
+
+#include "colpool_OAAR.h"
+#include "vardata_OAAR.h"
+
+/** @brief Column of the pool */
+typedef struct PoolCol
+{
+   int                   index;              /**< position of the column in the pool */
+   int                   flow;               /**< index of the flow */
+   int*                  idx;                /**< sorted indices of the original variables with value one, owned by the
+                                              *   variable data of var */
+   int                   nidx;               /**< number of indices */
+   unsigned int          hashval;            /**< hash value of flow and indices */
+   SCIP_VAR*             var;                /**< master variable, captured by the pool */
+} POOLCOL;
+
+/** @brief Column pool data */
+struct SCIP_ColPool
+{
+   SCIP_HASHTABLE*       hashtable;          /**< hash table of the columns */
+   POOLCOL**             cols;               /**< columns of the pool */
+   int                   ncols;              /**< number of columns */
+   int                   colssize;           /**< size of cols */
+   int**                 flowcols;           /**< indices of the columns of each flow */
+   int*                  nflowcols;          /**< number of columns of each flow */
+   int*                  flowcolssize;       /**< size of flowcols of each flow */
+   int                   nflows;             /**< number of flows */
+   int                   nvals;              /**< number of original variables of a column */
+   POOLCOL               searchcol;          /**< column used as key when searching the pool */
+};
+
+/**@name Local methods
+ *
+ * @{
+ */
+
+/** computes the hash value of flow and indices */
+static
+unsigned int hashCol(
+   int                   flow,               /**< index of the flow */
+   int*                  idx,                /**< sorted indices */
+   int                   nidx                /**< number of indices */
+   )
+{
+   unsigned int hashval;
+   int i;
+
+   /* FNV-1a over the flow index and the indices */
+   hashval = 2166136261u;
+   hashval = (hashval ^ (unsigned int)flow) * 16777619u;
+   for( i = 0; i < nidx; i++ )
+      hashval = (hashval ^ (unsigned int)idx[i]) * 16777619u;
+
+   return hashval;
+}
+
+/** gets the key of the given element */
+static
+SCIP_DECL_HASHGETKEY(hashGetKeyCol)
+{  /*lint --e{715}*/
+   return elem;
+}
+
+/** returns TRUE iff both keys are equal */
+static
+SCIP_DECL_HASHKEYEQ(hashKeyEqCol)
+{  /*lint --e{715}*/
+   POOLCOL* col1;
+   POOLCOL* col2;
+
+   col1 = (POOLCOL*)key1;
+   col2 = (POOLCOL*)key2;
+
+   if( col1->hashval != col2->hashval || col1->flow != col2->flow || col1->nidx != col2->nidx )
+      return FALSE;
+
+   return memcmp(col1->idx, col2->idx, col1->nidx * sizeof(int)) == 0;
+}
+
+/** returns the hash value of the key */
+static
+SCIP_DECL_HASHKEYVAL(hashKeyValCol)
+{  /*lint --e{715}*/
+   return ((POOLCOL*)key)->hashval;
+}
+
+/** lets the column refer to the indices of the original variables stored in the variable data of var */
+static
+void setColVar(
+   POOLCOL*              col,                /**< column of the pool */
+   SCIP_VAR*             var                 /**< master variable of the column */
+   )
+{
+   SCIP_VARDATA* vardata;
+
+   vardata = SCIPvarGetData(var);
+   assert(vardata != NULL);
+
+   col->var = var;
+   col->idx = SCIPvardataGetOriVars(vardata);
+   col->nidx = SCIPvardataGetNOriVars(vardata);
+}
+
+/**@} */
+
+
+/**@name Interface methods
+ *
+ * @{
+ */
+
+/** creates an empty column pool */
+SCIP_RETCODE SCIPcolpoolCreate(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_COLPOOL**        colpool,            /**< pointer to store the column pool */
+   int                   nflows,             /**< number of flows */
+   int                   nvals               /**< number of original variables of a column */
+   )
+{
+   int k;
+
+   assert(scip != NULL);
+   assert(colpool != NULL);
+
+   SCIP_CALL( SCIPallocMemory(scip, colpool) );
+
+   SCIP_CALL( SCIPhashtableCreate(&(*colpool)->hashtable, SCIPblkmem(scip), 10 * nflows,
+         hashGetKeyCol, hashKeyEqCol, hashKeyValCol, NULL) );
+
+   (*colpool)->cols = NULL;
+   (*colpool)->ncols = 0;
+   (*colpool)->colssize = 0;
+   (*colpool)->nflows = nflows;
+   (*colpool)->nvals = nvals;
+
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*colpool)->flowcols, nflows) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*colpool)->nflowcols, nflows) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*colpool)->flowcolssize, nflows) );
+   for( k = 0; k < nflows; k++ )
+   {
+      (*colpool)->flowcols[k] = NULL;
+      (*colpool)->nflowcols[k] = 0;
+      (*colpool)->flowcolssize[k] = 0;
+   }
+
+   (*colpool)->searchcol.idx = NULL;
+   (*colpool)->searchcol.var = NULL;
+
+   return SCIP_OKAY;
+}
+
+/** frees the column pool and releases the variables of its columns */
+SCIP_RETCODE SCIPcolpoolFree(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_COLPOOL**        colpool             /**< pointer to the column pool */
+   )
+{
+   POOLCOL* col;
+   int c;
+   int k;
+
+   assert(colpool != NULL);
+
+   if( *colpool == NULL )
+      return SCIP_OKAY;
+
+   for( c = 0; c < (*colpool)->ncols; c++ )
+   {
+      col = (*colpool)->cols[c];
+      SCIP_CALL( SCIPreleaseVar(scip, &col->var) );
+      SCIPfreeBlockMemory(scip, &col);
+   }
+
+   for( k = 0; k < (*colpool)->nflows; k++ )
+   {
+      SCIPfreeMemoryArrayNull(scip, &(*colpool)->flowcols[k]);
+   }
+
+   SCIPfreeMemoryArray(scip, &(*colpool)->flowcolssize);
+   SCIPfreeMemoryArray(scip, &(*colpool)->nflowcols);
+   SCIPfreeMemoryArray(scip, &(*colpool)->flowcols);
+   SCIPfreeMemoryArrayNull(scip, &(*colpool)->cols);
+   SCIPhashtableFree(&(*colpool)->hashtable);
+   SCIPfreeMemory(scip, colpool);
+
+   return SCIP_OKAY;
+}
+
+/** returns the index of the column of the given flow with the given original variables, or -1 if it is not in the
+ *  pool
+ */
+int SCIPcolpoolFindCol(
+   SCIP_COLPOOL*         colpool,            /**< column pool */
+   int                   flow,               /**< index of the flow */
+   int*                  idx,                /**< sorted indices of the original variables with value one */
+   int                   nidx                /**< number of indices */
+   )
+{
+   POOLCOL* col;
+
+   assert(colpool != NULL);
+   assert(idx != NULL || nidx == 0);
+
+   colpool->searchcol.flow = flow;
+   colpool->searchcol.idx = idx;
+   colpool->searchcol.nidx = nidx;
+   colpool->searchcol.hashval = hashCol(flow, idx, nidx);
+
+   col = (POOLCOL*)SCIPhashtableRetrieve(colpool->hashtable, (void*)&colpool->searchcol);
+
+   return col == NULL ? -1 : col->index;
+}
+
+/** adds the column of a master variable to the pool; the column must not be in the pool yet */
+SCIP_RETCODE SCIPcolpoolAddCol(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_COLPOOL*         colpool,            /**< column pool */
+   int                   flow,               /**< index of the flow */
+   SCIP_VAR*             var,                /**< master variable of the column */
+   int*                  col                 /**< pointer to store the index of the column, or NULL */
+   )
+{
+   POOLCOL* newcol;
+   int newsize;
+
+   assert(colpool != NULL);
+   assert(0 <= flow && flow < colpool->nflows);
+   assert(var != NULL);
+
+   SCIP_CALL( SCIPallocBlockMemory(scip, &newcol) );
+   setColVar(newcol, var);
+   newcol->index = colpool->ncols;
+   newcol->flow = flow;
+   newcol->hashval = hashCol(flow, newcol->idx, newcol->nidx);
+   assert(SCIPcolpoolFindCol(colpool, flow, newcol->idx, newcol->nidx) == -1);
+
+   SCIP_CALL( SCIPcaptureVar(scip, var) );
+
+   if( colpool->ncols == colpool->colssize )
+   {
+      newsize = SCIPcalcMemGrowSize(scip, colpool->ncols + 1);
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &colpool->cols, newsize) );
+      colpool->colssize = newsize;
+   }
+   if( colpool->nflowcols[flow] == colpool->flowcolssize[flow] )
+   {
+      newsize = SCIPcalcMemGrowSize(scip, colpool->nflowcols[flow] + 1);
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &colpool->flowcols[flow], newsize) );
+      colpool->flowcolssize[flow] = newsize;
+   }
+
+   colpool->cols[colpool->ncols] = newcol;
+   colpool->flowcols[flow][colpool->nflowcols[flow]] = colpool->ncols;
+   colpool->nflowcols[flow]++;
+   if( col != NULL )
+      *col = colpool->ncols;
+   colpool->ncols++;
+
+   SCIP_CALL( SCIPhashtableInsert(colpool->hashtable, (void*)newcol) );
+
+   return SCIP_OKAY;
+}
+
+/** returns the master variable of a column, or NULL if the variable was deleted from the master problem */
+SCIP_VAR* SCIPcolpoolGetVar(
+   SCIP_COLPOOL*         colpool,            /**< column pool */
+   int                   col                 /**< index of the column */
+   )
+{
+   SCIP_VAR* var;
+
+   assert(colpool != NULL);
+   assert(0 <= col && col < colpool->ncols);
+
+   var = colpool->cols[col]->var;
+   if( SCIPvarIsDeleted(var) )
+      return NULL;
+
+   return var;
+}
+
+/** replaces the master variable of a column by a new variable of the same path */
+SCIP_RETCODE SCIPcolpoolSetVar(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_COLPOOL*         colpool,            /**< column pool */
+   int                   col,                /**< index of the column */
+   SCIP_VAR*             var                 /**< new master variable of the column */
+   )
+{
+   POOLCOL* poolcol;
+   SCIP_VAR* oldvar;
+
+   assert(colpool != NULL);
+   assert(0 <= col && col < colpool->ncols);
+   assert(var != NULL);
+
+   poolcol = colpool->cols[col];
+   oldvar = poolcol->var;
+
+   /* the column refers to the indices of the new variable before the old one may be freed; the hash value stays */
+   SCIP_CALL( SCIPcaptureVar(scip, var) );
+   setColVar(poolcol, var);
+   assert(poolcol->hashval == hashCol(poolcol->flow, poolcol->idx, poolcol->nidx));
+   SCIP_CALL( SCIPreleaseVar(scip, &oldvar) );
+
+   return SCIP_OKAY;
+}
+
+/** stores the values of the original variables of a column in vals */
+void SCIPcolpoolGetVals(
+   SCIP_COLPOOL*         colpool,            /**< column pool */
+   int                   col,                /**< index of the column */
+   int*                  vals                /**< array to store the value (0 or 1) of each original variable */
+   )
+{
+   POOLCOL* poolcol;
+   int i;
+
+   assert(colpool != NULL);
+   assert(0 <= col && col < colpool->ncols);
+   assert(vals != NULL);
+
+   poolcol = colpool->cols[col];
+
+   BMSclearMemoryArray(vals, colpool->nvals);
+   for( i = 0; i < poolcol->nidx; i++ )
+      vals[poolcol->idx[i]] = 1;
+}
+
+/** returns the number of columns of the given flow */
+int SCIPcolpoolGetNFlowCols(
+   SCIP_COLPOOL*         colpool,            /**< column pool */
+   int                   flow                /**< index of the flow */
+   )
+{
+   assert(colpool != NULL);
+   assert(0 <= flow && flow < colpool->nflows);
+
+   return colpool->nflowcols[flow];
+}
+
+/** returns the indices of the columns of the given flow */
+int* SCIPcolpoolGetFlowCols(
+   SCIP_COLPOOL*         colpool,            /**< column pool */
+   int                   flow                /**< index of the flow */
+   )
+{
+   assert(colpool != NULL);
+   assert(0 <= flow && flow < colpool->nflows);
+
+   return colpool->flowcols[flow];
+}
+
+/** returns the number of columns in the pool */
+int SCIPcolpoolGetNCols(
+   SCIP_COLPOOL*         colpool             /**< column pool */
+   )
+{
+   assert(colpool != NULL);
+
+   return colpool->ncols;
+}
+
+/**@} */
@@ -0,0 +1,100 @@
+/**@file   colpool_OAAR.h
+ * @brief  Pool of the path columns generated for each flow
+ * @author He Xingqiu
+ *
+ * Every column generated by the pricer is stored here with its master variable, whose variable data holds the sorted
+ * list of the original variables (x, y and z of the pricing problem) it uses. The pool is used to recognize paths which
+ * were generated before and to restore columns whose master variable was deleted.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_COLPOOL_OAAR__
+#define __SCIP_COLPOOL_OAAR__
+
+#include "scip/scip.h"
+
+typedef struct SCIP_ColPool SCIP_COLPOOL;
+
+/** creates an empty column pool */
+extern
+SCIP_RETCODE SCIPcolpoolCreate(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_COLPOOL**        colpool,            /**< pointer to store the column pool */
+   int                   nflows,             /**< number of flows */
+   int                   nvals               /**< number of original variables of a column */
+   );
+
+/** frees the column pool and releases the variables of its columns */
+extern
+SCIP_RETCODE SCIPcolpoolFree(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_COLPOOL**        colpool             /**< pointer to the column pool */
+   );
+
+/** returns the index of the column of the given flow with the given original variables, or -1 if it is not in the
+ *  pool
+ */
+extern
+int SCIPcolpoolFindCol(
+   SCIP_COLPOOL*         colpool,            /**< column pool */
+   int                   flow,               /**< index of the flow */
+   int*                  idx,                /**< sorted indices of the original variables with value one */
+   int                   nidx                /**< number of indices */
+   );
+
+/** adds the column of a master variable to the pool; the column must not be in the pool yet */
+extern
+SCIP_RETCODE SCIPcolpoolAddCol(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_COLPOOL*         colpool,            /**< column pool */
+   int                   flow,               /**< index of the flow */
+   SCIP_VAR*             var,                /**< master variable of the column */
+   int*                  col                 /**< pointer to store the index of the column, or NULL */
+   );
+
+/** returns the master variable of a column, or NULL if the variable was deleted from the master problem */
+extern
+SCIP_VAR* SCIPcolpoolGetVar(
+   SCIP_COLPOOL*         colpool,            /**< column pool */
+   int                   col                 /**< index of the column */
+   );
+
+/** replaces the master variable of a column by a new variable of the same path */
+extern
+SCIP_RETCODE SCIPcolpoolSetVar(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_COLPOOL*         colpool,            /**< column pool */
+   int                   col,                /**< index of the column */
+   SCIP_VAR*             var                 /**< new master variable of the column */
+   );
+
+/** stores the values of the original variables of a column in vals */
+extern
+void SCIPcolpoolGetVals(
+   SCIP_COLPOOL*         colpool,            /**< column pool */
+   int                   col,                /**< index of the column */
+   int*                  vals                /**< array to store the value (0 or 1) of each original variable */
+   );
+
+/** returns the number of columns of the given flow */
+extern
+int SCIPcolpoolGetNFlowCols(
+   SCIP_COLPOOL*         colpool,            /**< column pool */
+   int                   flow                /**< index of the flow */
+   );
+
+/** returns the indices of the columns of the given flow */
+extern
+int* SCIPcolpoolGetFlowCols(
+   SCIP_COLPOOL*         colpool,            /**< column pool */
+   int                   flow                /**< index of the flow */
+   );
+
+/** returns the number of columns in the pool */
+extern
+int SCIPcolpoolGetNCols(
+   SCIP_COLPOOL*         colpool             /**< column pool */
+   );
+
+#endif
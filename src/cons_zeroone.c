@@ -9,6 +9,7 @@
 #define SCIP_DEBUG
 
 #include <assert.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "cons_zeroone.h"
@@ -116,104 +117,68 @@ void consdataPrint(
       consdata->index1, consdata->index2, SCIPnodeGetNumber(consdata->node) );
 }
 
-/** fixes a variable to zero if the corresponding packings are not valid for this constraint/node (due to branching) */
+/** fixes a variable to zero whose column is not valid for this constraint/node (due to branching) */
 static
-SCIP_RETCODE checkVariable(
+SCIP_RETCODE fixVariable(
    SCIP*                 scip,               /**< SCIP data structure */
-   SCIP_CONSDATA*        consdata,           /**< constraint data */
-   SCIP_VAR*             var,                /**< variables to check  */
+   SCIP_VAR*             var,                /**< variable to fix */
    int*                  nfixedvars,         /**< pointer to store the number of fixed variables */
    SCIP_Bool*            cutoff              /**< pointer to store if a cutoff was detected */
    )
 {
-   SCIP_VARDATA* vardata;
-   //int* consids;
-   //int nconsids;
-   int* oriFlowVars;
-
-   CONSTYPE type;
-
    SCIP_Bool fixed;
    SCIP_Bool infeasible;
 
-   int nread;
-   int tempI, tempJ;
-   char* varname;
-
    assert(scip != NULL);
-   assert(consdata != NULL);
    assert(var != NULL);
    assert(nfixedvars != NULL);
    assert(cutoff != NULL);
 
-   /* if variables is locally fixed to zero continue */
-   if( SCIPvarGetUbLocal(var) < 0.5 )
+   /* if variables is locally fixed to zero or was deleted from the problem continue */
+   if( SCIPvarGetUbLocal(var) < 0.5 || SCIPvarIsDeleted(var) )
       return SCIP_OKAY;
 
-   /* check if the packing which corresponds to the variable feasible for this constraint */
-   vardata = SCIPvarGetData(var);
-
-   //nconsids = SCIPvardataGetNConsids(vardata);
-   //consids = SCIPvardataGetConsids(vardata);
-   oriFlowVars = SCIPvardataGetOriFlowVars(vardata);
-   type = consdata->type;
+   SCIP_CALL( SCIPfixVar(scip, var, 0.0, &infeasible, &fixed) );
 
-   varname = SCIPvarGetName(var);
-   nread = sscanf(varname, "lambda_%d_%d", &tempI, &tempJ);
-   if( nread == 0 )
-      SCIPdebugMessage("error when parsing var name in cons_zeroone.c checkVariable");
-   if(tempI == consdata->index1)
+   if( infeasible )
    {
-      if(type == ZERO && oriFlowVars[consdata->index2] == 1)
-      {
-         SCIP_CALL( SCIPfixVar(scip, var, 0.0, &infeasible, &fixed) );
-	 
-	 if(infeasible)
-	 {
-	    assert(SCIPvarGetLbLocal(var) > 0.5);
-	    SCIPdebugMessage("->cutoff\n");
-	    (*cutoff) = TRUE;
-	 }
-	 else
-	 {
-	    assert(fixed);
-	    (*nfixedvars)++;
-	 }
-      }
-
-      if(type == ONE && oriFlowVars[consdata->index2] == 0)
-      {
-         SCIP_CALL( SCIPfixVar(scip, var, 0.0, &infeasible, &fixed) );
-
-	 if(infeasible)
-	 {
-	    assert(SCIPvarGetLbLocal(var) > 0.5);
-	    SCIPdebugMessage("->cutoff\n");
-	    (*cutoff) = TRUE;
-	 }
-	 else
-	 {
-	    assert(fixed);
-	    (*nfixedvars)++;
-	 }
-      }
+      assert(SCIPvarGetLbLocal(var) > 0.5);
+      SCIPdebugMessage("->cutoff\n");
+      (*cutoff) = TRUE;
+   }
+   else
+   {
+      assert(fixed);
+      (*nfixedvars)++;
    }
-   
+
    return SCIP_OKAY;
 }
 
-/** fixes variables to zero if the corresponding packings are not valid for this sonstraint/node (due to branching) */
+/** fixes variables to zero if the corresponding packings are not valid for this sonstraint/node (due to branching)
+ *
+ *  Only the columns of flow index1 are affected. The decision ZERO forbids the columns in which the original variable
+ *  index2 is one, and ONE the columns in which it is zero; both are read from the bitmap of index2 in the problem data,
+ *  starting at the first column created after the last propagation.
+ */
 static
 SCIP_RETCODE consdataFixVariables(
    SCIP*                 scip,               /**< SCIP data structure */
    SCIP_CONSDATA*        consdata,           /**< constraint data */
+   SCIP_PROBDATA*        probdata,           /**< problem data */
    SCIP_VAR**            vars,               /**< generated variables */
    int                   nvars,              /**< number of generated variables */
    SCIP_RESULT*          result              /**< pointer to store the result of the fixing */
    )
 {
+   uint64_t* bits;
+   uint64_t word;
+   int* cols;
+   int ncols;
+   int first;
    int nfixedvars;
-   int v;
+   int w;
+   int c;
    SCIP_Bool cutoff;
 
    nfixedvars = 0;
@@ -221,9 +186,33 @@ SCIP_RETCODE consdataFixVariables(
 
    SCIPdebugMessage("check variables %d to %d\n", consdata->npropagatedvars, nvars);
 
-   for( v = consdata->npropagatedvars; v < nvars && !cutoff; ++v )
+   cols = SCIPprobdataGetFlowVars(probdata, consdata->index1);
+   ncols = SCIPprobdataGetNFlowVars(probdata, consdata->index1);
+   bits = SCIPprobdataGetFlowVarBits(probdata, consdata->index1, consdata->index2);
+
+   /* the columns of the flow are sorted by their position, so the new ones are at the end */
+   (void) SCIPsortedvecFindInt(cols, consdata->npropagatedvars, ncols, &first);
+
+   for( w = first / 64; w < (ncols + 63) / 64 && !cutoff; ++w )
    {
-      SCIP_CALL( checkVariable(scip, consdata, vars[v], &nfixedvars, &cutoff) );
+      word = (bits == NULL ? 0 : bits[w]);
+      if( consdata->type == ONE )
+         word = ~word;
+
+      /* skip the columns which were propagated before and the bits behind the last column */
+      if( w == first / 64 )
+         word &= ~(uint64_t)0 << (first % 64);
+      if( w == (ncols - 1) / 64 && ncols % 64 != 0 )
+         word &= ~(~(uint64_t)0 << (ncols % 64));
+
+      for( c = 64 * w; word != 0 && !cutoff; ++c, word >>= 1 )
+      {
+         if( word & 1 )
+         {
+            assert(cols[c] < nvars);
+            SCIP_CALL( fixVariable(scip, vars[cols[c]], &nfixedvars, &cutoff) );
+         }
+      }
    }
 
    SCIPdebugMessage("fixed %d variables locally\n", nfixedvars);
@@ -254,16 +243,12 @@ SCIP_Bool consdataCheck(
 
    int* consids;
    int nconsids;
-   int* oriFlowVars;
    CONSTYPE type;
 
    int v;
-   char* varname;
 
    vars = SCIPprobdataGetVars(probdata);
    nvars = SCIPprobdataGetNVars(probdata);
-   
-   int nread, tempI, tempJ;
 
    for( v = 0; v < nvars; ++v )
    {
@@ -278,15 +263,12 @@ SCIP_Bool consdataCheck(
 
       nconsids = SCIPvardataGetNConsids(vardata);
       consids = SCIPvardataGetConsids(vardata);
-      oriFlowVars = SCIPvardataGetOriFlowVars(vardata);
 
       type = consdata->type;
 
-      varname = SCIPvarGetName(var);
-      nread = sscanf(varname, "lambda_%d_%d", &tempI, &tempJ);
-      if(tempI == consdata->index1)
+      if(SCIPvardataGetFlow(vardata) == consdata->index1)
       {
-	 if(type == ZERO && oriFlowVars[consdata->index2] == 1)
+	 if(type == ZERO && SCIPvardataHasOriVar(vardata, consdata->index2))
 	 {
 	    SCIPdebug( SCIPvardataPrint(scip, vardata, NULL) );
 	    SCIPdebug( consdataPrint(scip, consdata, NULL) );
@@ -429,7 +411,7 @@ SCIP_DECL_CONSPROP(consPropZeroone)
          SCIPdebugMessage("propagate constraint <%s> ", SCIPconsGetName(conss[c]));
          SCIPdebug( consdataPrint(scip, consdata, NULL) );
 
-         SCIP_CALL( consdataFixVariables(scip, consdata, vars, nvars, result) );
+         SCIP_CALL( consdataFixVariables(scip, consdata, probdata, vars, nvars, result) );
          consdata->npropagations++;
 
          if( *result != SCIP_CUTOFF )
@@ -3,6 +3,16 @@
  * @author He Xingqiu
  *
  * This file implements the variable pricer which check if variables exist with negative reduced cost. 
+ *
+ * Pricing works in two tiers. First, a shortest path heuristic runs over the reduced costs of all flows. Only if it
+ * does not find any column with negative reduced cost, the pricing MIPs of the flows for which the heuristic could not
+ * prove optimality are solved; this is needed to prove that the master LP is optimal. With partial pricing, each tier
+ * stops after a given number of columns or flows and the next round continues with the following flow.
+ *
+ * Flows with the same source, destination, bandwidth, prices and priority have the same pricing problem up to their
+ * dual value gamma. Such flows form a class, and only the flow of a class with the largest gamma is priced: a path has
+ * negative reduced cost for some flow of the class only if it has for that flow. Flows with branching decisions are
+ * priced on their own.
  */
 
 /*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
@@ -10,15 +20,19 @@
 //#define SCIP_DEBUG
 
 #include <assert.h>
+#include <limits.h>
 #include <string.h>
 
 #include "scip/cons_knapsack.h"
 #include "scip/cons_setppc.h"
 #include "scip/scipdefplugins.h"
 
+#include "colpool_OAAR.h"
 #include "cons_zeroone.h" 
 #include "pricer_OAAR.h"
 #include "probdata_OAAR.h"
+#include "shortestpath_OAAR.h"
+#include "threadpool_OAAR.h"
 #include "vardata_OAAR.h"
 
 /**@name Pricer properties
@@ -31,6 +45,30 @@
 #define PRICER_PRIORITY        0
 #define PRICER_DELAY           TRUE     /* only call pricer if all problem variables have non-negative reduced costs */
 
+#define DEFAULT_SHORTESTPATH   TRUE     /**< should the shortest path heuristic run before the pricing MIPs? */
+#define DEFAULT_THREADS        1        /**< number of threads used to solve the pricing problems */
+
+#define DEFAULT_MAXCOLSROUND   -1       /**< maximal number of columns after which a pricing round stops (-1: no limit) */
+#define DEFAULT_MAXFLOWSROUND  -1       /**< maximal number of flows after which a pricing round stops (-1: no limit) */
+
+#define DEFAULT_SMOOTHING      0.5      /**< smoothing factor of the dual values towards the stability center (0: off) */
+#define DEFAULT_SMOOTHINGAUTO  FALSE    /**< should the smoothing factor be adapted during the solve? */
+
+#define DEFAULT_LAGRANGEGAP    0.0      /**< relative gap between LP value and Lagrangian bound at which pricing stops early */
+
+#define DEFAULT_AGGREGATE      TRUE     /**< should equivalent flows be priced only once? */
+
+#define MAXPRICINGCOLS         3        /**< maximal number of columns added per flow and pricing round */
+
+#define DEFAULT_MIPOBJLIMIT    TRUE     /**< should the pricing MIPs only search for improving columns? */
+#define DEFAULT_MIPSOLLIMIT    MAXPRICINGCOLS /**< number of improving columns after which a pricing MIP stops (-1: no limit) */
+#define DEFAULT_MIPGAPLIMIT    0.0      /**< relative gap at which a pricing MIP with an improving column stops */
+
+#define DEFAULT_STATSMACHINE   FALSE    /**< should the pricing statistics be printed in a machine readable format? */
+
+#define DEFAULT_TRACEFILE      ""       /**< file to which the convergence trace is written ("": no trace) */
+#define TRACEBUFSIZE           (1 << 20) /**< size of the output buffer of the convergence trace in bytes */
+
 /**@} */
 
 
@@ -38,13 +76,55 @@
  * Data structures
  */
 
+/** working memory of one pricing thread */
+typedef struct PricingWs
+{
+   SCIP_LAYEREDGRAPHWS*  graphws;            /**< workspace of the shortest path engine */
+   SCIP_Real*            linkcost;           /**< reduced cost of each link */
+   SCIP_Real*            wavecost;           /**< reduced cost of each wavelength of each optical link */
+   int*                  pathlinks;          /**< links of the shortest path */
+   int*                  pathwaves;          /**< wavelengths of the links of the shortest path */
+   SCIP_CLOCK*           clock;              /**< clock measuring the pricing steps of the thread */
+} PRICINGWS;
+
+/** pricing statistics of one flow; during a pricing round, only the thread pricing the flow writes them */
+typedef struct FlowStats
+{
+   int                   nheurcalls;         /**< number of calls of the shortest path heuristic */
+   int                   nmipcalls;          /**< number of solves of the pricing MIP */
+   int                   naggregated;        /**< number of rounds in which an equivalent flow was priced instead */
+   int                   nfound;             /**< number of columns found by pricing */
+   int                   naccepted;          /**< number of columns added to the master problem */
+   SCIP_Real             heurtime;           /**< time spent in the shortest path heuristic */
+   SCIP_Real             buildtime;          /**< time spent for building the pricing MIP */
+   SCIP_Real             dectime;            /**< time spent for applying the branching decisions to the pricing MIP */
+   SCIP_Real             solvetime;          /**< time spent for solving the pricing MIP */
+} FLOWSTATS;
+
+/** data of a pricing round which is shared by all threads; it is only read while the threads are running */
+typedef struct PricingRound
+{
+   SCIP*                 scip;               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata;         /**< pricer data */
+   double*               alpha;              /**< dual values of the capacity constraints (Cons2) */
+   double*               beta;               /**< dual values of the wavelength constraints (Cons3) */
+   double*               gamma;              /**< dual values of the flow constraints (Cons1) */
+   int*                  decbeg;             /**< start of the branching decisions of each flow in decindex */
+   int*                  decindex;           /**< index of the original variable of each branching decision */
+   CONSTYPE*             dectype;            /**< type of each branching decision */
+   int*                  flows;              /**< flows which are priced by the jobs of the current batch */
+   SCIP_Real             timelimit;          /**< time limit of each pricing MIP */
+   SCIP_Real             memorylimit;        /**< memory limit of each pricing MIP */
+} PRICINGROUND;
+
 struct SCIP_PricerData
 {
    SCIP_CONSHDLR*        conshdlr;           /**< comstraint handler for zeroone constraints */
    SCIP_CONS**           conss;              
-   OAARNode*             Nodes;
-   OAARLink*             Links;
-   OAARFlow*             Flows;
+   OAARNode*             Nodes;              /**< Nodes array of the problem data (not owned by the pricer) */
+   OAARLink*             Links;              /**< Links array of the problem data (not owned by the pricer) */
+   OAARFlow*             Flows;              /**< Flows array of the problem data (not owned by the pricer) */
+   OAARTopology*         Topology;           /**< topology view of the problem data (not owned by the pricer) */
    int                   nNodes;
    int                   nOpticalNodes;
    int                   nLinks;
@@ -52,6 +132,89 @@ struct SCIP_PricerData
    int                   nFlows;
    int                   nCons;
    //int*                  nFlowSol;
+
+   SCIP**                subscips;           /**< pricing problem of each flow, kept alive during the whole solve */
+   SCIP_VAR***           subvars;            /**< variables (x, y, z) of the pricing problem of each flow */
+   int**                 fixedvars;          /**< indices of the x variables whose bounds are changed by branching */
+   int*                  nfixedvars;         /**< number of x variables whose bounds are changed by branching */
+   SCIP_CLOCK*           buildclock;         /**< time spent for building the pricing problems */
+   int                   nbuilds;            /**< number of pricing problems built from scratch */
+   int                   nsolves;            /**< number of pricing problem solves */
+
+   SCIP_LAYEREDGRAPH*    graph;              /**< wavelength-layered graph of the shortest path engine */
+   SCIP_Bool             shortestpath;       /**< should the shortest path heuristic run before the pricing MIPs? */
+   int                   nspsolves;          /**< number of pricing problems solved by the shortest path engine */
+   int                   nheurrounds;        /**< number of pricing rounds in which the heuristic found columns */
+   int                   nexactrounds;       /**< number of pricing rounds which needed the pricing MIPs */
+   int                   nheurcols;          /**< number of columns found by the heuristic */
+   int                   nexactcols;         /**< number of columns found by the pricing MIPs */
+   SCIP_CLOCK*           heurclock;          /**< time spent for heuristic pricing */
+   SCIP_CLOCK*           exactclock;         /**< time spent for exact pricing */
+
+   int                   nthreads;           /**< number of threads used to solve the pricing problems */
+   SCIP_Bool             mipparallel;        /**< may the pricing MIPs be solved in parallel (thread-safe build)? */
+   SCIP_THREADPOOL*      threadpool;         /**< worker threads */
+   PRICINGWS*            workspaces;         /**< working memory of each thread */
+   int*                  colvals;            /**< columns found in the current round, MAXPRICINGCOLS per flow */
+   int*                  ncols;              /**< number of columns found for each flow in the current round */
+   SCIP_Bool*            solved;             /**< was the pricing problem of each flow solved in the current round? */
+   SCIP_Real*            redcostbound;       /**< lower bound on the reduced cost of each flow in the current round,
+                                              *   -infinity if unknown */
+
+   int                   maxcolsround;       /**< maximal number of columns after which a pricing round stops (-1: no limit) */
+   int                   maxflowsround;      /**< maximal number of flows after which a pricing round stops (-1: no limit) */
+   int                   startflow;          /**< flow at which the next pricing round starts */
+
+   SCIP_Real             smoothing;          /**< smoothing factor of the dual values towards the stability center */
+   SCIP_Bool             smoothingauto;      /**< should the smoothing factor be adapted during the solve? */
+   SCIP_Real             cursmoothing;       /**< smoothing factor used in the next pricing round */
+   double*               centeralpha;        /**< stability center of the dual values of the capacity constraints */
+   double*               centerbeta;         /**< stability center of the dual values of the wavelength constraints */
+   double*               centergamma;        /**< stability center of the dual values of the flow constraints */
+   SCIP_Real             centerbound;        /**< Lagrangian bound at the stability center, -infinity if unknown */
+   SCIP_Bool             hascenter;          /**< is the stability center valid for the current node? */
+   SCIP_Longint          centernode;         /**< number of the node the stability center belongs to */
+   int                   nmisprices;         /**< number of pricing rounds at smoothed dual values without a column */
+
+   SCIP_Real             lagrangegap;        /**< relative gap between LP value and Lagrangian bound at which pricing stops */
+   int                   nlagrangebounds;    /**< number of pricing rounds which computed a Lagrangian bound */
+   int                   nearlystops;        /**< number of nodes at which pricing was stopped by the Lagrangian bound */
+
+   int                   probeflow;          /**< flow of the branching decision of the current probing node, or -1 */
+   int                   probeindex;         /**< original variable of the branching decision of the probing node */
+   CONSTYPE              probetype;          /**< type of the branching decision of the probing node */
+
+   SCIP_COLPOOL*         colpool;            /**< all columns generated so far, used to detect duplicate paths */
+   int                   npoolcols;          /**< number of columns restored from the column pool */
+   int                   nduplicates;        /**< number of generated columns which were already in the master */
+
+   SCIP_Bool             aggregate;          /**< should equivalent flows be priced only once? */
+   int*                  flowclass;          /**< smallest index of a flow with the same pricing problem as each flow */
+   int                   nflowclasses;       /**< number of classes of equivalent flows */
+   int*                  classrep;           /**< flow priced for each flow in the current round */
+   int                   naggregated;        /**< number of pricing problems skipped because an equivalent flow was priced */
+
+   SCIP_Bool             mipobjlimit;        /**< should the pricing MIPs only search for improving columns? */
+   int                   mipsollimit;        /**< number of improving columns after which a pricing MIP stops (-1: no limit) */
+   SCIP_Real             mipgaplimit;        /**< relative gap at which a pricing MIP with an improving column stops */
+   SCIP_STATUS*          mipstatus;          /**< status of the pricing MIP of each flow in the current round */
+   int                   nmipoptimal;        /**< number of pricing MIPs solved to optimality */
+   int                   nmipnocols;         /**< number of pricing MIPs which proved that no improving column exists */
+   int                   nmipsollimit;       /**< number of pricing MIPs stopped by the solution limit */
+   int                   nmipgaplimit;       /**< number of pricing MIPs stopped by the gap limit */
+   int                   nmipother;          /**< number of pricing MIPs stopped by the time or memory limit */
+
+   FLOWSTATS*            flowstats;          /**< pricing statistics of each flow */
+   SCIP_Real*            roundredcost;       /**< smallest reduced cost of an added column in each pricing round */
+   int                   nrounds;            /**< number of pricing rounds which priced at least one flow */
+   int                   roundssize;         /**< size of the roundredcost array */
+   SCIP_CLOCK*           insertclock;        /**< time spent for adding the columns to the master problem */
+   SCIP_Bool             statsmachine;       /**< should the pricing statistics be printed in a machine readable format? */
+
+   char*                 tracefilename;      /**< file to which the convergence trace is written ("": no trace) */
+   FILE*                 tracefile;          /**< convergence trace, or NULL if no trace is written */
+   char*                 tracebuffer;        /**< output buffer of the convergence trace */
+   int                   ncalls;             /**< number of calls of the reduced cost pricing */
 };
 
 
@@ -61,78 +224,100 @@ struct SCIP_PricerData
  * @{
  */
 
-/** add branching decisions constraints to the sub SCIP */
+/** writes one row of the convergence trace; the file is fully buffered, so this does not slow down pricing */
 static
-SCIP_RETCODE addBranchingDecisionConss(
+void writeTraceRow(
    SCIP*                 scip,               /**< SCIP data structure */
-   SCIP*                 subscip,            /**< pricing SCIP data structure */
-   SCIP_VAR**            vars,               /**< variable array of the subscuip oder variables */
-   SCIP_CONSHDLR*        conshdlr,           /**< constraint handler for branching data */
-   int                   k
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   SCIP_Real             lagrangebound,      /**< Lagrangian bound of the call, or -infinity if it is unknown */
+   int                   nadded              /**< number of columns added to the master problem */
    )
 {
-   SCIP_CONS** conss;
-   SCIP_CONS* cons;
-   int nconss;
-   CONSTYPE type;
+   assert(pricerdata != NULL);
 
-   SCIP_Bool infeasible, fixed;
+   if( pricerdata->tracefile == NULL )
+      return;
 
-   int index1, index2;
-   int c;
+   fprintf(pricerdata->tracefile, "%d,%"SCIP_LONGINT_FORMAT",%d,%.3f,%.9g,", pricerdata->ncalls,
+      SCIPnodeGetNumber(SCIPgetCurrentNode(scip)), SCIPgetDepth(scip), SCIPgetSolvingTime(scip), SCIPgetLPObjval(scip));
+   if( !SCIPisInfinity(scip, -lagrangebound) )
+      fprintf(pricerdata->tracefile, "%.9g", lagrangebound);
+   fprintf(pricerdata->tracefile, ",%.9g,%d\n", SCIPgetDualbound(scip), nadded);
+}
 
-   assert( scip != NULL );
-   assert( subscip != NULL );
-   assert( conshdlr != NULL );
+/** undo the bound changes of the branching decisions which were applied to the pricing problem of flow k */
+static
+SCIP_RETCODE resetBranchingDecisions(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   int                   k                   /**< index of current subproblem */
+   )
+{
+   SCIP* subscip;
+   SCIP_VAR** vars;
+   int i;
 
-   /* collect all branching decision constraints */
-   conss = SCIPconshdlrGetConss(conshdlr);
-   nconss = SCIPconshdlrGetNConss(conshdlr);
+   assert( pricerdata != NULL );
 
-   /* loop over all branching decision constraints and apply the branching decision if the corresponding constraint is
-    * active
-    */
-   for( c = 0; c < nconss; ++c )
+   subscip = pricerdata->subscips[k];
+   vars = pricerdata->subvars[k];
+   assert( SCIPgetStage(subscip) == SCIP_STAGE_PROBLEM );
+
+   for( i = 0; i < pricerdata->nfixedvars[k]; i++ )
    {
-      cons = conss[c];
+      SCIP_CALL( SCIPchgVarLb(subscip, vars[pricerdata->fixedvars[k][i]], 0.0) );
+      SCIP_CALL( SCIPchgVarUb(subscip, vars[pricerdata->fixedvars[k][i]], 1.0) );
+   }
+   pricerdata->nfixedvars[k] = 0;
 
-      /* ignore constraints which are not active since these are not laying on the current active path of the search
-       * tree
-       */
-      if( !SCIPconsIsActive(cons) )
-         continue;
+   return SCIP_OKAY;
+}
+
+/** add branching decisions to the sub SCIP as bound changes; they are undone by resetBranchingDecisions() */
+static
+SCIP_RETCODE addBranchingDecisionConss(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   PRICINGROUND*         round,              /**< data of the current pricing round */
+   int                   k                   /**< index of current subproblem */
+   )
+{
+   SCIP* subscip;
+   SCIP_VAR** vars;
+   int index2;
+   int d;
 
-      /* collect the two item ids and the branching type (SAME or DIFFER) on which the constraint branched */
-      index1 = SCIPgetIndex1Zeroone(scip, cons);
-      index2 = SCIPgetIndex2Zeroone(scip, cons);
-      type = SCIPgetTypeZeroone(scip, cons);
+   assert( scip != NULL );
+   assert( pricerdata != NULL );
+   assert( round != NULL );
 
-      if(index1 != k)
-         continue;
+   subscip = pricerdata->subscips[k];
+   vars = pricerdata->subvars[k];
+   assert( subscip != NULL );
+   assert( pricerdata->nfixedvars[k] == 0 );
+
+   /* loop over the branching decisions of flow k on the current path of the search tree */
+   for( d = round->decbeg[k]; d < round->decbeg[k+1]; ++d )
+   {
+      index2 = round->decindex[d];
 
-      SCIPdebugMessage("set variable x_%d_%d to %d\n", index1, index2, type == ZERO ? 0 : 1);
+      SCIPdebugMessage("set variable x_%d_%d to %d\n", k, index2, round->dectype[d] == ZERO ? 0 : 1);
 
-      /* depending on the branching type select the correct left and right hand side for the linear constraint which
-       * enforces this branching decision in the pricing problem MIP
+      /* depending on the branching type fix the original variable in the pricing problem; the bound change is
+       * remembered such that it can be undone before the next pricing round
        */
-      if( type == ZERO )
-      {
-         SCIP_CALL( SCIPfixVar(subscip, vars[index2], 0.0, &infeasible, &fixed) );
-      }
-      else if( type == ONE )
+      if( round->dectype[d] == ZERO )
       {
-         SCIP_CALL( SCIPfixVar(subscip, vars[index2], 1.0, &infeasible, &fixed) );
+         SCIP_CALL( SCIPchgVarUb(subscip, vars[index2], 0.0) );
       }
       else
       {
-         SCIPerrorMessage("unknow constraint type <%d>\n, type");
-         return SCIP_INVALIDDATA;
+         assert( round->dectype[d] == ONE );
+         SCIP_CALL( SCIPchgVarLb(subscip, vars[index2], 1.0) );
       }
 
-      //SCIPdebugPrintCons(subscip, cons, NULL);
-
-      //SCIP_CALL( SCIPaddCons(subscip, cons) );
-      //SCIP_CALL( SCIPreleaseCons(subscip, &cons) );
+      pricerdata->fixedvars[k][pricerdata->nfixedvars[k]] = index2;
+      pricerdata->nfixedvars[k]++;
    }
 
    return SCIP_OKAY;
@@ -256,17 +441,16 @@ SCIP_RETCODE addFixedVarsConss(
    return SCIP_OKAY;
 }
 
-/** initializes the pricing problem for the given capacity */
+/** initializes the pricing problem for the given flow; the objective coefficients depending on the dual values are
+ *  set by updatePricingObjective() before each solve
+ */
 static
 SCIP_RETCODE initPricing(
    SCIP*                 scip,               /**< SCIP data structure */
    SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
    SCIP*                 subscip,            /**< pricing SCIP data structure */
    SCIP_VAR**            vars,               /**< variable array  */
-   int                   k,                  /**< index of current subproblem */
-   double*               alpha,
-   double*               beta,
-   double*               gamma
+   int                   k                   /**< index of current subproblem */
    )
 {
    SCIP_CONS** conss;
@@ -277,8 +461,7 @@ SCIP_RETCODE initPricing(
    int nvars;
    int i,j,l;
 
-   OAARNode* Nodes;
-   OAARLink* Links;
+   OAARTopology* topology;
    OAARFlow* Flows;
    int nNodes, nOpticalNodes, nElecNodes;
    int nLinks, nOpticalLinks, nElecLinks;
@@ -286,10 +469,10 @@ SCIP_RETCODE initPricing(
    int nCons;
    int* nFlowSol;
 
-   double tempDelay, tempJitter, tempBandCost, tempC;
+   double* linkcost;
    char tempName[SCIP_MAXSTRLEN];
-   OAARNode tempNode;
-   OAARLink tempLink;
+   OAARAdjacency* adj;
+   int p;
 
    assert( SCIPgetStage(subscip) == SCIP_STAGE_PROBLEM );
    assert(pricerdata != NULL);
@@ -298,8 +481,7 @@ SCIP_RETCODE initPricing(
    assert(probdata != NULL);
 
    conss = pricerdata->conss;
-   Nodes = pricerdata->Nodes;
-   Links = pricerdata->Links;
+   topology = pricerdata->Topology;
    Flows = pricerdata->Flows;
    nNodes = pricerdata->nNodes;
    nOpticalNodes = pricerdata->nOpticalNodes;
@@ -308,41 +490,33 @@ SCIP_RETCODE initPricing(
    nFlows = pricerdata->nFlows;
    nCons = pricerdata->nCons;
    nFlowSol = SCIPprobdataGetNFlowSol(probdata);
+   adj = SCIPprobdataGetAdjacency(probdata);
    nvars = 0;
    nElecLinks = nLinks - nOpticalLinks;
    nElecNodes = nNodes - nOpticalNodes;
    //create variables
    //create x 
+   SCIP_CALL( SCIPallocBufferArray(scip, &linkcost, nLinks) );
+   computeLinkCosts(topology, &Flows[k], 0, nLinks, linkcost);
    for(i = 0; i < nLinks; i++)
    {
-      tempLink = Links[i];
-      tempNode = Nodes[tempLink.Head];
-      tempDelay = tempNode.ProcDelay + tempNode.QueueDelay + tempLink.PropDelay + tempLink.TransDelay;
-      tempJitter = tempNode.Jitter;
-      tempBandCost = tempLink.BandCost;
-      tempC = Flows[k].DelayPrice * tempDelay + Flows[k].JitterPrice * tempJitter + 
-                 Flows[k].BandWidth * tempBandCost;
-      if(i >= nOpticalLinks)
-      {
-         tempC -= alpha[i-nOpticalLinks] * Flows[k].BandWidth;
-      }
       (void)SCIPsnprintf(tempName, SCIP_MAXSTRLEN, "PricerVarX_%d", i);
-      SCIP_CALL( SCIPcreateVarBasic(subscip, &var, tempName, 0.0, 1.0, -tempC,
+      SCIP_CALL( SCIPcreateVarBasic(subscip, &var, tempName, 0.0, 1.0, -linkcost[i],
          SCIP_VARTYPE_BINARY) );
-      SCIPdebugMessage("Create variable %s with objective coef %lf \n", tempName, -tempC);
+      SCIPdebugMessage("Create variable %s with objective coef %lf \n", tempName, -linkcost[i]);
       SCIP_CALL( SCIPaddVar(subscip, var) );
       vars[i] = var;
       SCIP_CALL( SCIPreleaseVar(subscip, &var) );
    }
+   SCIPfreeBufferArray(scip, &linkcost);
    //create y
    for(i = 0; i < nOpticalLinks; i++)
    {
       for(j = 0; j < nWaveLength; j++)
       {
          (void)SCIPsnprintf(tempName, SCIP_MAXSTRLEN, "PricerVarY_%d_%d", i, j);
-         SCIP_CALL( SCIPcreateVarBasic(subscip, &var, tempName, 0.0, 1.0, beta[i*nWaveLength+j],
-	    SCIP_VARTYPE_BINARY) );
-	 SCIPdebugMessage("Create variable %s with objective coef %lf \n", tempName, beta[i*nWaveLength+j]);
+         SCIP_CALL( SCIPcreateVarBasic(subscip, &var, tempName, 0.0, 1.0, 0.0, SCIP_VARTYPE_BINARY) );
+	 SCIPdebugMessage("Create variable %s with objective coef 0 \n", tempName);
 	 SCIP_CALL( SCIPaddVar(subscip, var) );
 	 vars[nLinks+i*nWaveLength+j] = var;
 	 SCIP_CALL( SCIPreleaseVar(subscip, &var) );
@@ -366,12 +540,9 @@ SCIP_RETCODE initPricing(
    //create subCons1
    SCIP_CALL( SCIPcreateConsBasicSetpart(subscip, &cons, "subCons1", 0, NULL) );
    SCIP_CALL( SCIPaddCons(subscip, cons) );
-   for(i = 0; i < nLinks; i++)
+   for(p = adj->OutBeg[Flows[k].Source]; p < adj->OutBeg[Flows[k].Source+1]; p++)
    {
-      if(Links[i].Head == Flows[k].Source)
-      {
-         SCIP_CALL( SCIPaddCoefSetppc(subscip, cons, vars[i]) );
-      }
+      SCIP_CALL( SCIPaddCoefSetppc(subscip, cons, vars[adj->OutLinks[p]]) );
    }
    SCIP_CALL( SCIPreleaseCons(subscip, &cons) );
 
@@ -382,17 +553,15 @@ SCIP_RETCODE initPricing(
       (void)SCIPsnprintf(tempName, SCIP_MAXSTRLEN, "subCons2_%d", i);
       SCIP_CALL( SCIPcreateConsBasicLinear(subscip, &cons, tempName, 0, NULL, NULL, 0, 0) );
       SCIP_CALL( SCIPaddCons(subscip, cons) );
-      //add vars to the cons
-      for(j = 0; j < nLinks; j++)
+      //add vars to the cons; a loop at i only counts as out-link
+      for(p = adj->OutBeg[i]; p < adj->OutBeg[i+1]; p++)
       {
-         if(Links[j].Head == i)
-	 {
-	    SCIP_CALL( SCIPaddCoefLinear(subscip, cons, vars[j], 1) );
-	 }
-	 else if(Links[j].Tail == i)
-	 {
-	    SCIP_CALL( SCIPaddCoefLinear(subscip, cons, vars[j], -1) );
-	 }
+         SCIP_CALL( SCIPaddCoefLinear(subscip, cons, vars[adj->OutLinks[p]], 1) );
+      }
+      for(p = adj->InBeg[i]; p < adj->InBeg[i+1]; p++)
+      {
+         if(topology->Head[adj->InLinks[p]] == i) continue;
+         SCIP_CALL( SCIPaddCoefLinear(subscip, cons, vars[adj->InLinks[p]], -1) );
       }
       SCIP_CALL( SCIPreleaseCons(subscip, &cons) );
    }
@@ -400,12 +569,9 @@ SCIP_RETCODE initPricing(
    //create subCons3
    SCIP_CALL( SCIPcreateConsBasicSetpart(subscip, &cons, "subCons3", 0, NULL) );
    SCIP_CALL( SCIPaddCons(subscip, cons) );
-   for(i = 0; i < nLinks; i++)
+   for(p = adj->InBeg[Flows[k].Destination]; p < adj->InBeg[Flows[k].Destination+1]; p++)
    {
-      if(Links[i].Tail == Flows[k].Destination)
-      { 
-         SCIP_CALL( SCIPaddCoefSetppc(subscip, cons, vars[i]) );
-      }
+      SCIP_CALL( SCIPaddCoefSetppc(subscip, cons, vars[adj->InLinks[p]]) );
    }
    SCIP_CALL( SCIPreleaseCons(subscip, &cons) );
 
@@ -433,18 +599,19 @@ SCIP_RETCODE initPricing(
          (void)SCIPsnprintf(tempName, SCIP_MAXSTRLEN, "subCons5_%d_%d", i, j);
 	 SCIP_CALL( SCIPcreateConsBasicLinear(subscip, &cons, tempName, 0, NULL, NULL, 0, 0) );
 	 SCIP_CALL( SCIPaddCons(subscip, cons) );
-	 for(l = 0; l < nOpticalLinks; l++)
+	 //only the optical links of node i; a loop at i only counts as in-link
+	 for(p = adj->InBeg[i]; p < adj->InOptEnd[i]; p++)
+	 {
+	    l = adj->InLinks[p];
+	    SCIP_CALL( SCIPaddCoefLinear(subscip, cons, 
+	       vars[nLinks+nOpticalLinks*nWaveLength+l*nWaveLength+j], 1) );
+	 }
+	 for(p = adj->OutBeg[i]; p < adj->OutOptEnd[i]; p++)
 	 {
-	    if(Links[l].Tail == i)
-	    {
-	       SCIP_CALL( SCIPaddCoefLinear(subscip, cons, 
-	          vars[nLinks+nOpticalLinks*nWaveLength+l*nWaveLength+j], 1) );
-	    }
-	    else if(Links[l].Head == i)
-	    {
-	       SCIP_CALL( SCIPaddCoefLinear(subscip, cons, 
-	          vars[nLinks+nOpticalLinks*nWaveLength+l*nWaveLength+j], -1) );
-	    }
+	    l = adj->OutLinks[p];
+	    if(topology->Tail[l] == i) continue;
+	    SCIP_CALL( SCIPaddCoefLinear(subscip, cons, 
+	       vars[nLinks+nOpticalLinks*nWaveLength+l*nWaveLength+j], -1) );
 	 }
 	 SCIP_CALL( SCIPreleaseCons(subscip, &cons) );
       }
@@ -484,9 +651,6 @@ SCIP_RETCODE initPricing(
       }
    }
 
-   /* add constraint of the branching decisions */
-   SCIP_CALL( addBranchingDecisionConss(scip, subscip, vars, pricerdata->conshdlr, k) );
-
    /* avoid to generate columns which are fixed to zero */
    //SCIP_CALL( addFixedVarsConss(scip, subscip, vars, conss, nitems) );
 
@@ -496,189 +660,1633 @@ SCIP_RETCODE initPricing(
 
 }
 
-/**@} */
-
-/**name Callback methods
- *
- * @{
+/** returns the cost of routing flow k over link i without the dual values; like the objective of the columns, it is
+ *  weighted by the priority of the flow
  */
+static
+SCIP_Real getLinkCost(
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   int                   k,                  /**< index of the flow */
+   int                   i                   /**< index of the link */
+   )
+{
+   OAARTopology* topology;
+   OAARFlow* flow;
 
-/** destructor of variable pricer to free user data (called when SCIP is exiting) */
+   topology = pricerdata->Topology;
+   flow = &pricerdata->Flows[k];
+
+   return flow->Priority * (flow->DelayPrice * topology->Delay[i] + flow->JitterPrice * topology->Jitter[i]
+      + flow->BandWidth * topology->BandCost[i]);
+}
+
+/** sets the objective coefficients of the pricing problem of flow k w.r.t. the current dual values */
 static
-SCIP_DECL_PRICERFREE(pricerFreeOAAR)
+SCIP_RETCODE updatePricingObjective(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   int                   k,                  /**< index of current subproblem */
+   double*               alpha,              /**< dual values of the capacity constraints (Cons2) */
+   double*               beta,               /**< dual values of the wavelength constraints (Cons3) */
+   SCIP_Real*            linkcost            /**< buffer for the reduced cost of each link */
+   )
 {
-   SCIP_PRICERDATA* pricerdata;
+   SCIP* subscip;
+   SCIP_VAR** vars;
+   int nLinks, nOpticalLinks;
+   int i,j;
 
-   assert(scip != NULL);
-   assert(pricer != NULL);
+   assert(pricerdata != NULL);
 
-   pricerdata = SCIPpricerGetData(pricer);
+   subscip = pricerdata->subscips[k];
+   vars = pricerdata->subvars[k];
+   nLinks = pricerdata->nLinks;
+   nOpticalLinks = pricerdata->nOpticalLinks;
 
-   if( pricerdata != NULL)
-   {
-      /* free memory */
-      SCIPfreeMemoryArrayNull(scip, &pricerdata->conss);
-      SCIPfreeMemoryArrayNull(scip, &pricerdata->Nodes);
-      SCIPfreeMemoryArrayNull(scip, &pricerdata->Links);
-      SCIPfreeMemoryArrayNull(scip, &pricerdata->Flows);
+   assert( SCIPgetStage(subscip) == SCIP_STAGE_PROBLEM );
 
-      SCIPfreeMemory(scip, &pricerdata);
+   /* only the electrical links have a dual value, the objective of the optical x variables never changes */
+   computeLinkRedcosts(pricerdata->Topology, &pricerdata->Flows[k], alpha, nOpticalLinks, nLinks, linkcost);
+   for(i = nOpticalLinks; i < nLinks; i++)
+   {
+      SCIP_CALL( SCIPchgVarObj(subscip, vars[i], -linkcost[i]) );
+   }
+   for(i = 0; i < nOpticalLinks; i++)
+   {
+      for(j = 0; j < nWaveLength; j++)
+      {
+         SCIP_CALL( SCIPchgVarObj(subscip, vars[nLinks+i*nWaveLength+j], beta[i*nWaveLength+j]) );
+      }
    }
 
    return SCIP_OKAY;
 }
 
-
-/** initialization method of variable pricer (called after problem was transformed) */
+/** creates the pricing problem of flow k; it is created by the first pricing round which solves the MIP of flow k, not
+ *  in pricerInitsolOAAR(), since flows priced by the shortest path engine never need it, and it stays alive until
+ *  pricerExitsolOAAR()
+ */
 static
-SCIP_DECL_PRICERINIT(pricerInitOAAR)
-{  /*lint --e{715}*/
-   SCIP_PRICERDATA* pricerdata;
-   SCIP_CONS* cons;
-   int c;
-
-   assert(scip != NULL);
-   assert(pricer != NULL);
+SCIP_RETCODE createPricingProblem(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   int                   k                   /**< index of current subproblem */
+   )
+{
+   SCIP* subscip;
+   char name[SCIP_MAXSTRLEN];
+   SCIP_Real buildtime;
+   int nsubvars;
 
-   pricerdata = SCIPpricerGetData(pricer);
    assert(pricerdata != NULL);
+   assert(pricerdata->subscips[k] == NULL);
 
-   /* get transformed constraints */
-   for( c = 0; c < pricerdata->nCons; ++c )
-   {
-      cons = pricerdata->conss[c];
+   buildtime = SCIPgetClockTime(scip, pricerdata->buildclock);
+   SCIP_CALL( SCIPstartClock(scip, pricerdata->buildclock) );
 
-      /* release original constraint */
-      SCIP_CALL( SCIPreleaseCons(scip, &pricerdata->conss[c]) );
+   //nx(nLinks) + ny(nOpticalLinks*nWavelength) + nz(nOpticalLinks*nWavelength)
+   nsubvars = pricerdata->nLinks + 2*pricerdata->nOpticalLinks*nWaveLength;
 
-      /* get transformed constraint */
-      SCIP_CALL( SCIPgetTransformedCons(scip, cons, &pricerdata->conss[c]) );
+   /* initialize SCIP */
+   SCIP_CALL( SCIPcreate(&subscip) );
+   SCIP_CALL( SCIPincludeDefaultPlugins(subscip) );
 
-      /* capture transformed constraint */
-      SCIP_CALL( SCIPcaptureCons(scip, pricerdata->conss[c]) );
-   }
+   /* create problem in sub SCIP */
+   (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "pricing_%d", k);
+   SCIP_CALL( SCIPcreateProbBasic(subscip, name) );
+   SCIP_CALL( SCIPsetObjsense(subscip, SCIP_OBJSENSE_MAXIMIZE) );
+
+   /* do not abort subproblem on CTRL-C */
+   SCIP_CALL( SCIPsetBoolParam(subscip, "misc/catchctrlc", FALSE) );
+
+   /* disable output to console */
+   SCIP_CALL( SCIPsetIntParam(subscip, "display/verblevel", 0) );
+
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->subvars[k], nsubvars) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->fixedvars[k], nsubvars) );
+   pricerdata->nfixedvars[k] = 0;
+
+   /* initialization local pricing problem */
+   SCIP_CALL( initPricing(scip, pricerdata, subscip, pricerdata->subvars[k], k) );
+
+   pricerdata->subscips[k] = subscip;
+   pricerdata->nbuilds++;
+
+   SCIP_CALL( SCIPstopClock(scip, pricerdata->buildclock) );
+   pricerdata->flowstats[k].buildtime += SCIPgetClockTime(scip, pricerdata->buildclock) - buildtime;
 
    return SCIP_OKAY;
 }
 
-
-/** solving process deinitialization method of variable pricer (called before branch and bound process data is freed) */
+/** frees the pricing problem of flow k */
 static
-SCIP_DECL_PRICEREXITSOL(pricerExitsolOAAR)
+SCIP_RETCODE freePricingProblem(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   int                   k                   /**< index of current subproblem */
+   )
 {
-   SCIP_PRICERDATA* pricerdata;
-   int c;
-
-   assert(scip != NULL);
-   assert(pricer != NULL);
-
-   pricerdata = SCIPpricerGetData(pricer);
    assert(pricerdata != NULL);
 
-   /* get release constraints */
-   for( c = 0; c < pricerdata->nCons; ++c )
-   {
-      /* release constraint */
-      SCIP_CALL( SCIPreleaseCons(scip, &(pricerdata->conss[c])) );
-   }
+   if( pricerdata->subscips[k] == NULL )
+      return SCIP_OKAY;
+
+   SCIPfreeMemoryArray(scip, &pricerdata->fixedvars[k]);
+   SCIPfreeMemoryArray(scip, &pricerdata->subvars[k]);
+   SCIP_CALL( SCIPfree(&pricerdata->subscips[k]) );
+   pricerdata->subscips[k] = NULL;
 
    return SCIP_OKAY;
 }
 
-
-/** reduced cost pricing method of variable pricer for feasible LPs */
+/** creates the column of flow k which uses the original variables (x, y, z of the pricing problem) given by
+ *  oriFlowVars and adds it to the master problem, unless the same path is already a variable of the master problem
+ */
 static
-SCIP_DECL_PRICERREDCOST(pricerRedcostOAAR)
-{  /*lint --e{715}*/
-   SCIP* subscip;
-   SCIP_PRICERDATA* pricerdata;
+SCIP_RETCODE addPathColumn(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   int                   k,                  /**< index of the flow */
+   int*                  oriFlowVars,        /**< value (0 or 1) of each original variable of the pricing problem */
+   SCIP_Bool*            added               /**< pointer to store whether the column was added */
+   )
+{
    SCIP_PROBDATA* probdata;
    SCIP_CONS** conss;
-   SCIP_CONS* cons;
-   SCIP_VAR** vars;
-   SCIP_Bool addvar;
-
-   SCIP_SOL** sols;
-   int nsols;
-   int s;
-   int i,j;
-
-   int nNodes, nLinks, nFlows;
-   int nOpticalNodes, nOpticalLinks;
-   int nElecLinks;
+   SCIP_VAR* var;
+   SCIP_VARDATA* vardata;
+   int* consids;
+   int nconss;
    int* nFlowSol;
-   OAARNode* Nodes;
-   OAARLink* Links;
-   OAARFlow* Flows;
-
-   double* alpha;
-   double* beta;
-   double* gamma;
-
-   int k; //current index of subproblem
-   int nAddedColumn;
-
-   char name[SCIP_MAXSTRLEN];
+   char tempName[SCIP_MAXSTRLEN];
 
+   OAARTopology* topology;
+   OAARFlow tempFlow;
+   double tempJitter;
+   double tempDelay;
+   double tempBandCost;
+   double tempObj;
+
+   int nLinks, nOpticalLinks, nElecLinks, nFlows;
+   int nOriFlowVars;
+   int* oriVars;
+   int nOriVars;
+   int i,j;
 
-   SCIP_Real timelimit;
-   SCIP_Real memorylimit;
+   int col;
 
-   assert(scip != NULL);
-   assert(pricer != NULL);
+   assert(pricerdata != NULL);
+   assert(oriFlowVars != NULL);
+   assert(added != NULL);
 
-   (*result) = SCIP_DIDNOTRUN;
+   /* a path which was generated before is only added again if its variable was deleted; the pool is searched by the
+    * sorted indices of the original variables of the path
+    */
+   nOriFlowVars = pricerdata->nLinks + 2*pricerdata->nOpticalLinks*nWaveLength;
+   SCIP_CALL( SCIPallocBufferArray(scip, &oriVars, nOriFlowVars) );
+   nOriVars = 0;
+   for( i = 0; i < nOriFlowVars; i++ )
+   {
+      if( oriFlowVars[i] == 1 )
+      {
+         oriVars[nOriVars] = i;
+         nOriVars++;
+      }
+   }
+   col = SCIPcolpoolFindCol(pricerdata->colpool, k, oriVars, nOriVars);
+   SCIPfreeBufferArray(scip, &oriVars);
 
-   /* get the pricer data */
-   pricerdata = SCIPpricerGetData(pricer);
-   assert(pricerdata != NULL);
+   if( col >= 0 && SCIPcolpoolGetVar(pricerdata->colpool, col) != NULL )
+   {
+      SCIPdebugMessage("path of flow %d is already variable <%s>\n", k,
+         SCIPvarGetName(SCIPcolpoolGetVar(pricerdata->colpool, col)));
+      pricerdata->nduplicates++;
+      *added = FALSE;
+      return SCIP_OKAY;
+   }
+   *added = TRUE;
 
    probdata = SCIPgetProbData(scip);
    assert(probdata != NULL);
 
    conss = pricerdata->conss;
-   Nodes = pricerdata->Nodes;
-   Links = pricerdata->Links;
-   Flows = pricerdata->Flows;
-   nNodes = pricerdata->nNodes;
-   nOpticalNodes = pricerdata->nOpticalNodes;
    nLinks = pricerdata->nLinks;
    nOpticalLinks = pricerdata->nOpticalLinks;
+   nElecLinks = nLinks - nOpticalLinks;
    nFlows = pricerdata->nFlows;
    nFlowSol = SCIPprobdataGetNFlowSol(probdata);
-   nElecLinks = nLinks - nOpticalLinks;
-
-   SCIP_CALL( SCIPallocBufferArray(scip, &alpha, nElecLinks) );
-   SCIP_CALL( SCIPallocBufferArray(scip, &beta, nOpticalLinks*nWaveLength) );
-   SCIP_CALL( SCIPallocBufferArray(scip, &gamma, nFlows) );
 
-   //get dual values
-   //gamma for FlowCons1
-   for(i = 0; i < nFlows; i++)
-   {
-      cons = conss[i];
+   nconss = 0;
 
-      //TODO: check constraint handler
+   //1(cons1) + nElecLinks(cons2) + nOpticalLinks*nWaveLength(cons3)
+   SCIP_CALL( SCIPallocBufferArray(scip, &consids, 1+nElecLinks+nOpticalLinks*nWaveLength) );
 
-      gamma[i] = SCIPgetDualsolSetppc(scip, cons);
-   }
-   //alpha for ElecCons2
+   //construct consids
+   consids[0] = k; nconss++;
    for(i = 0; i < nElecLinks; i++)
    {
-      cons = conss[i+nFlows];
-      alpha[i] = SCIPgetDualsolKnapsack(scip, cons);
+      if( oriFlowVars[nOpticalLinks+i] == 1 )
+      {
+         consids[nconss] = nFlows + i;
+         nconss++;
+      }
    }
-   //beta for OpticalCons3
    for(i = 0; i < nOpticalLinks; i++)
    {
       for(j = 0; j < nWaveLength; j++)
       {
-         cons = conss[i*nWaveLength+j+nFlows+nElecLinks];
-         beta[i*nWaveLength+j] = SCIPgetDualsolSetppc(scip, cons);
+         if( oriFlowVars[nLinks+i*nWaveLength+j] == 1 )
+         {
+            consids[nconss] = nFlows + nElecLinks + i*nWaveLength + j;
+            nconss++;
+         }
       }
    }
 
-   SCIPdebugMessage("Print dual values:\n");
+   SCIP_CALL( SCIPvardataCreateOAAR(scip, &vardata, consids, nconss, oriFlowVars,
+      nLinks+2*nOpticalLinks*nWaveLength, k, nFlowSol[k]) );
+
+   /* the flow and column id are kept in the variable data, so the name is only needed for output */
+   if( SCIPprobdataHasVarNames(probdata) )
+      (void) SCIPsnprintf(tempName, SCIP_MAXSTRLEN, "lambda_%d_%d", k, nFlowSol[k]);
+
+   /* create variable for a new column */
+   tempFlow = pricerdata->Flows[k];
+   topology = pricerdata->Topology;
+   tempDelay = 0; tempJitter = 0; tempBandCost = 0;
+   for(i = 0; i < nLinks; i++)
+   {
+      if( oriFlowVars[i] == 1 )
+      {
+         tempDelay += topology->Delay[i];
+         tempJitter += topology->Jitter[i];
+         tempBandCost += topology->BandCost[i];
+         SCIPdebugMessage("Include link %d\n", i);
+      }
+   }
+   tempObj = tempFlow.Priority * (tempFlow.DelayPrice * tempDelay + 
+      tempFlow.JitterPrice * tempJitter + tempFlow.BandWidth * tempBandCost);
+   SCIP_CALL( SCIPcreateVarOAAR(scip, &var, SCIPprobdataHasVarNames(probdata) ? tempName : NULL, tempObj, FALSE,
+         TRUE, vardata) );
+   SCIPdebugMessage("Add variable %s with obj %lf\n", SCIPvarGetName(var), tempObj);
+   SCIPdebugMessage("tempDelay:%lf, tempJitter:%lf, tempBandCost:%lf\n",
+      tempDelay, tempJitter, tempBandCost);
+
+   /* add the new variable to the pricer store */
+   SCIP_CALL( SCIPaddPricedVar(scip, var, 1.0) );
+
+   SCIP_CALL( SCIPchgVarUbLazy(scip, var, 1.0) );
+
+   for( i = 0; i < nconss; i++ )
+   {
+      //assert(SCIPconsIsEnabled(conss[consids[i]]));
+      if(i == 0)
+      {
+         SCIP_CALL( SCIPaddCoefSetppc(scip, conss[consids[i]], var) );
+      }
+      else if( consids[i] < nFlows + nElecLinks )
+      {
+         SCIP_CALL( SCIPaddCoefKnapsack(scip, conss[consids[i]], var, tempFlow.BandWidth) );
+      }
+      else
+      {
+         SCIP_CALL( SCIPaddCoefSetppc(scip, conss[consids[i]], var) );
+      }
+   }
+
+   SCIPdebug(SCIPprintVar(scip, var, NULL) );
+
+   /* remember the column in the pool */
+   if( col >= 0 )
+   {
+      SCIP_CALL( SCIPcolpoolSetVar(scip, pricerdata->colpool, col, var) );
+   }
+   else
+   {
+      SCIP_CALL( SCIPcolpoolAddCol(scip, pricerdata->colpool, k, var, NULL) );
+   }
+
+   SCIP_CALL( SCIPreleaseVar(scip, &var) );
+
+   SCIPfreeBufferArray(scip, &consids);
+
+   return SCIP_OKAY;
+}
+
+/** returns the reduced cost of a column of flow k w.r.t. the given dual values, measured like in the pricing problems */
+static
+SCIP_Real getColumnRedcost(
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   int                   k,                  /**< index of the flow */
+   int*                  oriFlowVars,        /**< value (0 or 1) of each original variable of the pricing problem */
+   double*               alpha,              /**< dual values of the capacity constraints (Cons2) */
+   double*               beta,               /**< dual values of the wavelength constraints (Cons3) */
+   double*               gamma               /**< dual values of the flow constraints (Cons1) */
+   )
+{
+   SCIP_Real redcost;
+   int nLinks, nOpticalLinks;
+   int i;
+
+   nLinks = pricerdata->nLinks;
+   nOpticalLinks = pricerdata->nOpticalLinks;
+
+   redcost = -gamma[k];
+   for( i = 0; i < nLinks; i++ )
+   {
+      if( oriFlowVars[i] == 0 )
+         continue;
+
+      redcost += getLinkCost(pricerdata, k, i);
+      if( i >= nOpticalLinks )
+         redcost -= alpha[i-nOpticalLinks] * pricerdata->Flows[k].BandWidth;
+   }
+   for( i = 0; i < nOpticalLinks*nWaveLength; i++ )
+   {
+      if( oriFlowVars[nLinks+i] == 1 )
+         redcost -= beta[i];
+   }
+
+   return redcost;
+}
+
+/** returns the Lagrangian bound at the given dual values, or -infinity if the reduced cost of some flow is unknown
+ *
+ *  The bound is the dual objective plus the minimal reduced cost of each flow, both w.r.t. the given dual values, and
+ *  it is valid for all dual values of the right sign, in particular for the smoothed ones. The reduced cost bounds in
+ *  redcostbound have to belong to the same dual values.
+ */
+static
+SCIP_Real computeLagrangeBound(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   double*               alpha,              /**< dual values of the capacity constraints (Cons2) */
+   double*               beta,               /**< dual values of the wavelength constraints (Cons3) */
+   double*               gamma               /**< dual values of the flow constraints (Cons1) */
+   )
+{
+   SCIP_Real bound;
+   int nElecLinks;
+   int nFlows;
+   int i;
+
+   nFlows = pricerdata->nFlows;
+   nElecLinks = pricerdata->nLinks - pricerdata->nOpticalLinks;
+
+   bound = 0.0;
+   for( i = 0; i < nFlows; i++ )
+   {
+      if( SCIPisInfinity(scip, -pricerdata->redcostbound[i]) )
+         return -SCIPinfinity(scip);
+
+      /* taking the minimum with zero weakens the bound, but keeps it finite for flows without any column */
+      bound += gamma[i] + MIN(0.0, pricerdata->redcostbound[i]);
+   }
+   for( i = 0; i < nElecLinks; i++ )
+      bound += alpha[i] * SCIPgetCapacityKnapsack(scip, pricerdata->conss[i+nFlows]);
+   for( i = 0; i < pricerdata->nOpticalLinks*nWaveLength; i++ )
+      bound += beta[i];
+
+   return bound;
+}
+
+/** returns the storage of column c found for flow k in the current pricing round */
+static
+int* getColumnVals(
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   int                   k,                  /**< index of the flow */
+   int                   c                   /**< index of the column, 0 <= c < MAXPRICINGCOLS */
+   )
+{
+   int nOriFlowVars;
+
+   assert(pricerdata != NULL);
+   assert(0 <= c && c < MAXPRICINGCOLS);
+
+   nOriFlowVars = pricerdata->nLinks + 2*pricerdata->nOpticalLinks*nWaveLength;
+
+   return &pricerdata->colvals[(k*MAXPRICINGCOLS + c) * nOriFlowVars];
+}
+
+/** collects the branching decisions of the active zeroone constraints, grouped by flow; during probing, the decision
+ *  set by SCIPpricerOAARSetProbingDecision() is added
+ */
+static
+SCIP_RETCODE collectBranchingDecisions(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   PRICINGROUND*         round               /**< data of the pricing round to store the decisions in */
+   )
+{
+   SCIP_CONS** conss;
+   SCIP_CONS* cons;
+   int nconss;
+   int* fill;
+   int c;
+   int k;
+
+   assert(pricerdata != NULL);
+   assert(round != NULL);
+
+   conss = SCIPconshdlrGetConss(pricerdata->conshdlr);
+   nconss = SCIPconshdlrGetNConss(pricerdata->conshdlr);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &round->decbeg, pricerdata->nFlows+1) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &round->decindex, nconss+1) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &round->dectype, nconss+1) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &fill, pricerdata->nFlows) );
+
+   /* count the decisions of each flow; constraints which are not active do not lie on the current path of the search
+    * tree
+    */
+   for( k = 0; k <= pricerdata->nFlows; k++ )
+      round->decbeg[k] = 0;
+   for( c = 0; c < nconss; ++c )
+   {
+      cons = conss[c];
+      if( !SCIPconsIsActive(cons) )
+         continue;
+
+      if( SCIPgetTypeZeroone(scip, cons) != ZERO && SCIPgetTypeZeroone(scip, cons) != ONE )
+      {
+         SCIPerrorMessage("unknow constraint type <%d>\n", SCIPgetTypeZeroone(scip, cons));
+         SCIPfreeBufferArray(scip, &fill);
+         return SCIP_INVALIDDATA;
+      }
+
+      round->decbeg[SCIPgetIndex1Zeroone(scip, cons)+1]++;
+   }
+   if( pricerdata->probeflow >= 0 && SCIPinProbing(scip) )
+      round->decbeg[pricerdata->probeflow+1]++;
+   for( k = 0; k < pricerdata->nFlows; k++ )
+   {
+      round->decbeg[k+1] += round->decbeg[k];
+      fill[k] = round->decbeg[k];
+   }
+
+   for( c = 0; c < nconss; ++c )
+   {
+      cons = conss[c];
+      if( !SCIPconsIsActive(cons) )
+         continue;
+
+      k = SCIPgetIndex1Zeroone(scip, cons);
+      round->decindex[fill[k]] = SCIPgetIndex2Zeroone(scip, cons);
+      round->dectype[fill[k]] = SCIPgetTypeZeroone(scip, cons);
+      fill[k]++;
+   }
+   if( pricerdata->probeflow >= 0 && SCIPinProbing(scip) )
+   {
+      k = pricerdata->probeflow;
+      round->decindex[fill[k]] = pricerdata->probeindex;
+      round->dectype[fill[k]] = pricerdata->probetype;
+      fill[k]++;
+   }
+
+   SCIPfreeBufferArray(scip, &fill);
+
+   return SCIP_OKAY;
+}
+
+/** solves the pricing MIP of flow k and stores up to MAXPRICINGCOLS columns with negative reduced cost
+ *
+ *  Only the pricing problem of flow k is modified, hence the MIPs of different flows can be solved in parallel. The
+ *  pricing problem has to be created before.
+ */
+static
+SCIP_RETCODE solvePricingMIP(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   PRICINGROUND*         round,              /**< data of the current pricing round */
+   PRICINGWS*            ws,                 /**< workspace of the calling thread */
+   int                   k                   /**< index of current subproblem */
+   )
+{
+   SCIP* subscip;
+   SCIP_VAR** vars;
+   SCIP_SOL** sols;
+   int nsols;
+   int s;
+   int i;
+   int nAddedColumn;
+   int* oriFlowVars;
+   int nOriFlowVars;
+   SCIP_Real dualbound;
+
+   assert(pricerdata != NULL);
+   assert(round != NULL);
+   assert(ws != NULL);
+   assert(pricerdata->subscips[k] != NULL);
+
+   pricerdata->ncols[k] = 0;
+   pricerdata->solved[k] = FALSE;
+   pricerdata->redcostbound[k] = -SCIPinfinity(scip);
+
+   subscip = pricerdata->subscips[k];
+   vars = pricerdata->subvars[k];
+
+   /* set time and memory limit */
+   SCIP_CALL( SCIPsetRealParam(subscip, "limits/time", round->timelimit) );
+   SCIP_CALL( SCIPsetRealParam(subscip, "limits/memory", round->memorylimit) );
+
+   /* update the objective to the current dual values and apply the branching decisions of the current node */
+   SCIP_CALL( updatePricingObjective(scip, pricerdata, k, round->alpha, round->beta, ws->linkcost) );
+   SCIP_CALL( SCIPresetClock(scip, ws->clock) );
+   SCIP_CALL( SCIPstartClock(scip, ws->clock) );
+   SCIP_CALL( addBranchingDecisionConss(scip, pricerdata, round, k) );
+   SCIP_CALL( SCIPstopClock(scip, ws->clock) );
+   pricerdata->flowstats[k].dectime += SCIPgetClockTime(scip, ws->clock);
+
+   /* with the objective limit, only improving columns are solutions; the MIP stops after enough of them or as soon as
+    * it proved that none exists, which is the only case in which it has to be solved to the end. The pricing problem is
+    * kept between rounds, so the limits are reset to the SCIP defaults if they are not used.
+    */
+   if( pricerdata->mipobjlimit )
+   {
+      SCIP_CALL( SCIPsetObjlimit(subscip, -round->gamma[k]) );
+      SCIP_CALL( SCIPsetIntParam(subscip, "limits/solutions", pricerdata->mipsollimit) );
+      SCIP_CALL( SCIPsetRealParam(subscip, "limits/gap", pricerdata->mipgaplimit) );
+   }
+   else
+   {
+      SCIP_CALL( SCIPsetObjlimit(subscip, SCIPinfinity(subscip)) );
+      SCIP_CALL( SCIPsetIntParam(subscip, "limits/solutions", -1) );
+      SCIP_CALL( SCIPsetRealParam(subscip, "limits/gap", 0.0) );
+   }
+
+   SCIPdebugMessage("solve pricer problem %d\n", k);
+
+   /* solve sub SCIP */
+   SCIP_CALL( SCIPsolve(subscip) );
+   pricerdata->flowstats[k].nmipcalls++;
+   pricerdata->flowstats[k].solvetime += SCIPgetSolvingTime(subscip);
+
+   sols = SCIPgetSols(subscip);
+   nsols = SCIPgetNSols(subscip);
+
+   if(nsols > MAXPRICINGCOLS)
+      nAddedColumn = MAXPRICINGCOLS;
+   else
+      nAddedColumn = nsols;
+
+   nOriFlowVars = pricerdata->nLinks+2*pricerdata->nOpticalLinks*nWaveLength;
+
+   /* loop over all solutions and store the corresponding column if the reduced cost are negative for master, that is
+    * the objective value i greater than gamma_k
+    */
+   for( s = 0; s < nAddedColumn; ++s )
+   {
+      SCIP_Bool feasible;
+      SCIP_SOL* sol;
+
+      /* the soultion should be sorted w.r.t. the objective function value */
+      assert(s == 0 || SCIPisFeasGE(subscip, SCIPgetSolOrigObj(subscip, sols[s-1]), SCIPgetSolOrigObj(subscip, sols[s])));
+
+      sol = sols[s];
+      assert(sol != NULL);
+
+      /* check if solution is feasible in original sub SCIP */
+      SCIP_CALL( SCIPcheckSolOrig(subscip, sol, &feasible, FALSE, FALSE ) );
+
+      if( !feasible )
+      {
+         SCIPwarningMessage(subscip, "solution in pricing problem %d is infeasible\n", k);
+         continue;
+      }
+
+      /* check if the solution has a value greater than gamma_k */
+      if( SCIPisFeasGT(subscip, SCIPgetSolOrigObj(subscip, sol), -round->gamma[k]) )
+      {
+         SCIPdebug( SCIP_CALL( SCIPprintSol(subscip, sol, NULL, FALSE) ) );
+
+         oriFlowVars = getColumnVals(pricerdata, k, pricerdata->ncols[k]);
+         for(i = 0; i < nOriFlowVars; i++)
+         {
+            if( SCIPgetSolVal(subscip, sol, vars[i]) > 0.5  )
+            {
+               oriFlowVars[i] = 1;
+            }
+            else
+            {
+               assert( SCIPisFeasEQ(subscip, SCIPgetSolVal(subscip, sol, vars[i]), 0.0) );
+               oriFlowVars[i] = 0;
+            }
+         }
+         pricerdata->ncols[k]++;
+      }
+      else
+      {
+         SCIPdebugMessage("No variable newly generated for flow %d\n", k);
+         break;
+      }
+   }
+
+   pricerdata->mipstatus[k] = SCIPgetStatus(subscip);
+   pricerdata->solved[k] = (SCIPgetStatus(subscip) == SCIP_STATUS_OPTIMAL);
+
+   /* the dual bound of the pricing MIP bounds the reduced cost of all columns of flow k, even if it was not solved to
+    * optimality; it is -infinity if the pricing MIP is infeasible
+    */
+   dualbound = SCIPgetDualbound(subscip);
+   if( pricerdata->mipobjlimit && SCIPgetStatus(subscip) == SCIP_STATUS_INFEASIBLE )
+   {
+      /* no solution is better than the objective limit, hence no column of flow k has negative reduced cost */
+      pricerdata->solved[k] = TRUE;
+      pricerdata->redcostbound[k] = 0.0;
+   }
+   else if( !SCIPisInfinity(subscip, dualbound) )
+      pricerdata->redcostbound[k] = SCIPisInfinity(subscip, -dualbound) ? SCIPinfinity(scip) : -dualbound - round->gamma[k];
+
+   /* return to the problem stage such that the model can be modified in the next round */
+   SCIP_CALL( SCIPfreeTransform(subscip) );
+   SCIP_CALL( resetBranchingDecisions(scip, pricerdata, k) );
+
+   return SCIP_OKAY;
+}
+
+/** heuristic pricing of flow k: computes a shortest path in the wavelength-layered graph
+ *
+ *  Dual values with the wrong sign are rounded to zero. This only increases the arc costs, hence a path which is
+ *  cheaper than gamma_k is still a column with negative reduced cost. The flow is marked as solved if no rounding was
+ *  needed, since the shortest path is then an optimal solution of the pricing MIP. Flows for which a branching decision
+ *  forces a variable to one or which need several wavelengths on an optical link are not handled. The master problem is
+ *  only read, hence this method can be called by several threads at the same time, each with its own workspace.
+ */
+static
+SCIP_RETCODE solvePricingShortestPath(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   PRICINGROUND*         round,              /**< data of the current pricing round */
+   PRICINGWS*            ws,                 /**< workspace of the calling thread */
+   int                   k                   /**< index of current subproblem */
+   )
+{
+   SCIP_Real* linkcost;
+   SCIP_Real* wavecost;
+   int npathlinks;
+   SCIP_Real pathcost;
+   SCIP_Bool found;
+   SCIP_Bool opticalallowed;
+   SCIP_Bool valid;
+   SCIP_Bool exact;
+
+   int* oriFlowVars;
+   int nOriFlowVars;
+   int nLinks, nOpticalLinks;
+   int nwaves;
+   int bandwidth;
+   int index2;
+   int d;
+   int i;
+
+   assert(pricerdata != NULL);
+   assert(pricerdata->graph != NULL);
+   assert(round != NULL);
+   assert(ws != NULL);
+
+   pricerdata->ncols[k] = 0;
+   pricerdata->solved[k] = FALSE;
+   pricerdata->redcostbound[k] = -SCIPinfinity(scip);
+
+   nLinks = pricerdata->nLinks;
+   nOpticalLinks = pricerdata->nOpticalLinks;
+   bandwidth = pricerdata->Flows[k].BandWidth;
+   linkcost = ws->linkcost;
+   wavecost = ws->wavecost;
+
+   /* number of wavelengths the flow needs on an optical link (subCons4); the engine only handles a single one */
+   if( bandwidth <= 0 )
+      return SCIP_OKAY;
+   nwaves = (bandwidth + WaveLengthBand - 1) / WaveLengthBand;
+   if( nwaves > 1 && nwaves <= nWaveLength )
+      return SCIP_OKAY;
+   opticalallowed = (nwaves <= nWaveLength);
+
+   /* reduced arc costs; the duals of the capacity (<=) and wavelength (<=) rows should be non-positive */
+   exact = TRUE;
+   computeLinkCosts(pricerdata->Topology, &pricerdata->Flows[k], 0, nOpticalLinks, linkcost);
+   computeLinkRedcosts(pricerdata->Topology, &pricerdata->Flows[k], round->alpha, nOpticalLinks, nLinks, linkcost);
+   for( i = 0; i < nLinks; i++ )
+   {
+      if( SCIPisDualfeasNegative(scip, linkcost[i]) )
+         exact = FALSE;
+      linkcost[i] = MAX(linkcost[i], 0.0);
+   }
+   for( i = 0; i < nOpticalLinks*nWaveLength; i++ )
+   {
+      wavecost[i] = -round->beta[i];
+      if( SCIPisDualfeasNegative(scip, wavecost[i]) )
+         exact = FALSE;
+      wavecost[i] = MAX(wavecost[i], 0.0);
+   }
+
+   /* apply the branching decisions of the current node; only decisions fixing a variable to zero can be modeled by
+    * removing arcs
+    */
+   for( d = round->decbeg[k]; d < round->decbeg[k+1]; d++ )
+   {
+      index2 = round->decindex[d];
+
+      if( round->dectype[d] == ONE )
+         return SCIP_OKAY;
+      else if( index2 < nLinks )
+         linkcost[index2] = SCIP_INVALID;
+      else if( index2 < nLinks + nOpticalLinks*nWaveLength )
+         wavecost[index2 - nLinks] = SCIP_INVALID;
+      else
+         wavecost[index2 - nLinks - nOpticalLinks*nWaveLength] = SCIP_INVALID;
+   }
+
+   SCIP_CALL( SCIPlayeredgraphShortestPath(pricerdata->graph, ws->graphws, pricerdata->Flows[k].Source,
+         pricerdata->Flows[k].Destination, linkcost, wavecost, opticalallowed, ws->pathlinks, ws->pathwaves,
+         &npathlinks, &pathcost, &found) );
+
+   /* the shortest walk is a relaxation of the pricing problem, so its cost bounds the reduced cost of flow k as long as
+    * no dual value was rounded
+    */
+   if( exact )
+      pricerdata->redcostbound[k] = found ? pathcost - round->gamma[k] : SCIPinfinity(scip);
+
+   /* no path means that the pricing problem is infeasible, hence no column exists */
+   if( !found || !SCIPisFeasLT(scip, pathcost, round->gamma[k]) )
+   {
+      pricerdata->solved[k] = exact;
+      return SCIP_OKAY;
+   }
+
+   nOriFlowVars = nLinks+2*nOpticalLinks*nWaveLength;
+   oriFlowVars = getColumnVals(pricerdata, k, 0);
+   for( i = 0; i < nOriFlowVars; i++ )
+      oriFlowVars[i] = 0;
+
+   /* translate the path into the x, y and z variables of the pricing problem; a path which passes a link twice or
+    * leaves the source again is not feasible for the pricing MIP
+    */
+   valid = TRUE;
+   for( i = 0; i < npathlinks; i++ )
+   {
+      if( oriFlowVars[ws->pathlinks[i]] == 1
+         || (i > 0 && pricerdata->Links[ws->pathlinks[i]].Head == pricerdata->Flows[k].Source) )
+         valid = FALSE;
+
+      oriFlowVars[ws->pathlinks[i]] = 1;
+      if( ws->pathwaves[i] >= 0 )
+      {
+         oriFlowVars[nLinks+ws->pathlinks[i]*nWaveLength+ws->pathwaves[i]] = 1;
+         oriFlowVars[nLinks+nOpticalLinks*nWaveLength+ws->pathlinks[i]*nWaveLength+ws->pathwaves[i]] = 1;
+      }
+   }
+
+   if( valid )
+   {
+      SCIPdebugMessage("shortest path for flow %d has reduced cost %g\n", k, pathcost - round->gamma[k]);
+      pricerdata->ncols[k] = 1;
+      pricerdata->solved[k] = exact;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** job of the thread pool: solves the pricing problem of one flow with the shortest path engine */
+static
+SCIP_DECL_THREADPOOLJOB(shortestPathJob)
+{
+   PRICINGROUND* round;
+   PRICINGWS* ws;
+   FLOWSTATS* stats;
+
+   round = (PRICINGROUND*)jobdata;
+   assert(round != NULL);
+
+   ws = &round->pricerdata->workspaces[thread];
+   stats = &round->pricerdata->flowstats[round->flows[job]];
+
+   SCIP_CALL( SCIPresetClock(round->scip, ws->clock) );
+   SCIP_CALL( SCIPstartClock(round->scip, ws->clock) );
+   SCIP_CALL( solvePricingShortestPath(round->scip, round->pricerdata, round, ws, round->flows[job]) );
+   SCIP_CALL( SCIPstopClock(round->scip, ws->clock) );
+
+   stats->nheurcalls++;
+   stats->heurtime += SCIPgetClockTime(round->scip, ws->clock);
+
+   return SCIP_OKAY;
+}
+
+/** job of the thread pool: solves the pricing MIP of one flow */
+static
+SCIP_DECL_THREADPOOLJOB(pricingMIPJob)
+{
+   PRICINGROUND* round;
+
+   round = (PRICINGROUND*)jobdata;
+   assert(round != NULL);
+
+   SCIP_CALL( solvePricingMIP(round->scip, round->pricerdata, round, &round->pricerdata->workspaces[thread],
+         round->flows[job]) );
+
+   return SCIP_OKAY;
+}
+
+/** compares two flows by the data which defines their pricing problem */
+static
+int compareFlowPricing(
+   OAARFlow*             flow1,              /**< first flow */
+   OAARFlow*             flow2               /**< second flow */
+   )
+{
+   if( flow1->Source != flow2->Source )
+      return flow1->Source < flow2->Source ? -1 : 1;
+   if( flow1->Destination != flow2->Destination )
+      return flow1->Destination < flow2->Destination ? -1 : 1;
+   if( flow1->BandWidth != flow2->BandWidth )
+      return flow1->BandWidth < flow2->BandWidth ? -1 : 1;
+   if( flow1->DelayPrice != flow2->DelayPrice ) /*lint !e777*/
+      return flow1->DelayPrice < flow2->DelayPrice ? -1 : 1;
+   if( flow1->JitterPrice != flow2->JitterPrice ) /*lint !e777*/
+      return flow1->JitterPrice < flow2->JitterPrice ? -1 : 1;
+   if( flow1->Priority != flow2->Priority ) /*lint !e777*/
+      return flow1->Priority < flow2->Priority ? -1 : 1;
+
+   return 0;
+}
+
+/** compares two flows by the data which defines their pricing problem and, if equal, by index */
+static
+SCIP_DECL_SORTINDCOMP(flowCompPricing)
+{  /*lint --e{715}*/
+   OAARFlow* Flows;
+   int cmp;
+
+   Flows = (OAARFlow*)dataptr;
+
+   cmp = compareFlowPricing(&Flows[ind1], &Flows[ind2]);
+   if( cmp != 0 )
+      return cmp;
+
+   return ind1 - ind2;
+}
+
+/** groups the flows into classes with the same pricing problem
+ *
+ *  The priority is part of the key: it scales the link costs but not the dual values, hence flows which differ only in
+ *  priority may have different optimal paths.
+ */
+static
+SCIP_RETCODE computeFlowClasses(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata          /**< pricer data */
+   )
+{
+   int* perm;
+   int nFlows;
+   int i;
+
+   nFlows = pricerdata->nFlows;
+
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->flowclass, nFlows) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->classrep, nFlows) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &perm, nFlows) );
+
+   for( i = 0; i < nFlows; i++ )
+      perm[i] = i;
+   if( pricerdata->aggregate )
+      SCIPsortInd(perm, flowCompPricing, (void*)pricerdata->Flows, nFlows);
+
+   /* equal flows are sorted by index, so the first flow of each class has the smallest index */
+   pricerdata->nflowclasses = 0;
+   for( i = 0; i < nFlows; i++ )
+   {
+      if( i > 0 && pricerdata->aggregate
+         && compareFlowPricing(&pricerdata->Flows[perm[i-1]], &pricerdata->Flows[perm[i]]) == 0 )
+         pricerdata->flowclass[perm[i]] = pricerdata->flowclass[perm[i-1]];
+      else
+      {
+         pricerdata->flowclass[perm[i]] = perm[i];
+         pricerdata->nflowclasses++;
+      }
+   }
+
+   SCIPfreeBufferArray(scip, &perm);
+
+   return SCIP_OKAY;
+}
+
+/** chooses the flow which is priced for each flow in the current round
+ *
+ *  Within a class, the flow with the largest gamma is priced for all flows of the class without branching decisions.
+ *  Since the reduced cost of a path differs between these flows only by gamma, a path which is not improving for that
+ *  flow is not improving for any of them. Flows with branching decisions have a restricted pricing problem and are
+ *  priced on their own.
+ */
+static
+SCIP_RETCODE chooseClassReps(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   PRICINGROUND*         round               /**< data of the current pricing round */
+   )
+{
+   int* best;
+   int k;
+   int r;
+
+   /* best flow of each class, indexed by the smallest flow index of the class */
+   SCIP_CALL( SCIPallocBufferArray(scip, &best, pricerdata->nFlows) );
+
+   for( k = 0; k < pricerdata->nFlows; k++ )
+      best[k] = -1;
+   for( k = 0; k < pricerdata->nFlows; k++ )
+   {
+      if( round->decbeg[k] < round->decbeg[k+1] )
+         continue;
+
+      r = best[pricerdata->flowclass[k]];
+      if( r < 0 || round->gamma[k] > round->gamma[r] )
+         best[pricerdata->flowclass[k]] = k;
+   }
+
+   for( k = 0; k < pricerdata->nFlows; k++ )
+   {
+      if( round->decbeg[k] < round->decbeg[k+1] )
+         pricerdata->classrep[k] = k;
+      else
+         pricerdata->classrep[k] = best[pricerdata->flowclass[k]];
+   }
+
+   SCIPfreeBufferArray(scip, &best);
+
+   return SCIP_OKAY;
+}
+
+/** copies the result of the priced flow of a class to the other flows of the class
+ *
+ *  The columns are kept if they are improving for the flow as well, and the bound on the reduced cost is shifted by the
+ *  difference of the gamma values.
+ */
+static
+void copyClassResults(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   PRICINGROUND*         round               /**< data of the current pricing round */
+   )
+{
+   int* vals;
+   int nOriFlowVars;
+   int c;
+   int k;
+   int r;
+
+   nOriFlowVars = pricerdata->nLinks + 2*pricerdata->nOpticalLinks*nWaveLength;
+
+   for( k = 0; k < pricerdata->nFlows; k++ )
+   {
+      r = pricerdata->classrep[k];
+      if( r == k )
+         continue;
+
+      pricerdata->ncols[k] = 0;
+      for( c = 0; c < pricerdata->ncols[r]; c++ )
+      {
+         vals = getColumnVals(pricerdata, r, c);
+         if( !SCIPisFeasNegative(scip, getColumnRedcost(pricerdata, k, vals, round->alpha, round->beta, round->gamma)) )
+            continue;
+
+         BMScopyMemoryArray(getColumnVals(pricerdata, k, pricerdata->ncols[k]), vals, nOriFlowVars);
+         pricerdata->ncols[k]++;
+      }
+
+      pricerdata->solved[k] = pricerdata->solved[r];
+      if( SCIPisInfinity(scip, REALABS(pricerdata->redcostbound[r])) )
+         pricerdata->redcostbound[k] = pricerdata->redcostbound[r];
+      else
+         pricerdata->redcostbound[k] = pricerdata->redcostbound[r] + round->gamma[r] - round->gamma[k];
+   }
+}
+
+/** runs a pricing job on the given flows in the given order
+ *
+ *  With partial pricing, the flows are processed in batches of one flow per thread, and the remaining flows are skipped
+ *  as soon as a batch reaches one of the limits. A round only stops early if it found a column, otherwise optimality of
+ *  the master LP would be claimed without pricing all flows.
+ */
+static
+SCIP_RETCODE priceFlows(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   PRICINGROUND*         round,              /**< data of the current pricing round */
+   SCIP_DECL_THREADPOOLJOB((*jobfunc)),      /**< job pricing a single flow */
+   SCIP_Bool             exact,              /**< does the job solve the pricing MIPs? */
+   int*                  order,              /**< flows in the order they should be priced */
+   int                   norder,             /**< number of flows in order */
+   int*                  npriced,            /**< pointer to store the number of flows which were priced */
+   int*                  nfound              /**< pointer to store the number of columns which were found */
+   )
+{
+   int batchsize;
+   int nbatch;
+   int i;
+
+   assert(pricerdata != NULL);
+   assert(round != NULL);
+   assert(npriced != NULL);
+   assert(nfound != NULL);
+
+   *npriced = 0;
+   *nfound = 0;
+
+   if( pricerdata->maxcolsround < 0 && pricerdata->maxflowsround < 0 )
+      batchsize = norder;
+   else if( exact && !pricerdata->mipparallel )
+      batchsize = 1;
+   else
+      batchsize = SCIPthreadpoolGetNThreads(pricerdata->threadpool);
+
+   while( *npriced < norder )
+   {
+      nbatch = MIN(batchsize, norder - *npriced);
+
+      /* the pricing MIPs are built here and not in the threads, since building them allocates memory of the master */
+      if( exact )
+      {
+         for( i = *npriced; i < *npriced + nbatch; i++ )
+         {
+            if( pricerdata->subscips[order[i]] == NULL )
+            {
+               SCIP_CALL( createPricingProblem(scip, pricerdata, order[i]) );
+            }
+         }
+      }
+
+      round->flows = &order[*npriced];
+      if( exact && !pricerdata->mipparallel )
+      {
+         /* without a thread-safe SCIP and LP solver the sub-SCIPs are only solved by the calling thread */
+         for( i = 0; i < nbatch; i++ )
+         {
+            SCIP_CALL( jobfunc(round, i, 0) );
+         }
+      }
+      else
+      {
+         SCIP_CALL( SCIPthreadpoolRun(pricerdata->threadpool, jobfunc, round, nbatch) );
+      }
+
+      for( i = *npriced; i < *npriced + nbatch; i++ )
+         *nfound += pricerdata->ncols[order[i]];
+      *npriced += nbatch;
+
+      if( *nfound > 0 && ((pricerdata->maxcolsround >= 0 && *nfound >= pricerdata->maxcolsround)
+            || (pricerdata->maxflowsround >= 0 && *npriced >= pricerdata->maxflowsround)) )
+         break;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** prices the flows at the dual values of the round: first heuristically, then exactly if the heuristic found nothing
+ *
+ *  The columns found are stored in pricerdata->colvals; pricerdata->solved marks the flows which were solved to
+ *  optimality.
+ */
+static
+SCIP_RETCODE priceTiers(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   PRICINGROUND*         round,              /**< data of the current pricing round */
+   int*                  order,              /**< buffer of size nFlows for the pricing order */
+   int*                  nheurcols           /**< pointer to store the number of columns found by the heuristic */
+   )
+{
+   int nFlows;
+   int norder;
+   int nmipflows;
+   int npriced;
+   int nexactcols;
+   int lastflow;
+   int i;
+   int k;
+
+   nFlows = pricerdata->nFlows;
+
+   /* of each class of equivalent flows, only one flow is priced */
+   SCIP_CALL( chooseClassReps(scip, pricerdata, round) );
+
+   /* each round starts at the flow after the last one priced in the previous round */
+   norder = 0;
+   for(i = 0; i < nFlows; i++)
+   {
+      k = (pricerdata->startflow + i) % nFlows;
+      if( pricerdata->classrep[k] == k )
+      {
+         order[norder] = k;
+         norder++;
+      }
+      else
+         pricerdata->flowstats[k].naggregated++;
+      pricerdata->ncols[k] = 0;
+      pricerdata->solved[k] = FALSE;
+      pricerdata->redcostbound[k] = -SCIPinfinity(scip);
+   }
+   pricerdata->naggregated += nFlows - norder;
+   lastflow = pricerdata->startflow == 0 ? nFlows - 1 : pricerdata->startflow - 1;
+
+   /* heuristic pricing: shortest paths over the reduced costs; it proves optimality for many flows as well */
+   *nheurcols = 0;
+   if( pricerdata->shortestpath )
+   {
+      SCIP_CALL( SCIPstartClock(scip, pricerdata->heurclock) );
+      SCIP_CALL( priceFlows(scip, pricerdata, round, shortestPathJob, FALSE, order, norder, &npriced, nheurcols) );
+      SCIP_CALL( SCIPstopClock(scip, pricerdata->heurclock) );
+
+      for(i = 0; i < npriced; i++)
+      {
+         if( pricerdata->solved[order[i]] )
+            pricerdata->nspsolves++;
+      }
+      lastflow = order[npriced-1];
+   }
+
+   /* exact pricing is only needed if the heuristic failed for all flows; the flows for which the heuristic already
+    * proved that no column exists are skipped
+    */
+   if( *nheurcols == 0 )
+   {
+      SCIP_CALL( SCIPstartClock(scip, pricerdata->exactclock) );
+
+      nmipflows = 0;
+      for(i = 0; i < norder; i++)
+      {
+         if( !pricerdata->solved[order[i]] )
+         {
+            order[nmipflows] = order[i];
+            nmipflows++;
+         }
+      }
+
+      SCIP_CALL( priceFlows(scip, pricerdata, round, pricingMIPJob, TRUE, order, nmipflows, &npriced, &nexactcols) );
+      pricerdata->nsolves += npriced;
+
+      /* the threads only store the status, it is counted here */
+      for(i = 0; i < npriced; i++)
+      {
+         switch( pricerdata->mipstatus[order[i]] )
+         {
+         case SCIP_STATUS_OPTIMAL:
+            pricerdata->nmipoptimal++;
+            break;
+         case SCIP_STATUS_INFEASIBLE:
+            pricerdata->nmipnocols++;
+            break;
+         case SCIP_STATUS_SOLLIMIT:
+            pricerdata->nmipsollimit++;
+            break;
+         case SCIP_STATUS_GAPLIMIT:
+            pricerdata->nmipgaplimit++;
+            break;
+         default:
+            pricerdata->nmipother++;
+            break;
+         }
+      }
+      if( npriced > 0 )
+         lastflow = order[npriced-1];
+
+      SCIP_CALL( SCIPstopClock(scip, pricerdata->exactclock) );
+   }
+   pricerdata->startflow = (lastflow + 1) % nFlows;
+
+   copyClassResults(scip, pricerdata, round);
+
+   return SCIP_OKAY;
+}
+
+/** returns whether a column of flow k satisfies the branching decisions of the current node */
+static
+SCIP_Bool columnSatisfiesDecisions(
+   PRICINGROUND*         round,              /**< data of the current pricing round */
+   int                   k,                  /**< index of the flow */
+   int*                  oriFlowVars         /**< value (0 or 1) of each original variable of the pricing problem */
+   )
+{
+   int d;
+
+   for( d = round->decbeg[k]; d < round->decbeg[k+1]; d++ )
+   {
+      if( oriFlowVars[round->decindex[d]] != (round->dectype[d] == ONE ? 1 : 0) )
+         return FALSE;
+   }
+
+   return TRUE;
+}
+
+/** adds the columns of the pool whose master variable was deleted, if they have negative reduced cost at the given
+ *  dual values and respect the branching decisions of the current node; columns which are still variables of the
+ *  master are priced by SCIP itself
+ */
+static
+SCIP_RETCODE addPoolColumns(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   PRICINGROUND*         round,              /**< data of the current pricing round */
+   double*               alpha,              /**< dual values of the capacity constraints (Cons2) */
+   double*               beta,               /**< dual values of the wavelength constraints (Cons3) */
+   double*               gamma,              /**< dual values of the flow constraints (Cons1) */
+   int*                  nadded              /**< pointer to store the number of added columns */
+   )
+{
+   int* oriFlowVars;
+   int* cols;
+   int ncols;
+   SCIP_Bool added;
+   int c;
+   int k;
+
+   assert(pricerdata != NULL);
+   assert(nadded != NULL);
+
+   *nadded = 0;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &oriFlowVars, pricerdata->nLinks + 2*pricerdata->nOpticalLinks*nWaveLength) );
+
+   for( k = 0; k < pricerdata->nFlows; k++ )
+   {
+      cols = SCIPcolpoolGetFlowCols(pricerdata->colpool, k);
+      ncols = SCIPcolpoolGetNFlowCols(pricerdata->colpool, k);
+
+      for( c = 0; c < ncols; c++ )
+      {
+         if( SCIPcolpoolGetVar(pricerdata->colpool, cols[c]) != NULL )
+            continue;
+
+         SCIPcolpoolGetVals(pricerdata->colpool, cols[c], oriFlowVars);
+
+         if( !columnSatisfiesDecisions(round, k, oriFlowVars)
+            || !SCIPisFeasNegative(scip, getColumnRedcost(pricerdata, k, oriFlowVars, alpha, beta, gamma)) )
+            continue;
+
+         SCIP_CALL( addPathColumn(scip, pricerdata, k, oriFlowVars, &added) );
+         if( added )
+            (*nadded)++;
+      }
+   }
+
+   SCIPfreeBufferArray(scip, &oriFlowVars);
+
+   return SCIP_OKAY;
+}
+
+/**@} */
+
+/**name Callback methods
+ *
+ * @{
+ */
+
+/** destructor of variable pricer to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_PRICERFREE(pricerFreeOAAR)
+{
+   SCIP_PRICERDATA* pricerdata;
+
+   assert(scip != NULL);
+   assert(pricer != NULL);
+
+   pricerdata = SCIPpricerGetData(pricer);
+
+   if( pricerdata != NULL)
+   {
+      /* free memory */
+      SCIPfreeMemoryArrayNull(scip, &pricerdata->conss);
+
+      SCIP_CALL( SCIPfreeClock(scip, &pricerdata->insertclock) );
+      SCIP_CALL( SCIPfreeClock(scip, &pricerdata->exactclock) );
+      SCIP_CALL( SCIPfreeClock(scip, &pricerdata->heurclock) );
+      SCIP_CALL( SCIPfreeClock(scip, &pricerdata->buildclock) );
+
+      SCIPfreeMemory(scip, &pricerdata);
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/** initialization method of variable pricer (called after problem was transformed) */
+static
+SCIP_DECL_PRICERINIT(pricerInitOAAR)
+{  /*lint --e{715}*/
+   SCIP_PRICERDATA* pricerdata;
+   SCIP_CONS* cons;
+   int c;
+
+   assert(scip != NULL);
+   assert(pricer != NULL);
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+   /* get transformed constraints */
+   for( c = 0; c < pricerdata->nCons; ++c )
+   {
+      cons = pricerdata->conss[c];
+
+      /* release original constraint */
+      SCIP_CALL( SCIPreleaseCons(scip, &pricerdata->conss[c]) );
+
+      /* get transformed constraint */
+      SCIP_CALL( SCIPgetTransformedCons(scip, cons, &pricerdata->conss[c]) );
+
+      /* capture transformed constraint */
+      SCIP_CALL( SCIPcaptureCons(scip, pricerdata->conss[c]) );
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process initialization method of variable pricer (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_PRICERINITSOL(pricerInitsolOAAR)
+{
+   SCIP_PRICERDATA* pricerdata;
+   PRICINGWS* ws;
+   int k;
+   int t;
+
+   assert(scip != NULL);
+   assert(pricer != NULL);
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->subscips, pricerdata->nFlows) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->subvars, pricerdata->nFlows) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->fixedvars, pricerdata->nFlows) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->nfixedvars, pricerdata->nFlows) );
+
+   /* the pricing problems are built when they are needed the first time and only updated in later pricing rounds */
+   for( k = 0; k < pricerdata->nFlows; ++k )
+      pricerdata->subscips[k] = NULL;
+
+   if( pricerdata->shortestpath )
+   {
+      SCIP_CALL( SCIPlayeredgraphCreate(scip, &pricerdata->graph, pricerdata->Links,
+            SCIPprobdataGetAdjacency(SCIPgetProbData(scip)), pricerdata->nNodes,
+            pricerdata->nOpticalNodes, pricerdata->nLinks, pricerdata->nOpticalLinks) );
+   }
+
+   SCIP_CALL( computeFlowClasses(scip, pricerdata) );
+
+   SCIP_CALL( SCIPcolpoolCreate(scip, &pricerdata->colpool, pricerdata->nFlows,
+         pricerdata->nLinks + 2*pricerdata->nOpticalLinks*nWaveLength) );
+
+   /* stability center of the dual smoothing */
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->centeralpha, pricerdata->nLinks - pricerdata->nOpticalLinks) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->centerbeta, pricerdata->nOpticalLinks*nWaveLength) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->centergamma, pricerdata->nFlows) );
+   pricerdata->centerbound = -SCIPinfinity(scip);
+   pricerdata->hascenter = FALSE;
+   pricerdata->centernode = -1;
+   pricerdata->cursmoothing = pricerdata->smoothing;
+
+   /* columns of a round are collected per flow and added to the master after all threads are finished */
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->colvals,
+         pricerdata->nFlows * MAXPRICINGCOLS * (pricerdata->nLinks + 2*pricerdata->nOpticalLinks*nWaveLength)) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->ncols, pricerdata->nFlows) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->solved, pricerdata->nFlows) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->redcostbound, pricerdata->nFlows) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->mipstatus, pricerdata->nFlows) );
+
+   /* pricing statistics, printed by the OAAR statistics table */
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->flowstats, pricerdata->nFlows) );
+   pricerdata->roundredcost = NULL;
+   pricerdata->nrounds = 0;
+   pricerdata->roundssize = 0;
+   SCIP_CALL( SCIPresetClock(scip, pricerdata->insertclock) );
+
+   /* convergence trace: one row per call of the reduced cost pricing */
+   pricerdata->ncalls = 0;
+   if( pricerdata->tracefilename[0] != '\0' )
+   {
+      pricerdata->tracefile = fopen(pricerdata->tracefilename, "w");
+      if( pricerdata->tracefile == NULL )
+      {
+         SCIPerrorMessage("cannot create trace file <%s>\n", pricerdata->tracefilename);
+         return SCIP_FILECREATEERROR;
+      }
+      SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->tracebuffer, TRACEBUFSIZE) );
+      (void) setvbuf(pricerdata->tracefile, pricerdata->tracebuffer, _IOFBF, TRACEBUFSIZE);
+      fprintf(pricerdata->tracefile, "call,node,depth,time,lpobj,lagrangebound,dualbound,colsadded\n");
+   }
+
+   /* solving several sub-SCIPs at the same time needs a thread-safe SCIP and LP solver, see THREADSAFE in the
+    * Makefile; the shortest path jobs only use the master data and run in parallel in any case
+    */
+#ifdef OAAR_THREADSAFE
+   pricerdata->mipparallel = TRUE;
+#else
+   pricerdata->mipparallel = FALSE;
+   if( pricerdata->nthreads > 1 )
+   {
+      SCIPwarningMessage(scip, "OAAR was built without THREADSAFE=true, the pricing MIPs are solved by one thread\n");
+   }
+#endif
+
+   /* each thread gets its own working memory */
+   SCIP_CALL( SCIPthreadpoolCreate(scip, &pricerdata->threadpool, pricerdata->nthreads) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->workspaces, pricerdata->nthreads) );
+   for( t = 0; t < pricerdata->nthreads; ++t )
+   {
+      ws = &pricerdata->workspaces[t];
+      ws->graphws = NULL;
+      if( pricerdata->graph != NULL )
+      {
+         SCIP_CALL( SCIPlayeredgraphCreateWs(scip, pricerdata->graph, &ws->graphws) );
+      }
+      SCIP_CALL( SCIPallocMemoryArray(scip, &ws->linkcost, pricerdata->nLinks) );
+      SCIP_CALL( SCIPallocMemoryArray(scip, &ws->wavecost, pricerdata->nOpticalLinks*nWaveLength+1) );
+      SCIP_CALL( SCIPallocMemoryArray(scip, &ws->pathlinks, pricerdata->nNodes*(nWaveLength+1)) );
+      SCIP_CALL( SCIPallocMemoryArray(scip, &ws->pathwaves, pricerdata->nNodes*(nWaveLength+1)) );
+      SCIP_CALL( SCIPcreateWallClock(scip, &ws->clock) );
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process deinitialization method of variable pricer (called before branch and bound process data is freed) */
+static
+SCIP_DECL_PRICEREXITSOL(pricerExitsolOAAR)
+{
+   SCIP_PRICERDATA* pricerdata;
+   PRICINGWS* ws;
+   int c;
+   int k;
+   int t;
+
+   assert(scip != NULL);
+   assert(pricer != NULL);
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+#if SCIP_VERSION < 500
+   /* without statistics tables, the pricing statistics are printed at the end of the solve */
+   if( SCIPgetVerbLevel(scip) >= SCIP_VERBLEVEL_HIGH )
+   {
+      SCIP_CALL( SCIPpricerOAARPrintStatistics(scip, NULL) );
+   }
+#endif
+
+   /* free pricing problems */
+   if( pricerdata->subscips != NULL )
+   {
+      for( k = 0; k < pricerdata->nFlows; ++k )
+      {
+         SCIP_CALL( freePricingProblem(scip, pricerdata, k) );
+      }
+      SCIPfreeMemoryArray(scip, &pricerdata->nfixedvars);
+      SCIPfreeMemoryArray(scip, &pricerdata->fixedvars);
+      SCIPfreeMemoryArray(scip, &pricerdata->subvars);
+      SCIPfreeMemoryArray(scip, &pricerdata->subscips);
+      pricerdata->subscips = NULL;
+   }
+
+   /* stop the threads and free their working memory; the parameter may have been changed since the pool was built */
+   if( pricerdata->workspaces != NULL )
+   {
+      assert(pricerdata->threadpool != NULL);
+      for( t = 0; t < SCIPthreadpoolGetNThreads(pricerdata->threadpool); ++t )
+      {
+         ws = &pricerdata->workspaces[t];
+         SCIP_CALL( SCIPfreeClock(scip, &ws->clock) );
+         SCIPfreeMemoryArray(scip, &ws->pathwaves);
+         SCIPfreeMemoryArray(scip, &ws->pathlinks);
+         SCIPfreeMemoryArray(scip, &ws->wavecost);
+         SCIPfreeMemoryArray(scip, &ws->linkcost);
+         SCIPlayeredgraphFreeWs(scip, &ws->graphws);
+      }
+      SCIPfreeMemoryArray(scip, &pricerdata->workspaces);
+   }
+   SCIPthreadpoolFree(scip, &pricerdata->threadpool);
+   SCIP_CALL( SCIPcolpoolFree(scip, &pricerdata->colpool) );
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->classrep);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->flowclass);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->centergamma);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->centerbeta);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->centeralpha);
+   if( pricerdata->tracefile != NULL )
+   {
+      (void) fclose(pricerdata->tracefile);
+      pricerdata->tracefile = NULL;
+   }
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->tracebuffer);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->roundredcost);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->flowstats);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->mipstatus);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->redcostbound);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->solved);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->ncols);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->colvals);
+
+   if( pricerdata->graph != NULL )
+      SCIPlayeredgraphFree(scip, &pricerdata->graph);
+
+   /* get release constraints */
+   for( c = 0; c < pricerdata->nCons; ++c )
+   {
+      /* release constraint */
+      SCIP_CALL( SCIPreleaseCons(scip, &(pricerdata->conss[c])) );
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/** reduced cost pricing method of variable pricer for feasible LPs */
+static
+SCIP_DECL_PRICERREDCOST(pricerRedcostOAAR)
+{  /*lint --e{715}*/
+   SCIP_PRICERDATA* pricerdata;
+   SCIP_CONS** conss;
+   SCIP_CONS* cons;
+   PRICINGROUND round;
+   int* order;
+   int nheurcols;
+   int nnewcols;
+   int ncols;
+   int nmisprices;
+   SCIP_Real smoothing;
+   SCIP_Real lpobjval;
+   SCIP_Real lagrangebound;
+   SCIP_Real bestredcost;
+   SCIP_Bool added;
+   int nadded;
+   int npoolcols;
+   int c;
+   int i,j;
+
+   int nLinks, nFlows;
+   int nOpticalLinks;
+   int nElecLinks;
+
+   double* alpha;
+   double* beta;
+   double* gamma;
+   double* salpha;
+   double* sbeta;
+   double* sgamma;
+
+   int k; //current index of subproblem
+
+   assert(scip != NULL);
+   assert(pricer != NULL);
+
+   (*result) = SCIP_DIDNOTRUN;
+
+   /* get the pricer data */
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+   pricerdata->ncalls++;
+   lagrangebound = -SCIPinfinity(scip);
+   nadded = 0;
+
+   conss = pricerdata->conss;
+   nLinks = pricerdata->nLinks;
+   nOpticalLinks = pricerdata->nOpticalLinks;
+   nFlows = pricerdata->nFlows;
+   nElecLinks = nLinks - nOpticalLinks;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &alpha, nElecLinks) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &beta, nOpticalLinks*nWaveLength) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &gamma, nFlows) );
+
+   //get dual values
+   //gamma for FlowCons1
+   for(i = 0; i < nFlows; i++)
+   {
+      cons = conss[i];
+
+      //TODO: check constraint handler
+
+      gamma[i] = SCIPgetDualsolSetppc(scip, cons);
+   }
+   //alpha for ElecCons2
+   for(i = 0; i < nElecLinks; i++)
+   {
+      cons = conss[i+nFlows];
+      alpha[i] = SCIPgetDualsolKnapsack(scip, cons);
+   }
+   //beta for OpticalCons3
+   for(i = 0; i < nOpticalLinks; i++)
+   {
+      for(j = 0; j < nWaveLength; j++)
+      {
+         cons = conss[i*nWaveLength+j+nFlows+nElecLinks];
+         beta[i*nWaveLength+j] = SCIPgetDualsolSetppc(scip, cons);
+      }
+   }
+
+   SCIPdebugMessage("Print dual values:\n");
    for(i = 0; i < nFlows; i++)
       SCIPdebugPrintf("gamma[%d]:%lf ", i, gamma[i]);
    SCIPdebugPrintf("\n");
@@ -696,229 +2304,208 @@ SCIP_DECL_PRICERREDCOST(pricerRedcostOAAR)
 
 
 
-   for(k = 0; k < nFlows; k++)
-   {
-
-      /* get the remaining time and memory limit */
-      SCIP_CALL( SCIPgetRealParam(scip, "limits/time", &timelimit) );
-      if( !SCIPisInfinity(scip, timelimit) )
-	 timelimit -= SCIPgetSolvingTime(scip);
-      SCIP_CALL( SCIPgetRealParam(scip, "limits/memory", &memorylimit) );
-      if( !SCIPisInfinity(scip, memorylimit) )
-	 memorylimit -= SCIPgetMemUsed(scip)/1048576.0;
-
-      /* initialize SCIP */
-      SCIP_CALL( SCIPcreate(&subscip) );
-      SCIP_CALL( SCIPincludeDefaultPlugins(subscip) );
-
-      /* create problem in sub SCIP */
-      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "pricing_%d", k);
-      SCIP_CALL( SCIPcreateProbBasic(subscip, name) );
-      SCIP_CALL( SCIPsetObjsense(subscip, SCIP_OBJSENSE_MAXIMIZE) );
-
-      /* do not abort subproblem on CTRL-C */
-      SCIP_CALL( SCIPsetBoolParam(subscip, "misc/catchctrlc", FALSE) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &salpha, nElecLinks) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &sbeta, nOpticalLinks*nWaveLength) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &sgamma, nFlows) );
 
-      /* disable output to console */
-      SCIP_CALL( SCIPsetIntParam(subscip, "display/verblevel", 0) );
+   round.scip = scip;
+   round.pricerdata = pricerdata;
+   round.alpha = salpha;
+   round.beta = sbeta;
+   round.gamma = sgamma;
+   SCIP_CALL( collectBranchingDecisions(scip, pricerdata, &round) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &order, nFlows) );
 
-      /* set time and memory limit */
-      SCIP_CALL( SCIPsetRealParam(subscip, "limits/time", timelimit) );
-      SCIP_CALL( SCIPsetRealParam(subscip, "limits/memory", memorylimit) );
+   /* get the remaining time and memory limit; the memory is shared by the MIPs which run at the same time, which are
+    * the MIPs of all threads only if they are solved in parallel
+    */
+   SCIP_CALL( SCIPgetRealParam(scip, "limits/time", &round.timelimit) );
+   if( !SCIPisInfinity(scip, round.timelimit) )
+      round.timelimit -= SCIPgetSolvingTime(scip);
+   SCIP_CALL( SCIPgetRealParam(scip, "limits/memory", &round.memorylimit) );
+   if( !SCIPisInfinity(scip, round.memorylimit) )
+   {
+      round.memorylimit -= SCIPgetMemUsed(scip)/1048576.0;
+      if( pricerdata->mipparallel )
+         round.memorylimit /= SCIPthreadpoolGetNThreads(pricerdata->threadpool);
+   }
 
-      //nx(nLinks) + ny(nOpticalLinks*nWavelength) + nz(nOpticalLinks*nWavelength)
-      SCIP_CALL( SCIPallocMemoryArray(subscip, &vars, nLinks + 2*nOpticalLinks*nWaveLength) );
+   /* columns from the pool are cheaper than solving any pricing problem */
+   SCIP_CALL( addPoolColumns(scip, pricerdata, &round, alpha, beta, gamma, &npoolcols) );
+   if( npoolcols > 0 )
+   {
+      SCIPdebugMessage("restored %d columns from the pool\n", npoolcols);
+      pricerdata->npoolcols += npoolcols;
+      nadded = npoolcols;
+      (*result) = SCIP_SUCCESS;
+      goto TERMINATE;
+   }
 
-      /* initialization local pricing problem */
-      SCIP_CALL( initPricing(scip, pricerdata, subscip, vars, k, alpha, beta, gamma) );
+   /* the stability center is only kept within a node */
+   if( pricerdata->centernode != SCIPnodeGetNumber(SCIPgetCurrentNode(scip)) )
+   {
+      pricerdata->hascenter = FALSE;
+      pricerdata->centerbound = -SCIPinfinity(scip);
+      pricerdata->centernode = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+   }
+   if( !pricerdata->smoothingauto )
+      pricerdata->cursmoothing = pricerdata->smoothing;
+   smoothing = pricerdata->hascenter ? pricerdata->cursmoothing : 0.0;
 
-      SCIPdebugMessage("solve pricer problem %d\n", k);
+   /* Wentges smoothing: price at a convex combination of the stability center and the LP duals. If no column has
+    * negative reduced cost w.r.t. the LP duals (a misprice), the smoothing factor is decreased until it reaches zero,
+    * where pricing is exact again.
+    */
+   nmisprices = 0;
+   do
+   {
+      for(i = 0; i < nElecLinks; i++)
+         salpha[i] = smoothing * pricerdata->centeralpha[i] + (1.0 - smoothing) * alpha[i];
+      for(i = 0; i < nOpticalLinks*nWaveLength; i++)
+         sbeta[i] = smoothing * pricerdata->centerbeta[i] + (1.0 - smoothing) * beta[i];
+      for(i = 0; i < nFlows; i++)
+         sgamma[i] = smoothing * pricerdata->centergamma[i] + (1.0 - smoothing) * gamma[i];
+
+      SCIP_CALL( priceTiers(scip, pricerdata, &round, order, &nheurcols) );
+
+      /* keep only the columns with negative reduced cost w.r.t. the LP duals */
+      nnewcols = 0;
+      for(k = 0; k < nFlows; k++)
+      {
+         pricerdata->flowstats[k].nfound += pricerdata->ncols[k];
 
-      /* solve sub SCIP */
-      SCIP_CALL( SCIPsolve(subscip) );
+         if( smoothing > 0.0 )
+         {
+            ncols = 0;
+            for( c = 0; c < pricerdata->ncols[k]; c++ )
+            {
+               if( !SCIPisFeasNegative(scip, getColumnRedcost(pricerdata, k, getColumnVals(pricerdata, k, c),
+                        alpha, beta, gamma)) )
+                  continue;
 
-      sols = SCIPgetSols(subscip);
-      nsols = SCIPgetNSols(subscip);
-      addvar = FALSE;
+               if( ncols < c )
+               {
+                  BMScopyMemoryArray(getColumnVals(pricerdata, k, ncols), getColumnVals(pricerdata, k, c),
+                     nLinks + 2*nOpticalLinks*nWaveLength);
+               }
+               ncols++;
+            }
+            pricerdata->ncols[k] = ncols;
+         }
+         nnewcols += pricerdata->ncols[k];
+      }
 
-      if(nsols > 3) 
-         nAddedColumn = 3;
+      if( nnewcols == 0 && smoothing > 0.0 )
+      {
+         nmisprices++;
+         pricerdata->nmisprices++;
+         smoothing = MAX(0.0, 1.0 - (nmisprices + 1) * (1.0 - pricerdata->cursmoothing));
+         if( SCIPisZero(scip, smoothing) )
+            smoothing = 0.0;
+      }
       else
-         nAddedColumn = nsols;
+         break;
+   }
+   while( TRUE ); /*lint !e506*/
 
-      /* loop over all solutions and create the corresponding column to master if the reduced cost are negative for master,
-       * that is the objective value i greater than gamma_k
+   /* Lagrangian bound at the dual values of the last pricing problems, smoothed or not; it is only known if every flow
+    * was priced with a bound on its reduced cost
+    */
+   lpobjval = SCIPgetLPObjval(scip);
+   lagrangebound = computeLagrangeBound(scip, pricerdata, salpha, sbeta, sgamma);
+   if( !SCIPisInfinity(scip, -lagrangebound) )
+   {
+      SCIPdebugMessage("Lagrangian bound %g at smoothing factor %g, LP value %g\n", lagrangebound, smoothing, lpobjval);
+      *lowerbound = lagrangebound;
+      pricerdata->nlagrangebounds++;
+
+      /* stop if the node will be pruned anyway, if the rounded bound of an integral objective cannot improve, or if
+       * the gap between LP value and Lagrangian bound is small enough
        */
-      for( s = 0; s < nAddedColumn; ++s )
+      if( nnewcols > 0 && (SCIPisGE(scip, lagrangebound, SCIPgetCutoffbound(scip))
+            || (SCIPisObjIntegral(scip) && SCIPisGE(scip, SCIPfeasCeil(scip, lagrangebound), SCIPfeasCeil(scip, lpobjval)))
+            || (pricerdata->lagrangegap > 0.0 && SCIPrelDiff(lpobjval, lagrangebound) <= pricerdata->lagrangegap)) )
       {
-	 SCIP_Bool feasible;
-	 SCIP_SOL* sol;
-
-	 /* the soultion should be sorted w.r.t. the objective function value */
-	 assert(s == 0 || SCIPisFeasGE(subscip, SCIPgetSolOrigObj(subscip, sols[s-1]), SCIPgetSolOrigObj(subscip, sols[s])));
+         *stopearly = TRUE;
+         pricerdata->nearlystops++;
+      }
+   }
 
-	 sol = sols[s];
-	 assert(sol != NULL);
+   /* the first dual values of a node become the stability center; afterwards, the center only moves to dual values at
+    * which the Lagrangian bound improves the best bound of the center
+    */
+   if( !pricerdata->hascenter || SCIPisGT(scip, lagrangebound, pricerdata->centerbound) )
+   {
+      BMScopyMemoryArray(pricerdata->centeralpha, salpha, nElecLinks);
+      BMScopyMemoryArray(pricerdata->centerbeta, sbeta, nOpticalLinks*nWaveLength);
+      BMScopyMemoryArray(pricerdata->centergamma, sgamma, nFlows);
+      pricerdata->centerbound = lagrangebound;
+      pricerdata->hascenter = TRUE;
+   }
 
-	 /* check if solution is feasible in original sub SCIP */
-	 SCIP_CALL( SCIPcheckSolOrig(subscip, sol, &feasible, FALSE, FALSE ) );
+   /* automatic smoothing: smooth more after successful rounds and less after misprices */
+   if( pricerdata->smoothingauto )
+   {
+      if( nmisprices > 0 )
+         pricerdata->cursmoothing -= 0.1;
+      else
+         pricerdata->cursmoothing += 0.1;
+      pricerdata->cursmoothing = MAX(0.0, MIN(0.9, pricerdata->cursmoothing));
+      if( SCIPisZero(scip, pricerdata->cursmoothing) )
+         pricerdata->cursmoothing = 0.0;
+   }
 
-	 if( !feasible )
-	 {
-	    SCIPwarningMessage(scip, "solution in pricing problem %d is infeasible\n", k);
-	    continue;
-	 }
+   /* add the columns in the order of the flows, which does not depend on the thread that found them */
+   SCIP_CALL( SCIPstartClock(scip, pricerdata->insertclock) );
+   bestredcost = 0.0;
+   for(k = 0; k < nFlows; k++)
+   {
+      for( c = 0; c < pricerdata->ncols[k]; c++ )
+      {
+         bestredcost = MIN(bestredcost, getColumnRedcost(pricerdata, k, getColumnVals(pricerdata, k, c), alpha, beta, gamma));
 
-	 /* check if the solution has a value greater than gamma_k */
-	 if( SCIPisFeasGT(subscip, SCIPgetSolOrigObj(subscip, sol), -gamma[k]) )
-	 {
-	    SCIP_VAR* var;
-	    SCIP_VARDATA* vardata;
-	    int* consids;
-	    int nconsids;
-	    char strtmp[SCIP_MAXSTRLEN];
-	    char tempName[SCIP_MAXSTRLEN];
-	    int nconss;
-
-	    OAARNode tempNode;
-	    OAARLink tempLink;
-	    OAARFlow tempFlow;
-	    double tempJitter;
-	    double tempDelay;
-	    double tempBandCost;
-	    double tempObj;
-
-	    int* oriFlowVars;
-	    int nOriFlowVars;
-
-	    SCIPdebug( SCIP_CALL( SCIPprintSol(subscip, sol, NULL, FALSE) ) );
-
-	    nconss = 0;
-
-	    //1(cons1) + nElecLinks(cons2) + nOpticalLinks*nWaveLength(cons3)
-	    SCIP_CALL( SCIPallocBufferArray(scip, &consids, 1+nElecLinks+nOpticalLinks*nWaveLength) );
-
-	    //construct consids
-	    consids[0] = k; nconss++;
-	    for(i = 0; i < nElecLinks; i++)
-	    {
-	       if( SCIPgetSolVal(subscip, sol, vars[nOpticalLinks+i]) > 0.5)
-	       {
-	          consids[nconss] = nFlows + i;
-		  nconss++;
-	       }
-	       else
-	       {
-	          assert( SCIPisFeasEQ(subscip, SCIPgetSolVal(subscip, sol, 
-		     vars[nOpticalLinks+i]), 0.0) );
-	       }
-	    }
-	    for(i = 0; i < nOpticalLinks; i++)
-	    {
-	       for(j = 0; j < nWaveLength; j++)
-	       {
-	          if( SCIPgetSolVal(subscip, sol, vars[nLinks+i*nWaveLength+j]) > 0.5 )
-		  {
-		     consids[nconss] = nFlows + nElecLinks + i*nWaveLength + j;
-		     nconss++;
-		  }
-		  else
-		  {
-		     assert( SCIPisFeasEQ(subscip, SCIPgetSolVal(subscip, sol, 
-		        vars[nLinks+i*nWaveLength+j]), 0.0) );
-		  }
-	       }
-	    }
-
-            nOriFlowVars = nLinks+2*nOpticalLinks*nWaveLength;
-	    SCIP_CALL( SCIPallocBufferArray(scip, &oriFlowVars, nOriFlowVars) );
-	    for(i = 0; i < nOriFlowVars; i++)
-	    {
-	       if( SCIPgetSolVal(subscip, sol, vars[i]) > 0.5  )
-	       {
-	          oriFlowVars[i] = 1;
-	       }
-	       else
-	       {
-	          oriFlowVars[i] = 0;
-	       }
-	    }
-
-	    SCIP_CALL( SCIPvardataCreateOAAR(scip, &vardata, consids, nconss, oriFlowVars, 
-	       nOriFlowVars) );
-
-	    (void) SCIPsnprintf(tempName, SCIP_MAXSTRLEN, "lambda_%d_%d", k, nFlowSol[k]);
-
-	    /* create variable for a new column */
-	    tempFlow = Flows[k];
-	    tempDelay = 0; tempJitter = 0; tempBandCost = 0;
-	    for(i = 0; i < nLinks; i++)
-	    {
-	       if( SCIPgetSolVal(subscip, sol, vars[i]) > 0.5 )
-	       {
-	          tempNode = Nodes[Links[i].Head];
-	          tempLink = Links[i];
-		  tempDelay += tempNode.ProcDelay + tempNode.QueueDelay + 
-		     tempLink.PropDelay + tempLink.TransDelay;
-		  tempJitter += tempNode.Jitter;
-		  tempBandCost += tempLink.BandCost;
-		  SCIPdebugMessage("Include link %d\n", i);
-	       }
-	    }
-	    tempObj = tempFlow.Priority * (tempFlow.DelayPrice * tempDelay + 
-	       tempFlow.JitterPrice * tempJitter + tempFlow.BandWidth * tempBandCost);
-	    SCIP_CALL( SCIPcreateVarOAAR(scip, &var, tempName, tempObj, FALSE, TRUE, vardata) );
-	    SCIPdebugMessage("Add variable %s with obj %lf\n", tempName, tempObj);
-	    SCIPdebugMessage("tempDelay:%lf, tempJitter:%lf, tempBandCost:%lf\n",
-	       tempDelay, tempJitter, tempBandCost);
-
-	    /* add the new variable to the pricer store */
-	    SCIP_CALL( SCIPaddPricedVar(scip, var, 1.0) );
-	    addvar = TRUE;
-
-	    SCIP_CALL( SCIPchgVarUbLazy(scip, var, 1.0) );
-
-	    for( i = 0; i < nconss; i++ )
-	    {
-	       //assert(SCIPconsIsEnabled(conss[consids[i]]));
-	       if(i == 0)
-	       {
-	          SCIP_CALL( SCIPaddCoefSetppc(scip, conss[consids[i]], var) );
-	       }
-	       else if( consids[i] < nFlows + nElecLinks )
-	       {
-	          SCIP_CALL( SCIPaddCoefKnapsack(scip, conss[consids[i]], var, tempFlow.BandWidth) );
-	       }
-	       else
-	       {
-	          SCIP_CALL( SCIPaddCoefSetppc(scip, conss[consids[i]], var) );
-	       }
-	    }
-
-	    SCIPdebug(SCIPprintVar(scip, var, NULL) );
-	    SCIP_CALL( SCIPreleaseVar(scip, &var) );
-
-	    SCIPfreeBufferArray(scip, &consids);
-	    SCIPfreeBufferArray(scip, &oriFlowVars);
-	 }
-	 else
-	 {
-	    SCIPdebugMessage("No variable newly generated for flow %d\n", k);
-	    break;
-	 }
+         SCIP_CALL( addPathColumn(scip, pricerdata, k, getColumnVals(pricerdata, k, c), &added) );
+         if( added )
+         {
+            pricerdata->flowstats[k].naccepted++;
+            nadded++;
+         }
       }
 
-      /* free pricer MIP */
-      SCIPfreeMemoryArray(subscip, &vars);
-      
-      if( addvar || SCIPgetStatus(subscip) == SCIP_STATUS_OPTIMAL )
-	 (*result) = SCIP_SUCCESS;
+      if( pricerdata->ncols[k] > 0 || pricerdata->solved[k] )
+         (*result) = SCIP_SUCCESS;
+   }
+   SCIP_CALL( SCIPstopClock(scip, pricerdata->insertclock) );
 
-      /* free sub SCIP */
-      SCIP_CALL( SCIPfree(&subscip) );
+   if( pricerdata->nrounds == pricerdata->roundssize )
+   {
+      pricerdata->roundssize = MAX(2 * pricerdata->roundssize, 64);
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &pricerdata->roundredcost, pricerdata->roundssize) );
+   }
+   pricerdata->roundredcost[pricerdata->nrounds] = bestredcost;
+   pricerdata->nrounds++;
 
+   if( nheurcols > 0 )
+   {
+      pricerdata->nheurrounds++;
+      pricerdata->nheurcols += nnewcols;
+   }
+   else
+   {
+      pricerdata->nexactrounds++;
+      pricerdata->nexactcols += nnewcols;
    }
 
+TERMINATE:
+   writeTraceRow(scip, pricerdata, lagrangebound, nadded);
+
+   SCIPfreeBufferArray(scip, &order);
+   SCIPfreeBufferArray(scip, &round.dectype);
+   SCIPfreeBufferArray(scip, &round.decindex);
+   SCIPfreeBufferArray(scip, &round.decbeg);
+   SCIPfreeBufferArray(scip, &sgamma);
+   SCIPfreeBufferArray(scip, &sbeta);
+   SCIPfreeBufferArray(scip, &salpha);
    SCIPfreeBufferArray(scip, &alpha);
    SCIPfreeBufferArray(scip, &beta);
    SCIPfreeBufferArray(scip, &gamma);
@@ -974,6 +2561,7 @@ SCIP_RETCODE SCIPincludePricerOAAR(
    pricerdata->conss = NULL;
    pricerdata->Nodes = NULL;
    pricerdata->Links = NULL;
+   pricerdata->Topology = NULL;
    pricerdata->Flows = NULL;
    pricerdata->nNodes = 0;
    pricerdata->nOpticalNodes = 0;
@@ -982,6 +2570,64 @@ SCIP_RETCODE SCIPincludePricerOAAR(
    pricerdata->nFlows = 0;
    pricerdata->nCons = 0;
    //pricerdata->nFlowSol = NULL;
+   pricerdata->subscips = NULL;
+   pricerdata->subvars = NULL;
+   pricerdata->fixedvars = NULL;
+   pricerdata->nfixedvars = NULL;
+   pricerdata->nbuilds = 0;
+   pricerdata->nsolves = 0;
+   pricerdata->graph = NULL;
+   pricerdata->nspsolves = 0;
+   pricerdata->nheurrounds = 0;
+   pricerdata->startflow = 0;
+   pricerdata->cursmoothing = DEFAULT_SMOOTHING;
+   pricerdata->centeralpha = NULL;
+   pricerdata->centerbeta = NULL;
+   pricerdata->centergamma = NULL;
+   pricerdata->centerbound = -SCIPinfinity(scip);
+   pricerdata->hascenter = FALSE;
+   pricerdata->centernode = -1;
+   pricerdata->nmisprices = 0;
+   pricerdata->redcostbound = NULL;
+   pricerdata->nlagrangebounds = 0;
+   pricerdata->nearlystops = 0;
+   pricerdata->mipparallel = FALSE;
+   pricerdata->probeflow = -1;
+   pricerdata->probeindex = -1;
+   pricerdata->probetype = ZERO;
+   pricerdata->colpool = NULL;
+   pricerdata->npoolcols = 0;
+   pricerdata->nduplicates = 0;
+   pricerdata->flowclass = NULL;
+   pricerdata->nflowclasses = 0;
+   pricerdata->classrep = NULL;
+   pricerdata->naggregated = 0;
+   pricerdata->mipstatus = NULL;
+   pricerdata->nmipoptimal = 0;
+   pricerdata->nmipnocols = 0;
+   pricerdata->nmipsollimit = 0;
+   pricerdata->nmipgaplimit = 0;
+   pricerdata->nmipother = 0;
+   pricerdata->flowstats = NULL;
+   pricerdata->roundredcost = NULL;
+   pricerdata->nrounds = 0;
+   pricerdata->roundssize = 0;
+   pricerdata->tracefile = NULL;
+   pricerdata->tracebuffer = NULL;
+   pricerdata->ncalls = 0;
+   pricerdata->nexactrounds = 0;
+   pricerdata->nheurcols = 0;
+   pricerdata->nexactcols = 0;
+   pricerdata->threadpool = NULL;
+   pricerdata->workspaces = NULL;
+   pricerdata->colvals = NULL;
+   pricerdata->ncols = NULL;
+   pricerdata->solved = NULL;
+
+   SCIP_CALL( SCIPcreateClock(scip, &pricerdata->buildclock) );
+   SCIP_CALL( SCIPcreateClock(scip, &pricerdata->heurclock) );
+   SCIP_CALL( SCIPcreateClock(scip, &pricerdata->exactclock) );
+   SCIP_CALL( SCIPcreateClock(scip, &pricerdata->insertclock) );
 
    /* include variable pricer */
    SCIP_CALL( SCIPincludePricerBasic(scip, &pricer, PRICER_NAME, PRICER_DESC, PRICER_PRIORITY, PRICER_DELAY,
@@ -989,8 +2635,49 @@ SCIP_RETCODE SCIPincludePricerOAAR(
 
    SCIP_CALL( SCIPsetPricerFree(scip, pricer, pricerFreeOAAR) );
    SCIP_CALL( SCIPsetPricerInit(scip, pricer, pricerInitOAAR) );
+   SCIP_CALL( SCIPsetPricerInitsol(scip, pricer, pricerInitsolOAAR) );
    SCIP_CALL( SCIPsetPricerExitsol(scip, pricer, pricerExitsolOAAR) );
 
+   SCIP_CALL( SCIPaddBoolParam(scip, "pricing/oaar/shortestpath",
+         "should the shortest path heuristic run before the pricing MIPs?",
+         &pricerdata->shortestpath, FALSE, DEFAULT_SHORTESTPATH, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "pricing/oaar/threads",
+         "number of threads solving the pricing problems of different flows in parallel (the pricing MIPs only if built with THREADSAFE=true)",
+         &pricerdata->nthreads, FALSE, DEFAULT_THREADS, 1, 1024, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "pricing/oaar/maxcolsround",
+         "maximal number of columns after which a pricing round stops and the master LP is resolved (-1: no limit)",
+         &pricerdata->maxcolsround, FALSE, DEFAULT_MAXCOLSROUND, -1, INT_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "pricing/oaar/maxflowsround",
+         "maximal number of flows after which a pricing round which found a column stops (-1: no limit)",
+         &pricerdata->maxflowsround, FALSE, DEFAULT_MAXFLOWSROUND, -1, INT_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddRealParam(scip, "pricing/oaar/smoothing",
+         "smoothing factor of the dual values towards the stability center (0: no stabilization)",
+         &pricerdata->smoothing, FALSE, DEFAULT_SMOOTHING, 0.0, 0.99, NULL, NULL) );
+   SCIP_CALL( SCIPaddBoolParam(scip, "pricing/oaar/smoothingauto",
+         "should the smoothing factor be adapted automatically, starting from pricing/oaar/smoothing?",
+         &pricerdata->smoothingauto, FALSE, DEFAULT_SMOOTHINGAUTO, NULL, NULL) );
+   SCIP_CALL( SCIPaddRealParam(scip, "pricing/oaar/lagrangegap",
+         "relative gap between LP value and Lagrangian bound below which pricing at a node stops early (0: only stop if the bound cannot improve)",
+         &pricerdata->lagrangegap, FALSE, DEFAULT_LAGRANGEGAP, 0.0, 1.0, NULL, NULL) );
+   SCIP_CALL( SCIPaddBoolParam(scip, "pricing/oaar/aggregate",
+         "should flows with the same source, destination, bandwidth, prices and priority be priced only once?",
+         &pricerdata->aggregate, FALSE, DEFAULT_AGGREGATE, NULL, NULL) );
+   SCIP_CALL( SCIPaddBoolParam(scip, "pricing/oaar/mipobjlimit",
+         "should the pricing MIPs only search for improving columns, using an objective limit derived from the dual value of the flow?",
+         &pricerdata->mipobjlimit, FALSE, DEFAULT_MIPOBJLIMIT, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "pricing/oaar/mipsollimit",
+         "number of improving columns after which a pricing MIP stops if the objective limit is used (-1: no limit)",
+         &pricerdata->mipsollimit, FALSE, DEFAULT_MIPSOLLIMIT, -1, INT_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddRealParam(scip, "pricing/oaar/mipgaplimit",
+         "relative gap at which a pricing MIP with an improving column stops if the objective limit is used",
+         &pricerdata->mipgaplimit, FALSE, DEFAULT_MIPGAPLIMIT, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddBoolParam(scip, "pricing/oaar/statsmachine",
+         "should the OAAR pricing statistics be printed as comma separated lines instead of a table?",
+         &pricerdata->statsmachine, FALSE, DEFAULT_STATSMACHINE, NULL, NULL) );
+   SCIP_CALL( SCIPaddStringParam(scip, "pricing/oaar/tracefile",
+         "CSV file to which one row per pricing call is written (LP value, Lagrangian and dual bound, columns added, time, node) (\"\": no trace)",
+         &pricerdata->tracefilename, FALSE, DEFAULT_TRACEFILE, NULL, NULL) );
+
    return SCIP_OKAY;
 }
 
@@ -1002,6 +2689,7 @@ SCIP_RETCODE SCIPpricerOAARActivate(
    OAARNode*             Nodes,
    OAARLink*             Links,
    OAARFlow*             Flows,
+   OAARTopology*         Topology,           /**< links as struct of arrays with the static parts of their costs */
    int                   nNodes,
    int                   nOpticalNodes,
    int                   nLinks,
@@ -1024,12 +2712,14 @@ SCIP_RETCODE SCIPpricerOAARActivate(
    pricerdata = SCIPpricerGetData(pricer);
    assert(pricerdata != NULL);
 
-   /* copy arrays */
+   /* copy the constraints; the topology arrays belong to the original problem data, which lives as long as the
+    * problem, and may be mapped read-only from a binary file
+    */
    SCIP_CALL( SCIPduplicateMemoryArray(scip, &pricerdata->conss, conss, nCons) );
-   SCIP_CALL( SCIPduplicateMemoryArray(scip, &pricerdata->Nodes, Nodes, nNodes) );
-   SCIP_CALL( SCIPduplicateMemoryArray(scip, &pricerdata->Links, Links, nLinks) );
-   SCIP_CALL( SCIPduplicateMemoryArray(scip, &pricerdata->Flows, Flows, nFlows) );
-   //SCIP_CALL( SCIPduplicateMemoryArray(scip, &pricerdata->Flows, Flows, nFlows) );
+   pricerdata->Nodes = Nodes;
+   pricerdata->Links = Links;
+   pricerdata->Flows = Flows;
+   pricerdata->Topology = Topology;
 
    pricerdata->nNodes = nNodes;
    pricerdata->nOpticalNodes = nOpticalNodes;
@@ -1050,4 +2740,156 @@ SCIP_RETCODE SCIPpricerOAARActivate(
    return SCIP_OKAY;
 }
 
+/** sets the branching decision which the pricer respects in addition to the zeroone constraints while SCIP is
+ *  probing, e.g., to evaluate a child node by strong branching; flow -1 removes it
+ */
+SCIP_RETCODE SCIPpricerOAARSetProbingDecision(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   flow,               /**< index of the flow, or -1 */
+   int                   index2,             /**< index of the original variable */
+   CONSTYPE              type                /**< type of the decision */
+   )
+{
+   SCIP_PRICER* pricer;
+   SCIP_PRICERDATA* pricerdata;
+
+   pricer = SCIPfindPricer(scip, PRICER_NAME);
+   assert(pricer != NULL);
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+   assert(flow < pricerdata->nFlows);
+
+   pricerdata->probeflow = flow;
+   pricerdata->probeindex = index2;
+   pricerdata->probetype = type;
+
+   return SCIP_OKAY;
+}
+
+/** prints the pricing statistics of each flow and of the pricing rounds of the current solve */
+SCIP_RETCODE SCIPpricerOAARPrintStatistics(
+   SCIP*                 scip,               /**< SCIP data structure */
+   FILE*                 file                /**< output file, or NULL for standard output */
+   )
+{
+   SCIP_PRICER* pricer;
+   SCIP_PRICERDATA* pricerdata;
+   FLOWSTATS* stats;
+   FLOWSTATS total;
+   SCIP_Real bestredcost;
+   int npoolcols;
+   int r;
+   int k;
+
+   assert(scip != NULL);
+
+   pricer = SCIPfindPricer(scip, PRICER_NAME);
+   assert(pricer != NULL);
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+   /* the statistics only exist between the start and the end of the solving process */
+   if( pricerdata->flowstats == NULL )
+      return SCIP_OKAY;
+
+   BMSclearMemory(&total);
+   npoolcols = pricerdata->colpool != NULL ? SCIPcolpoolGetNCols(pricerdata->colpool) : 0;
+   bestredcost = 0.0;
+   for( r = 0; r < pricerdata->nrounds; r++ )
+      bestredcost = MIN(bestredcost, pricerdata->roundredcost[r]);
+
+   if( pricerdata->statsmachine )
+   {
+      /* one line per flow and per round, each starting with a fixed key */
+      SCIPinfoMessage(scip, file,
+         "oaar_pricing_flow,flow,heurcalls,mipcalls,aggregated,heurtime,buildtime,dectime,solvetime,found,accepted\n");
+      for( k = 0; k < pricerdata->nFlows; k++ )
+      {
+         stats = &pricerdata->flowstats[k];
+         SCIPinfoMessage(scip, file, "oaar_pricing_flow,%d,%d,%d,%d,%.4f,%.4f,%.4f,%.4f,%d,%d\n", k, stats->nheurcalls,
+            stats->nmipcalls, stats->naggregated, stats->heurtime, stats->buildtime, stats->dectime, stats->solvetime,
+            stats->nfound, stats->naccepted);
+      }
+      SCIPinfoMessage(scip, file, "oaar_pricing_round,round,bestredcost\n");
+      for( r = 0; r < pricerdata->nrounds; r++ )
+         SCIPinfoMessage(scip, file, "oaar_pricing_round,%d,%.9g\n", r, pricerdata->roundredcost[r]);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,inserttime,%.4f\n", SCIPgetClockTime(scip, pricerdata->insertclock));
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,heurrounds,%d\n", pricerdata->nheurrounds);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,heurcols,%d\n", pricerdata->nheurcols);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,heurroundtime,%.4f\n",
+         SCIPgetClockTime(scip, pricerdata->heurclock));
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,exactrounds,%d\n", pricerdata->nexactrounds);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,exactcols,%d\n", pricerdata->nexactcols);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,exactroundtime,%.4f\n",
+         SCIPgetClockTime(scip, pricerdata->exactclock));
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,poolcols,%d\n", npoolcols);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,restored,%d\n", pricerdata->npoolcols);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,duplicates,%d\n", pricerdata->nduplicates);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,lagrangebounds,%d\n", pricerdata->nlagrangebounds);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,earlystops,%d\n", pricerdata->nearlystops);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,misprices,%d\n", pricerdata->nmisprices);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,spsolves,%d\n", pricerdata->nspsolves);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,mipsolves,%d\n", pricerdata->nsolves);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,mipoptimal,%d\n", pricerdata->nmipoptimal);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,mipnocols,%d\n", pricerdata->nmipnocols);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,mipsollimit,%d\n", pricerdata->nmipsollimit);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,mipgaplimit,%d\n", pricerdata->nmipgaplimit);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,mipother,%d\n", pricerdata->nmipother);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,mipbuilds,%d\n", pricerdata->nbuilds);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,mipbuildtime,%.4f\n",
+         SCIPgetClockTime(scip, pricerdata->buildclock));
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,flowclasses,%d\n", pricerdata->nflowclasses);
+      SCIPinfoMessage(scip, file, "oaar_pricing_total,aggregated,%d\n", pricerdata->naggregated);
+
+      return SCIP_OKAY;
+   }
+
+   SCIPinfoMessage(scip, file,
+      "OAAR Pricing       :  HeurCalls   MIPCalls Aggregated   HeurTime  BuildTime    DecTime  SolveTime      Found   Accepted\n");
+   for( k = 0; k < pricerdata->nFlows; k++ )
+   {
+      stats = &pricerdata->flowstats[k];
+      SCIPinfoMessage(scip, file, "  flow %-12d: %10d %10d %10d %10.2f %10.2f %10.2f %10.2f %10d %10d\n", k,
+         stats->nheurcalls, stats->nmipcalls, stats->naggregated, stats->heurtime, stats->buildtime, stats->dectime,
+         stats->solvetime, stats->nfound, stats->naccepted);
+
+      total.nheurcalls += stats->nheurcalls;
+      total.nmipcalls += stats->nmipcalls;
+      total.naggregated += stats->naggregated;
+      total.nfound += stats->nfound;
+      total.naccepted += stats->naccepted;
+      total.heurtime += stats->heurtime;
+      total.buildtime += stats->buildtime;
+      total.dectime += stats->dectime;
+      total.solvetime += stats->solvetime;
+   }
+   SCIPinfoMessage(scip, file, "  total            : %10d %10d %10d %10.2f %10.2f %10.2f %10.2f %10d %10d\n",
+      total.nheurcalls, total.nmipcalls, total.naggregated, total.heurtime, total.buildtime, total.dectime,
+      total.solvetime, total.nfound, total.naccepted);
+   SCIPinfoMessage(scip, file, "  rounds           : %10d (best reduced cost %g, last %g, %.2f seconds adding columns)\n",
+      pricerdata->nrounds, bestredcost, pricerdata->nrounds > 0 ? pricerdata->roundredcost[pricerdata->nrounds-1] : 0.0,
+      SCIPgetClockTime(scip, pricerdata->insertclock));
+   SCIPinfoMessage(scip, file, "  heuristic rounds : %10d (%d columns, %.2f seconds)\n", pricerdata->nheurrounds,
+      pricerdata->nheurcols, SCIPgetClockTime(scip, pricerdata->heurclock));
+   SCIPinfoMessage(scip, file, "  exact rounds     : %10d (%d columns, %.2f seconds)\n", pricerdata->nexactrounds,
+      pricerdata->nexactcols, SCIPgetClockTime(scip, pricerdata->exactclock));
+   SCIPinfoMessage(scip, file, "  pool columns     : %10d (%d restored, %d duplicate paths not added)\n", npoolcols,
+      pricerdata->npoolcols, pricerdata->nduplicates);
+   SCIPinfoMessage(scip, file, "  Lagrangian bounds: %10d (pricing stopped early at %d nodes)\n",
+      pricerdata->nlagrangebounds, pricerdata->nearlystops);
+   SCIPinfoMessage(scip, file, "  misprices        : %10d\n", pricerdata->nmisprices);
+   SCIPinfoMessage(scip, file, "  flow classes     : %10d (%d pricing problems skipped for equivalent flows)\n",
+      pricerdata->nflowclasses, pricerdata->naggregated);
+   SCIPinfoMessage(scip, file, "  shortest paths   : %10d\n", pricerdata->nspsolves);
+   SCIPinfoMessage(scip, file, "  pricing MIPs     : %10d (built %d times in %.2f seconds)\n", pricerdata->nsolves,
+      pricerdata->nbuilds, SCIPgetClockTime(scip, pricerdata->buildclock));
+   SCIPinfoMessage(scip, file, "  MIP status       : %10d optimal, %d without improving column, %d at solution limit, "
+      "%d at gap limit, %d at time or memory limit\n", pricerdata->nmipoptimal, pricerdata->nmipnocols,
+      pricerdata->nmipsollimit, pricerdata->nmipgaplimit, pricerdata->nmipother);
+
+   return SCIP_OKAY;
+}
+
 /**@} */
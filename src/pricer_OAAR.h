@@ -12,6 +12,7 @@
 
 #include "scip/scip.h"
 #include "OAARdataStructure.h"
+#include "cons_zeroone.h"
 
 
 extern
@@ -27,6 +28,7 @@ SCIP_RETCODE SCIPpricerOAARActivate(
    OAARNode*             Nodes,
    OAARLink*             Links,
    OAARFlow*             Flows,
+   OAARTopology*         Topology,           /**< links as struct of arrays with the static parts of their costs */
    int                   nNodes,
    int                   nOpticalNodes,
    int                   nLinks,
@@ -36,4 +38,22 @@ SCIP_RETCODE SCIPpricerOAARActivate(
    //int*                  nFlowSol
    );
 
+/** sets the branching decision which the pricer respects in addition to the zeroone constraints while SCIP is
+ *  probing, e.g., to evaluate a child node by strong branching; flow -1 removes it
+ */
+extern
+SCIP_RETCODE SCIPpricerOAARSetProbingDecision(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   flow,               /**< index of the flow, or -1 */
+   int                   index2,             /**< index of the original variable */
+   CONSTYPE              type                /**< type of the decision */
+   );
+
+/** prints the pricing statistics of each flow and of the pricing rounds of the current solve */
+extern
+SCIP_RETCODE SCIPpricerOAARPrintStatistics(
+   SCIP*                 scip,               /**< SCIP data structure */
+   FILE*                 file                /**< output file, or NULL for standard output */
+   );
+
 #endif
@@ -7,8 +7,9 @@
 
 /*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
 
-#define SCIP_DEBUG
+//#define SCIP_DEBUG
 
+#include <stdint.h>
 #include <string.h>
 
 #include "probdata_OAAR.h"
@@ -17,9 +18,29 @@
 #include "scip/cons_setppc.h"
 #include "scip/cons_knapsack.h"
 #include "OAARdataStructure.h"
+#include "shortestpath_OAAR.h"
 
 #include "scip/scip.h"
 
+/** @brief Columns of one flow with an inverted index from the original variables to the columns using them
+ *
+ *  Column c of the flow is the variable at position cols[c] of the variable array of the problem data; since variables
+ *  are only appended, the columns are sorted by their position. For each original variable which is one in some column
+ *  of the flow there is a row, whose bitmap has bit c set iff the variable is one in column c. The rows are sorted by
+ *  the index of their original variable.
+ */
+typedef struct FlowCols
+{
+   int*                  cols;               /**< positions of the columns of the flow in the variable array */
+   int                   ncols;              /**< number of columns of the flow */
+   int                   colssize;           /**< size of cols */
+   int*                  rowidx;             /**< sorted indices of the original variables which have a row */
+   uint64_t**            rowbits;            /**< bitmap of the columns in which the original variable of a row is one */
+   int                   nrows;              /**< number of rows */
+   int                   rowssize;           /**< size of rowidx and rowbits */
+   int                   nwords;             /**< number of words of each bitmap */
+} FLOWCOLS;
+
 /** @brief Problem data which is accessible in all places
  *
  * This problem data is used to store the input of the OAAR, all variables which are created, and all
@@ -40,7 +61,16 @@ struct SCIP_ProbData
    int                   nvars;        /**< number of generated variables */
    int                   nCons;        /**< number of constraints */
    int*                  nFlowSol;     /**< how many vars for each flow */
+   FLOWCOLS*             flowcols;     /**< columns of each flow with their index for the branching decisions */
    int                   varssize;     /**< size of the variable array */
+   OAARAdjacency         Adjacency;    /**< out- and in-links of each node */
+   OAARTopology*         Topology;     /**< links as struct of arrays with the static parts of their costs */
+   SCIP_Bool             ownsview;     /**< is the topology view owned by this problem data? */
+   SCIP_Bool             varnames;     /**< are the columns named lambda_<flow>_<colid>? */
+   SCIP_Bool             ownstopology; /**< are the topology arrays and the adjacency owned by this problem data? */
+   void*                 storage;      /**< storage of topology arrays which are not owned, freed with the problem */
+   size_t                storagesize;  /**< size of the storage in bytes */
+   SCIP_DECL_PROBDATASTORAGEFREE((*storagefree)); /**< frees the storage, or NULL */
 };
 
 
@@ -84,6 +114,196 @@ SCIP_DECL_EVENTEXEC(eventExecAddedVar)
  * @{
  */
 
+/** groups the given links by their end node: counts the links of each node, turns the counts into start positions
+ *  and fills the links in increasing order, so the optical links of each node come first
+ */
+static
+void fillAdjacency(
+   OAARLink*             Links,              /**< Links array */
+   int                   nNodes,             /**< number of Nodes */
+   int                   nLinks,             /**< number of links */
+   int                   nOpticalLinks,      /**< number of optical links */
+   SCIP_Bool             byhead,             /**< group the links by Head (out-links) instead of Tail (in-links)? */
+   int*                  beg,                /**< array to store the start of the links of each node (size nNodes+1) */
+   int*                  optend,             /**< array to store the end of the optical links of each node */
+   int*                  links,              /**< array to store the grouped links (size nLinks) */
+   int*                  fill                /**< buffer of size nNodes */
+   )
+{
+   int i;
+   int v;
+
+   for( v = 0; v <= nNodes; v++ )
+      beg[v] = 0;
+   for( i = 0; i < nLinks; i++ )
+      beg[(byhead ? Links[i].Head : Links[i].Tail) + 1]++;
+   for( v = 0; v < nNodes; v++ )
+      beg[v+1] += beg[v];
+
+   for( v = 0; v < nNodes; v++ )
+   {
+      fill[v] = beg[v];
+      optend[v] = beg[v];
+   }
+   for( i = 0; i < nLinks; i++ )
+   {
+      v = byhead ? Links[i].Head : Links[i].Tail;
+      links[fill[v]] = i;
+      fill[v]++;
+      if( i < nOpticalLinks )
+         optend[v] = fill[v];
+   }
+}
+
+/** adds the variable at position pos of the variable array to the columns of its flow and to the rows of the original
+ *  variables which are one in it
+ */
+static
+SCIP_RETCODE flowcolsAddVar(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int                   pos                 /**< position of the variable in the variable array */
+   )
+{
+   SCIP_VARDATA* vardata;
+   FLOWCOLS* fc;
+   int* oriVars;
+   int nOriVars;
+   int nwords;
+   int c;
+   int j;
+   int r;
+   int i;
+   int v;
+
+   vardata = SCIPvarGetData(probdata->vars[pos]);
+   fc = &probdata->flowcols[SCIPvardataGetFlow(vardata)];
+   assert(fc->ncols == 0 || fc->cols[fc->ncols-1] < pos);
+
+   if( fc->ncols == fc->colssize )
+   {
+      fc->colssize = MAX(8, 2 * fc->colssize);
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &fc->cols, fc->colssize) );
+   }
+   c = fc->ncols;
+   fc->cols[c] = pos;
+   fc->ncols++;
+
+   /* the bitmaps grow by doubling, so each row is copied O(log ncols) times */
+   if( c == 64 * fc->nwords )
+   {
+      nwords = MAX(1, 2 * fc->nwords);
+      for( r = 0; r < fc->nrows; r++ )
+      {
+         SCIP_CALL( SCIPreallocMemoryArray(scip, &fc->rowbits[r], nwords) );
+         BMSclearMemoryArray(&fc->rowbits[r][fc->nwords], nwords - fc->nwords);
+      }
+      fc->nwords = nwords;
+   }
+
+   oriVars = SCIPvardataGetOriVars(vardata);
+   nOriVars = SCIPvardataGetNOriVars(vardata);
+   for( v = 0; v < nOriVars; v++ )
+   {
+      j = oriVars[v];
+      if( !SCIPsortedvecFindInt(fc->rowidx, j, fc->nrows, &r) )
+      {
+         if( fc->nrows == fc->rowssize )
+         {
+            fc->rowssize = MAX(16, 2 * fc->rowssize);
+            SCIP_CALL( SCIPreallocMemoryArray(scip, &fc->rowidx, fc->rowssize) );
+            SCIP_CALL( SCIPreallocMemoryArray(scip, &fc->rowbits, fc->rowssize) );
+         }
+         for( i = fc->nrows; i > r; i-- )
+         {
+            fc->rowidx[i] = fc->rowidx[i-1];
+            fc->rowbits[i] = fc->rowbits[i-1];
+         }
+         fc->rowidx[r] = j;
+         SCIP_CALL( SCIPallocClearMemoryArray(scip, &fc->rowbits[r], fc->nwords) );
+         fc->nrows++;
+      }
+      fc->rowbits[r][c / 64] |= (uint64_t)1 << (c % 64);
+   }
+
+   return SCIP_OKAY;
+}
+
+/** frees the columns of each flow and their index */
+static
+void flowcolsFree(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PROBDATA*        probdata            /**< problem data */
+   )
+{
+   FLOWCOLS* fc;
+   int k;
+   int r;
+
+   for( k = 0; k < probdata->nFlows; k++ )
+   {
+      fc = &probdata->flowcols[k];
+      for( r = 0; r < fc->nrows; r++ )
+         SCIPfreeMemoryArray(scip, &fc->rowbits[r]);
+      SCIPfreeMemoryArrayNull(scip, &fc->rowbits);
+      SCIPfreeMemoryArrayNull(scip, &fc->rowidx);
+      SCIPfreeMemoryArrayNull(scip, &fc->cols);
+   }
+   SCIPfreeMemoryArray(scip, &probdata->flowcols);
+}
+
+/** creates the struct-of-arrays view of the links with their static delay, jitter and bandwidth cost */
+static
+SCIP_RETCODE topologyCreate(
+   SCIP*                 scip,               /**< SCIP data structure */
+   OAARTopology**        topology,           /**< pointer to store the topology view */
+   OAARNode*             Nodes,              /**< Nodes array */
+   OAARLink*             Links,              /**< Links array */
+   int                   nLinks              /**< number of links */
+   )
+{
+   OAARNode* node;
+   int i;
+
+   SCIP_CALL( SCIPallocMemory(scip, topology) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*topology)->Head, nLinks) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*topology)->Tail, nLinks) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*topology)->Capacity, nLinks) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*topology)->Delay, nLinks) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*topology)->Jitter, nLinks) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*topology)->BandCost, nLinks) );
+   (*topology)->nLinks = nLinks;
+
+   for( i = 0; i < nLinks; i++ )
+   {
+      node = &Nodes[Links[i].Head];
+      (*topology)->Head[i] = Links[i].Head;
+      (*topology)->Tail[i] = Links[i].Tail;
+      (*topology)->Capacity[i] = Links[i].Capacity;
+      (*topology)->Delay[i] = node->ProcDelay + node->QueueDelay + Links[i].PropDelay + Links[i].TransDelay;
+      (*topology)->Jitter[i] = node->Jitter;
+      (*topology)->BandCost[i] = Links[i].BandCost;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** frees the topology view */
+static
+void topologyFree(
+   SCIP*                 scip,               /**< SCIP data structure */
+   OAARTopology**        topology            /**< pointer to the topology view */
+   )
+{
+   SCIPfreeMemoryArray(scip, &(*topology)->BandCost);
+   SCIPfreeMemoryArray(scip, &(*topology)->Jitter);
+   SCIPfreeMemoryArray(scip, &(*topology)->Delay);
+   SCIPfreeMemoryArray(scip, &(*topology)->Capacity);
+   SCIPfreeMemoryArray(scip, &(*topology)->Tail);
+   SCIPfreeMemoryArray(scip, &(*topology)->Head);
+   SCIPfreeMemory(scip, topology);
+}
+
 /** creates problem data */
 static
 SCIP_RETCODE probdataCreate(
@@ -94,6 +314,9 @@ SCIP_RETCODE probdataCreate(
    OAARNode*             Nodes,              /**< Nodes array */
    OAARLink*             Links,              /**< Links array */
    OAARFlow*             Flows,              /**< Flow information */
+   OAARAdjacency*        adj,                /**< adjacency to share together with the topology arrays, or NULL to
+                                              *   copy the arrays and build the adjacency */
+   OAARTopology*         topology,           /**< topology view to share, or NULL to build it */
    int                   nNodes,             /**< number of Nodes */
    int                   nOpticalNodes,      /**< number of optical nodes */
    int                   nLinks,             /**< number of links */
@@ -105,6 +328,7 @@ SCIP_RETCODE probdataCreate(
    )
 {
    int i;
+
    assert(scip != NULL);
    assert(probdata != NULL);
 
@@ -121,15 +345,39 @@ SCIP_RETCODE probdataCreate(
 
    /* duplicate arrays */
    SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->conss, conss, nCons) ); 
-   SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->Nodes, Nodes, nNodes) );
-   SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->Links, Links, nLinks) );
-   SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->Flows, Flows, nFlows) );
    SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->nFlowSol, nFlowSol, nFlows) );
-   for( i = 0; i < nNodes; i++ )
+
+   /* the topology is never modified, so a shared topology is used in place */
+   if( adj == NULL )
+   {
+      SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->Nodes, Nodes, nNodes) );
+      SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->Links, Links, nLinks) );
+      SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->Flows, Flows, nFlows) );
+      SCIP_CALL( SCIPprobdataCreateAdjacency(scip, &(*probdata)->Adjacency, Links, nNodes, nLinks, nOpticalLinks) );
+      (*probdata)->ownstopology = TRUE;
+   }
+   else
+   {
+      (*probdata)->Nodes = Nodes;
+      (*probdata)->Links = Links;
+      (*probdata)->Flows = Flows;
+      (*probdata)->Adjacency = *adj;
+      (*probdata)->ownstopology = FALSE;
+   }
+   if( topology == NULL )
+   {
+      SCIP_CALL( topologyCreate(scip, &(*probdata)->Topology, (*probdata)->Nodes, (*probdata)->Links, nLinks) );
+      (*probdata)->ownsview = TRUE;
+   }
+   else
    {
-      SCIP_CALL( SCIPduplicateMemoryArray(scip, &((*probdata)->Nodes[i].ConnLinks), 
-         Nodes[i].ConnLinks, Nodes[i].nConnLinks) );
+      (*probdata)->Topology = topology;
+      (*probdata)->ownsview = FALSE;
    }
+   (*probdata)->varnames = TRUE;
+   (*probdata)->storage = NULL;
+   (*probdata)->storagesize = 0;
+   (*probdata)->storagefree = NULL;
 
    (*probdata)->nvars = nvars;
    (*probdata)->varssize = nvars;
@@ -140,6 +388,13 @@ SCIP_RETCODE probdataCreate(
    (*probdata)->nOpticalLinks = nOpticalLinks;
    (*probdata)->nFlows = nFlows;
 
+   /* the transformed problem data indexes the columns it inherits from the original one */
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &(*probdata)->flowcols, nFlows) );
+   for( i = 0; i < nvars; i++ )
+   {
+      SCIP_CALL( flowcolsAddVar(scip, *probdata, i) );
+   }
+
    return SCIP_OKAY;
 }
 
@@ -167,18 +422,24 @@ SCIP_RETCODE probdataFree(
       SCIP_CALL( SCIPreleaseCons(scip, &(*probdata)->conss[i]) );
    }
 
-   // free memory of ConnLinks array 
-   for( i = 0; i < (*probdata)->nNodes; i++ )
+   if( (*probdata)->ownsview )
+      topologyFree(scip, &(*probdata)->Topology);
+
+   if( (*probdata)->ownstopology )
    {
-      SCIPfreeMemoryArray(scip, &((*probdata)->Nodes[i].ConnLinks));
+      SCIPprobdataFreeAdjacency(scip, &(*probdata)->Adjacency);
+      SCIPfreeMemoryArray(scip, &(*probdata)->Nodes);
+      SCIPfreeMemoryArray(scip, &(*probdata)->Links);
+      SCIPfreeMemoryArray(scip, &(*probdata)->Flows);
    }
+   else if( (*probdata)->storagefree != NULL )
+      (*probdata)->storagefree(scip, (*probdata)->storage, (*probdata)->storagesize);
+
+   flowcolsFree(scip, *probdata);
 
    /* free memory of arrays */
    SCIPfreeMemoryArray(scip, &(*probdata)->vars);
    SCIPfreeMemoryArray(scip, &(*probdata)->conss);
-   SCIPfreeMemoryArray(scip, &(*probdata)->Nodes);
-   SCIPfreeMemoryArray(scip, &(*probdata)->Links);
-   SCIPfreeMemoryArray(scip, &(*probdata)->Flows);
    SCIPfreeMemoryArray(scip, &(*probdata)->nFlowSol);
 
    /* free probdata */
@@ -187,113 +448,685 @@ SCIP_RETCODE probdataFree(
    return SCIP_OKAY;
 }
 
-/** create initial columns */
+/** returns the cost of routing flow k over link i, weighted by the priority of the flow like the objective of the
+ *  columns
+ */
 static
-SCIP_RETCODE createInitialColumns(
+SCIP_Real getStaticLinkCost(
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int                   k,                  /**< index of the flow */
+   int                   i                   /**< index of the link */
+   )
+{
+   OAARTopology* topology;
+   OAARFlow* flow;
+
+   topology = probdata->Topology;
+   flow = &probdata->Flows[k];
+
+   return flow->Priority * (flow->DelayPrice * topology->Delay[i] + flow->JitterPrice * topology->Jitter[i]
+      + flow->BandWidth * topology->BandCost[i]);
+}
+
+/** creates the column of flow k which uses the original variables (x, y, z of the pricing problem) given by
+ *  oriFlowVars, adds it to the problem and stores it in the problem data
+ */
+static
+SCIP_RETCODE createPathColumn(
    SCIP*                 scip,               /**< SCIP data structure */
-   SCIP_PROBDATA*        probdata            /**< problem data */
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int                   k,                  /**< index of the flow */
+   int*                  oriFlowVars,        /**< value (0 or 1) of each original variable of the pricing problem */
+   SCIP_VAR**            var                 /**< pointer to store the variable, or NULL; it is captured by the
+                                              *   problem data */
    )
 {
    SCIP_CONS** conss;
    SCIP_VARDATA* vardata;
-   SCIP_VAR* var;
+   SCIP_VAR* newvar;
    char name[SCIP_MAXSTRLEN];
+   int* consids;
+   int nconsids;
+   int nLinks, nOpticalLinks, nElecLinks, nFlows;
+   double obj;
+   int i, j;
 
-   int nNodes, nOpticalNodes, nLinks, nOpticalLinks, nFlows;
-   int nvars, nCons;
+   conss = probdata->conss;
+   nLinks = probdata->nLinks;
+   nOpticalLinks = probdata->nOpticalLinks;
+   nElecLinks = nLinks - nOpticalLinks;
+   nFlows = probdata->nFlows;
 
-   OAARNode* Nodes;
-   OAARLink* Links;
-   OAARFlow* Flows;
+   /* the column appears in Cons1 of its flow, in Cons2 of its electrical links and in Cons3 of its wavelengths */
+   SCIP_CALL( SCIPallocBufferArray(scip, &consids, 1+nElecLinks+nOpticalLinks*nWaveLength) );
+   consids[0] = k;
+   nconsids = 1;
+   obj = 0.0;
+   for( i = 0; i < nLinks; i++ )
+   {
+      if( oriFlowVars[i] == 0 )
+         continue;
+
+      obj += getStaticLinkCost(probdata, k, i);
+      if( i >= nOpticalLinks )
+      {
+         consids[nconsids] = nFlows + i - nOpticalLinks;
+         nconsids++;
+      }
+   }
+   for( i = 0; i < nOpticalLinks; i++ )
+   {
+      for( j = 0; j < nWaveLength; j++ )
+      {
+         if( oriFlowVars[nLinks+i*nWaveLength+j] == 1 )
+         {
+            consids[nconsids] = nFlows + nElecLinks + i*nWaveLength + j;
+            nconsids++;
+         }
+      }
+   }
 
+   if( probdata->varnames )
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "lambda_%d_%d", k, probdata->nFlowSol[k]);
+
+   SCIP_CALL( SCIPvardataCreateOAAR(scip, &vardata, consids, nconsids, oriFlowVars,
+         nLinks + 2*nOpticalLinks*nWaveLength, k, probdata->nFlowSol[k]) );
+   SCIP_CALL( SCIPcreateVarOAAR(scip, &newvar, probdata->varnames ? name : NULL, obj, TRUE, TRUE, vardata) );
+
+   /* add variable to the problem and store it in the problem data */
+   SCIP_CALL( SCIPaddVar(scip, newvar) );
+   SCIP_CALL( SCIPprobdataAddVar(scip, probdata, newvar) );
+
+   SCIP_CALL( SCIPaddCoefSetppc(scip, conss[consids[0]], newvar) );
+   for( i = 1; i < nconsids; i++ )
+   {
+      if( consids[i] < nFlows + nElecLinks )
+      {
+         SCIP_CALL( SCIPaddCoefKnapsack(scip, conss[consids[i]], newvar, probdata->Flows[k].BandWidth) );
+      }
+      else
+      {
+         SCIP_CALL( SCIPaddCoefSetppc(scip, conss[consids[i]], newvar) );
+      }
+   }
+
+   /* the upper bound is enforced by the set partitioning constraint of the flow; an explicit bound would only produce
+    * a dual value which might lead to positive reduced costs
+    */
+   SCIP_CALL( SCIPchgVarUbLazy(scip, newvar, 1.0) );
+
+   SCIPdebugMessage("created column <%s> with objective %g\n", SCIPvarGetName(newvar), obj);
+
+   if( var != NULL )
+      *var = newvar;
+   SCIP_CALL( SCIPreleaseVar(scip, &newvar) );
+
+   SCIPfreeBufferArray(scip, &consids);
+
+   return SCIP_OKAY;
+}
+
+/** translates a path into the values of the original variables; returns FALSE if the path passes a link twice or
+ *  leaves the source again, since it is then not feasible for the pricing problem
+ */
+static
+SCIP_Bool getPathVals(
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int                   k,                  /**< index of the flow */
+   int*                  pathlinks,          /**< links of the path */
+   int*                  pathwaves,          /**< wavelength of each link of the path, -1 for electrical links */
+   int                   npathlinks,         /**< number of links of the path */
+   int*                  oriFlowVars         /**< array to store the value (0 or 1) of each original variable */
+   )
+{
+   int nLinks, nOpticalLinks;
+   int i;
+
+   nLinks = probdata->nLinks;
+   nOpticalLinks = probdata->nOpticalLinks;
+
+   BMSclearMemoryArray(oriFlowVars, nLinks + 2*nOpticalLinks*nWaveLength);
+
+   for( i = 0; i < npathlinks; i++ )
+   {
+      if( oriFlowVars[pathlinks[i]] == 1 || (i > 0 && probdata->Links[pathlinks[i]].Head == probdata->Flows[k].Source) )
+         return FALSE;
+
+      oriFlowVars[pathlinks[i]] = 1;
+      if( pathwaves[i] >= 0 )
+      {
+         oriFlowVars[nLinks+pathlinks[i]*nWaveLength+pathwaves[i]] = 1;
+         oriFlowVars[nLinks+nOpticalLinks*nWaveLength+pathlinks[i]*nWaveLength+pathwaves[i]] = 1;
+      }
+   }
+
+   return TRUE;
+}
+
+/** stores the sorted indices of the original variables with value one of a path and returns their hash value */
+static
+unsigned int getPathIndices(
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int*                  pathlinks,          /**< links of the path */
+   int*                  pathwaves,          /**< wavelength of each link of the path, -1 for electrical links */
+   int                   npathlinks,         /**< number of links of the path */
+   int*                  idx,                /**< array to store the indices, of size at least 3 * npathlinks */
+   int*                  nidx                /**< pointer to store the number of indices */
+   )
+{
+   unsigned int hashval;
+   int nLinks, nOpticalLinks;
+   int i;
+
+   nLinks = probdata->nLinks;
+   nOpticalLinks = probdata->nOpticalLinks;
+
+   *nidx = 0;
+   for( i = 0; i < npathlinks; i++ )
+   {
+      idx[(*nidx)++] = pathlinks[i];
+      if( pathwaves[i] >= 0 )
+      {
+         idx[(*nidx)++] = nLinks + pathlinks[i]*nWaveLength + pathwaves[i];
+         idx[(*nidx)++] = nLinks + nOpticalLinks*nWaveLength + pathlinks[i]*nWaveLength + pathwaves[i];
+      }
+   }
+   SCIPsortInt(idx, *nidx);
+
+   /* FNV-1a over the indices, like the hash of the column pool */
+   hashval = 2166136261u;
+   for( i = 0; i < *nidx; i++ )
+      hashval = (hashval ^ (unsigned int)idx[i]) * 16777619u;
+
+   return hashval;
+}
+
+/** sets the static link costs of flow k for the shortest path engine; links the flow cannot use are forbidden */
+static
+void setStaticCosts(
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int                   k,                  /**< index of the flow */
+   SCIP_Real*            linkcost,           /**< array to store the cost of each link */
+   SCIP_Real*            wavecost,           /**< array to store the cost of each wavelength of each optical link */
+   SCIP_Bool*            opticalallowed      /**< pointer to store whether optical links may be used */
+   )
+{
+   int* capacity;
+   int nLinks, nOpticalLinks;
+   int bandwidth;
+   int i;
+
+   nLinks = probdata->nLinks;
+   nOpticalLinks = probdata->nOpticalLinks;
+   bandwidth = probdata->Flows[k].BandWidth;
+   capacity = probdata->Topology->Capacity;
+
+   computeLinkCosts(probdata->Topology, &probdata->Flows[k], 0, nLinks, linkcost);
+   for( i = nOpticalLinks; i < nLinks; i++ )
+   {
+      if( capacity[i] < bandwidth )
+         linkcost[i] = SCIP_INVALID;
+   }
+   for( i = 0; i < nOpticalLinks*nWaveLength; i++ )
+      wavecost[i] = 0.0;
+
+   /* the shortest path engine uses a single wavelength per optical link (subCons4) */
+   *opticalallowed = (bandwidth <= WaveLengthBand);
+}
+
+/** creates initial columns from cheap paths of each flow w.r.t. the static costs
+ *
+ *  This is a heuristic link exclusion enumeration, not Lawler's or Yen's partitioning: child i of a subproblem
+ *  additionally excludes link e_i of its path, but does not force the links e_1..e_{i-1}. Hence the children overlap,
+ *  the same path can be found in several of them, and such duplicates (as well as walks which are not simple paths)
+ *  are skipped when a path is accepted. Forcing a prefix would need the shortest path engine to start in the
+ *  wavelength layer in which the prefix ends. The number of open subproblems is limited to 1 + npaths times the
+ *  maximal path length; children which do not fit are dropped, so a flow may get fewer than npaths paths even if more
+ *  exist, and the accepted paths are not guaranteed to be the npaths cheapest ones. The artificial links are
+ *  excluded, since each flow already has its artificial column.
+ */
+static
+SCIP_RETCODE createShortestPathColumns(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   SCIP_LAYEREDGRAPH*    graph,              /**< layered graph of the topology */
+   SCIP_LAYEREDGRAPHWS*  ws,                 /**< workspace of the shortest path engine */
+   int                   npaths,             /**< number of paths per flow */
+   SCIP_Real             timelimit,          /**< time limit in seconds */
+   SCIP_CLOCK*           clock,              /**< running clock to check the time limit */
+   int*                  pathbeg             /**< array to store the position of the first path column of each flow
+                                              *   in the variables of the problem data (size nFlows+1) */
+   )
+{
+   SCIP_Real* linkcost;
+   SCIP_Real* wavecost;
+   SCIP_Real* subcost;
+   int** subexcl;
+   int* nsubexcl;
+   int** sublinks;
+   int** subwaves;
+   int* nsublinks;
+   int* oriFlowVars;
+   int** acceptedidx;
+   int* nacceptedidx;
+   unsigned int* acceptedhash;
+   int* pathidx;
+   int npathidx;
+   unsigned int pathhash;
+   int* pathlinks;
+   int* pathwaves;
+   int npathlinks;
+   SCIP_Real pathcost;
+   SCIP_Bool found;
+   SCIP_Bool opticalallowed;
+   SCIP_Bool duplicate;
+   int nOriFlowVars;
+   int maxpathlinks;
+   int maxsubs;
+   int nsubs;
+   int naccepted;
+   int ndropped;
+   int best;
+   int e;
    int i;
-   int tempConsIds[2];
-   OAARLink tempLink;
-   OAARNode tempHeadNode;
-   OAARFlow tempFlow;
-   double tempDelay, tempJitter, tempPathCost, obj;
+   int j;
+   int k;
+   int s;
+
+   nOriFlowVars = probdata->nLinks + 2*probdata->nOpticalLinks*nWaveLength;
+   maxpathlinks = probdata->nNodes * (nWaveLength+1);
+
+   /* limit of the open subproblems; children beyond it are dropped, see above */
+   maxsubs = 1 + npaths * maxpathlinks;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &linkcost, probdata->nLinks) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &wavecost, probdata->nOpticalLinks*nWaveLength+1) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &pathlinks, maxpathlinks) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &pathwaves, maxpathlinks) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &oriFlowVars, nOriFlowVars) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &pathidx, 3 * maxpathlinks) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &acceptedidx, npaths) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &nacceptedidx, npaths) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &acceptedhash, npaths) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &subcost, maxsubs) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &subexcl, maxsubs) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &nsubexcl, maxsubs) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &sublinks, maxsubs) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &subwaves, maxsubs) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &nsublinks, maxsubs) );
+
+   for( k = 0; k < probdata->nFlows; k++ )
+   {
+      pathbeg[k] = probdata->nvars;
+      if( SCIPgetClockTime(scip, clock) >= timelimit )
+         continue;
+
+      setStaticCosts(probdata, k, linkcost, wavecost, &opticalallowed);
+      for( i = probdata->nLinks - probdata->nFlows; i < probdata->nLinks; i++ )
+         linkcost[i] = SCIP_INVALID;
+
+      nsubs = 0;
+      naccepted = 0;
+      ndropped = 0;
+
+      /* root subproblem without excluded links */
+      SCIP_CALL( SCIPlayeredgraphShortestPath(graph, ws, probdata->Flows[k].Source, probdata->Flows[k].Destination,
+            linkcost, wavecost, opticalallowed, pathlinks, pathwaves, &npathlinks, &pathcost, &found) );
+      if( found )
+      {
+         subcost[nsubs] = pathcost;
+         nsubexcl[nsubs] = 0;
+         subexcl[nsubs] = NULL;
+         nsublinks[nsubs] = npathlinks;
+         SCIP_CALL( SCIPduplicateMemoryArray(scip, &sublinks[nsubs], pathlinks, npathlinks) );
+         SCIP_CALL( SCIPduplicateMemoryArray(scip, &subwaves[nsubs], pathwaves, npathlinks) );
+         nsubs++;
+      }
+
+      while( nsubs > 0 && naccepted < npaths && SCIPgetClockTime(scip, clock) < timelimit )
+      {
+         /* take the cheapest open subproblem; the last one wins ties, which keeps the removal cheap */
+         best = nsubs - 1;
+         for( s = nsubs - 2; s >= 0; s-- )
+         {
+            if( subcost[s] < subcost[best] )
+               best = s;
+         }
+
+         /* accept its path unless it was accepted before or is not a simple path; paths are compared by the hash value
+          * and the sorted indices of their original variables, so the dense values are only built for new paths
+          */
+         pathhash = getPathIndices(probdata, sublinks[best], subwaves[best], nsublinks[best], pathidx, &npathidx);
+
+         duplicate = FALSE;
+         for( j = 0; j < naccepted && !duplicate; j++ )
+         {
+            duplicate = (acceptedhash[j] == pathhash && nacceptedidx[j] == npathidx
+               && memcmp(acceptedidx[j], pathidx, npathidx * sizeof(int)) == 0);
+         }
+
+         if( !duplicate && getPathVals(probdata, k, sublinks[best], subwaves[best], nsublinks[best], oriFlowVars) )
+         {
+            SCIP_CALL( createPathColumn(scip, probdata, k, oriFlowVars, NULL) );
+            SCIP_CALL( SCIPduplicateMemoryArray(scip, &acceptedidx[naccepted], pathidx, npathidx) );
+            nacceptedidx[naccepted] = npathidx;
+            acceptedhash[naccepted] = pathhash;
+            naccepted++;
+         }
+
+         /* branch on the subproblem: each child additionally excludes one link of the path; the children overlap */
+         for( i = 0; i < nsublinks[best] && nsubs < maxsubs; i++ )
+         {
+            e = sublinks[best][i];
+
+            for( j = 0; j < nsubexcl[best]; j++ )
+               linkcost[subexcl[best][j]] = SCIP_INVALID;
+            linkcost[e] = SCIP_INVALID;
+
+            SCIP_CALL( SCIPlayeredgraphShortestPath(graph, ws, probdata->Flows[k].Source,
+                  probdata->Flows[k].Destination, linkcost, wavecost, opticalallowed, pathlinks, pathwaves,
+                  &npathlinks, &pathcost, &found) );
+
+            /* restore the costs of the excluded links */
+            linkcost[e] = getStaticLinkCost(probdata, k, e);
+            for( j = 0; j < nsubexcl[best]; j++ )
+               linkcost[subexcl[best][j]] = getStaticLinkCost(probdata, k, subexcl[best][j]);
+
+            if( !found )
+               continue;
+
+            subcost[nsubs] = pathcost;
+            nsubexcl[nsubs] = nsubexcl[best] + 1;
+            SCIP_CALL( SCIPallocMemoryArray(scip, &subexcl[nsubs], nsubexcl[nsubs]) );
+            for( j = 0; j < nsubexcl[best]; j++ )
+               subexcl[nsubs][j] = subexcl[best][j];
+            subexcl[nsubs][nsubexcl[best]] = e;
+            nsublinks[nsubs] = npathlinks;
+            SCIP_CALL( SCIPduplicateMemoryArray(scip, &sublinks[nsubs], pathlinks, npathlinks) );
+            SCIP_CALL( SCIPduplicateMemoryArray(scip, &subwaves[nsubs], pathwaves, npathlinks) );
+            nsubs++;
+         }
+         ndropped += nsublinks[best] - i;
+
+         /* remove the subproblem by moving the last one to its position */
+         SCIPfreeMemoryArray(scip, &subwaves[best]);
+         SCIPfreeMemoryArray(scip, &sublinks[best]);
+         SCIPfreeMemoryArrayNull(scip, &subexcl[best]);
+         nsubs--;
+         subcost[best] = subcost[nsubs];
+         subexcl[best] = subexcl[nsubs];
+         nsubexcl[best] = nsubexcl[nsubs];
+         sublinks[best] = sublinks[nsubs];
+         subwaves[best] = subwaves[nsubs];
+         nsublinks[best] = nsublinks[nsubs];
+      }
+
+      for( s = 0; s < nsubs; s++ )
+      {
+         SCIPfreeMemoryArray(scip, &subwaves[s]);
+         SCIPfreeMemoryArray(scip, &sublinks[s]);
+         SCIPfreeMemoryArrayNull(scip, &subexcl[s]);
+      }
+      for( j = 0; j < naccepted; j++ )
+      {
+         SCIPfreeMemoryArray(scip, &acceptedidx[j]);
+      }
+
+      SCIPdebugMessage("created %d path columns for flow %d, %d subproblems dropped at the limit\n", naccepted, k,
+         ndropped);
+   }
+   pathbeg[probdata->nFlows] = probdata->nvars;
+
+   SCIPfreeBufferArray(scip, &nsublinks);
+   SCIPfreeBufferArray(scip, &subwaves);
+   SCIPfreeBufferArray(scip, &sublinks);
+   SCIPfreeBufferArray(scip, &nsubexcl);
+   SCIPfreeBufferArray(scip, &subexcl);
+   SCIPfreeBufferArray(scip, &subcost);
+   SCIPfreeBufferArray(scip, &acceptedhash);
+   SCIPfreeBufferArray(scip, &nacceptedidx);
+   SCIPfreeBufferArray(scip, &acceptedidx);
+   SCIPfreeBufferArray(scip, &pathidx);
+   SCIPfreeBufferArray(scip, &oriFlowVars);
+   SCIPfreeBufferArray(scip, &pathwaves);
+   SCIPfreeBufferArray(scip, &pathlinks);
+   SCIPfreeBufferArray(scip, &wavecost);
+   SCIPfreeBufferArray(scip, &linkcost);
+
+   return SCIP_OKAY;
+}
+
+/** compares two flows by their weight in the objective, priority times bandwidth */
+static
+SCIP_DECL_SORTINDCOMP(flowCompWeight)
+{  /*lint --e{715}*/
+   OAARFlow* Flows;
+   SCIP_Real weight1;
+   SCIP_Real weight2;
+
+   Flows = (OAARFlow*)dataptr;
+   weight1 = Flows[ind1].Priority * Flows[ind1].BandWidth;
+   weight2 = Flows[ind2].Priority * Flows[ind2].BandWidth;
+
+   if( weight1 > weight2 )
+      return -1;
+   if( weight1 < weight2 )
+      return 1;
+
+   return ind1 - ind2;
+}
+
+/** routes the flows one after the other on their cheapest path w.r.t. the static costs and the remaining capacities
+ *  and passes the result to SCIP as a starting solution; the heaviest flows are routed first
+ *
+ *  A flow can always fall back to its artificial link, unless another flow between the same nodes took it. Then no
+ *  solution is created.
+ */
+static
+SCIP_RETCODE createGreedySolution(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   SCIP_LAYEREDGRAPH*    graph,              /**< layered graph of the topology */
+   SCIP_LAYEREDGRAPHWS*  ws,                 /**< workspace of the shortest path engine */
+   int*                  pathbeg             /**< position of the first path column of each flow in the variables of
+                                              *   the problem data (size nFlows+1) */
+   )
+{
+   SCIP_SOL* sol;
+   SCIP_VAR** flowvars;
+   SCIP_VAR* var;
+   SCIP_VARDATA* vardata;
+   SCIP_Real* linkcost;
+   SCIP_Real* wavecost;
+   int* residual;
+   SCIP_Bool* waveused;
+   int* order;
    int* oriFlowVars;
+   int* pathlinks;
+   int* pathwaves;
+   int npathlinks;
+   SCIP_Real pathcost;
+   SCIP_Bool found;
+   SCIP_Bool opticalallowed;
+   SCIP_Bool stored;
+   int nLinks, nOpticalLinks, nFlows;
    int nOriFlowVars;
+   int maxpathlinks;
+   int i;
+   int k;
+   int v;
 
-   conss = probdata->conss;
-   Nodes = probdata->Nodes;
-   Links = probdata->Links;
-   Flows = probdata->Flows;
-   nNodes = probdata->nNodes;
-   nOpticalNodes = probdata->nOpticalNodes;
    nLinks = probdata->nLinks;
    nOpticalLinks = probdata->nOpticalLinks;
    nFlows = probdata->nFlows;
-   nvars = probdata->nvars;
-   nCons = probdata->nCons;
+   nOriFlowVars = nLinks + 2*nOpticalLinks*nWaveLength;
+   maxpathlinks = probdata->nNodes * (nWaveLength+1);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &flowvars, nFlows) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &linkcost, nLinks) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &wavecost, nOpticalLinks*nWaveLength+1) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &residual, nLinks) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &waveused, nOpticalLinks*nWaveLength+1) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &order, nFlows) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &oriFlowVars, nOriFlowVars) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &pathlinks, maxpathlinks) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &pathwaves, maxpathlinks) );
+
+   for( i = 0; i < nLinks; i++ )
+      residual[i] = probdata->Links[i].Capacity;
+   for( i = 0; i < nOpticalLinks*nWaveLength; i++ )
+      waveused[i] = FALSE;
+   for( k = 0; k < nFlows; k++ )
+      order[k] = k;
+   SCIPsortInd(order, flowCompWeight, (void*)probdata->Flows, nFlows);
+
+   found = TRUE;
+   for( i = 0; i < nFlows && found; i++ )
+   {
+      k = order[i];
 
-   
-   /* create start solution using the artificial links */
-   for( i = 0; i < nFlows; i++ )
+      setStaticCosts(probdata, k, linkcost, wavecost, &opticalallowed);
+      for( v = nOpticalLinks; v < nLinks; v++ )
+      {
+         if( residual[v] < probdata->Flows[k].BandWidth )
+            linkcost[v] = SCIP_INVALID;
+      }
+      for( v = 0; v < nOpticalLinks*nWaveLength; v++ )
+      {
+         if( waveused[v] )
+            wavecost[v] = SCIP_INVALID;
+      }
+
+      SCIP_CALL( SCIPlayeredgraphShortestPath(graph, ws, probdata->Flows[k].Source, probdata->Flows[k].Destination,
+            linkcost, wavecost, opticalallowed, pathlinks, pathwaves, &npathlinks, &pathcost, &found) );
+      if( !found || !getPathVals(probdata, k, pathlinks, pathwaves, npathlinks, oriFlowVars) )
+      {
+         SCIPdebugMessage("greedy routing failed for flow %d\n", k);
+         found = FALSE;
+         break;
+      }
+
+      for( v = 0; v < npathlinks; v++ )
+      {
+         if( pathwaves[v] >= 0 )
+            waveused[pathlinks[v]*nWaveLength+pathwaves[v]] = TRUE;
+         else
+            residual[pathlinks[v]] -= probdata->Flows[k].BandWidth;
+      }
+
+      /* use the artificial or a path column of the flow if it has the same path */
+      flowvars[k] = NULL;
+      for( v = pathbeg[k+1] - 1; v >= pathbeg[k] - 1 && flowvars[k] == NULL; v-- )
+      {
+         var = (v == pathbeg[k] - 1 ? probdata->vars[k] : probdata->vars[v]);
+         vardata = SCIPvarGetData(var);
+         if( SCIPvardataEqualsOriFlowVars(vardata, oriFlowVars) )
+            flowvars[k] = var;
+      }
+      if( flowvars[k] == NULL )
+      {
+         SCIP_CALL( createPathColumn(scip, probdata, k, oriFlowVars, &flowvars[k]) );
+      }
+   }
+
+   if( found )
    {
-      // lambda_i_0 stands for the initial solution for i-th flow
-      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "lambda_%d_0", i);
+      SCIP_CALL( SCIPcreateOrigSol(scip, &sol, NULL) );
+      for( k = 0; k < nFlows; k++ )
+      {
+         SCIP_CALL( SCIPsetSolVal(scip, sol, flowvars[k], 1.0) );
+      }
+      SCIP_CALL( SCIPaddSolFree(scip, &sol, &stored) );
+      SCIPdebugMessage("greedy routing solution %s\n", stored ? "stored" : "rejected");
+   }
+
+   SCIPfreeBufferArray(scip, &pathwaves);
+   SCIPfreeBufferArray(scip, &pathlinks);
+   SCIPfreeBufferArray(scip, &oriFlowVars);
+   SCIPfreeBufferArray(scip, &order);
+   SCIPfreeBufferArray(scip, &waveused);
+   SCIPfreeBufferArray(scip, &residual);
+   SCIPfreeBufferArray(scip, &wavecost);
+   SCIPfreeBufferArray(scip, &linkcost);
+   SCIPfreeBufferArray(scip, &flowvars);
+
+   return SCIP_OKAY;
+}
+
+/** create initial columns */
+static
+SCIP_RETCODE createInitialColumns(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PROBDATA*        probdata            /**< problem data */
+   )
+{
+   SCIP_LAYEREDGRAPH* graph;
+   SCIP_LAYEREDGRAPHWS* ws;
+   SCIP_CLOCK* clock;
+   SCIP_Real timelimit;
+   SCIP_Bool greedy;
+   int* pathbeg;
+   int* oriFlowVars;
+   int nOriFlowVars;
+   int npaths;
+   int nLinks, nFlows;
+   int i;
+
+   nLinks = probdata->nLinks;
+   nFlows = probdata->nFlows;
+   nOriFlowVars = nLinks + 2 * probdata->nOpticalLinks * nWaveLength;
 
+   /* create start solution using the artificial links; the i-th artificial link belongs to the i-th flow, and
+    * lambda_i_0 stands for the initial solution of the i-th flow
+    */
+   SCIP_CALL( SCIPallocBufferArray(scip, &oriFlowVars, nOriFlowVars) );
+   for( i = 0; i < nFlows; i++ )
+   {
       SCIPdebugMessage("create variable for flow %d\n", i);
 
-      /* create variable for the artificial links */
-      // this function is defined in vardata_OAAR.c 
-      // get the i-th artificial link
-      tempLink = Links[nLinks - nFlows + i]; 
-      tempHeadNode = Nodes[tempLink.Head];
-      tempFlow = Flows[i];
-      // compute obj
-      tempDelay = tempHeadNode.ProcDelay + tempHeadNode.QueueDelay + 
-         tempLink.PropDelay + tempLink.TransDelay; 
-      tempJitter = tempHeadNode.Jitter;
-      tempPathCost = tempLink.BandCost;
-      obj = tempFlow.Priority * (tempDelay * tempFlow.DelayPrice + 
-         tempJitter * tempFlow.JitterPrice + tempPathCost * tempFlow.BandWidth);
-      SCIP_CALL( SCIPcreateVarOAAR(scip, &var, name, obj, TRUE, TRUE, NULL) );
-
-      /* add variable to the problem */
-      SCIP_CALL( SCIPaddVar(scip, var) );
-
-      /* store variable in the problme data */
-      SCIP_CALL( SCIPprobdataAddVar(scip, probdata, var) );
-
-      /* add variable to corresponding constraint */
-      // Cons1
-      SCIP_CALL( SCIPaddCoefSetppc(scip, conss[i], var) );
-      // Cons2. the initial vars do not appear in Cons3
-      // add codfficient for 
-      // nFlow(number of Cons1)+(nLinks-nOpticalLinks)(number of ElecLinks)-nFlow+i
-      SCIP_CALL( SCIPaddCoefKnapsack(scip, conss[nLinks - nOpticalLinks + i], var, tempFlow.BandWidth) );
-      // check if the previous deduction is correct
-      if( SCIPgetCapacityKnapsack(scip, conss[nLinks-nOpticalLinks+i]) != tempLink.Capacity ) 
-         SCIPdebugMessage("Initial column error!\n");
-
-      /* create the variable data for the variable;  */
-      // vardata contains the cons that the variable appears
-      tempConsIds[0] = i; tempConsIds[1] = nLinks-nOpticalLinks+i;
-      nOriFlowVars = nLinks + 2 * nOpticalLinks * nWaveLength;
-      SCIPallocBufferArray(scip, &oriFlowVars, nOriFlowVars);
-      memset(oriFlowVars, 0, nOriFlowVars);
+      BMSclearMemoryArray(oriFlowVars, nOriFlowVars);
       oriFlowVars[nLinks-nFlows+i] = 1;
-      SCIP_CALL( SCIPvardataCreateOAAR(scip, &vardata, tempConsIds, 2, oriFlowVars, nOriFlowVars) );
+      SCIP_CALL( createPathColumn(scip, probdata, i, oriFlowVars, NULL) );
+   }
+   SCIPfreeBufferArray(scip, &oriFlowVars);
 
-      /* add the variable data to the variable */
-      SCIPvarSetData(var, vardata);
+   /* the artificial columns have big-M costs; cheap paths let the first pricing rounds start from a useful LP */
+   SCIP_CALL( SCIPgetIntParam(scip, "reading/oaarreader/initpaths", &npaths) );
+   SCIP_CALL( SCIPgetRealParam(scip, "reading/oaarreader/initpathtime", &timelimit) );
+   SCIP_CALL( SCIPgetBoolParam(scip, "reading/oaarreader/greedy", &greedy) );
 
-      /* change the upper bound of the binary variable to lazy since the upper bound is already enforced
-       * due to the objective function the set covering constraint;
-       * The reason for doing is that, is to avoid the bound of x <= 1 in the LP relaxation since this bound
-       * constraint would produce a dual variable which might have a positive reduced cost
-       */
-      // such setting is suitable for my problem since the cons1 also force lambda <= 1
-      SCIP_CALL( SCIPchgVarUbLazy(scip, var, 1.0) );
+   if( npaths == 0 && !greedy )
+      return SCIP_OKAY;
 
-      /* release variable */
-      SCIP_CALL( SCIPreleaseVar(scip, &var) );
+   SCIP_CALL( SCIPcreateClock(scip, &clock) );
+   SCIP_CALL( SCIPstartClock(scip, clock) );
+   SCIP_CALL( SCIPlayeredgraphCreate(scip, &graph, probdata->Links, &probdata->Adjacency, probdata->nNodes,
+         probdata->nOpticalNodes, nLinks, probdata->nOpticalLinks) );
+   SCIP_CALL( SCIPlayeredgraphCreateWs(scip, graph, &ws) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &pathbeg, nFlows+1) );
 
-      SCIPfreeBufferArray(scip, &oriFlowVars);
+   if( npaths > 0 )
+   {
+      SCIP_CALL( createShortestPathColumns(scip, probdata, graph, ws, npaths, timelimit, clock, pathbeg) );
+   }
+   else
+   {
+      for( i = 0; i <= nFlows; i++ )
+         pathbeg[i] = probdata->nvars;
+   }
+   if( greedy )
+   {
+      SCIP_CALL( createGreedySolution(scip, probdata, graph, ws, pathbeg) );
    }
 
+   SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "created %d initial columns in %.2f seconds\n",
+      probdata->nvars, SCIPgetClockTime(scip, clock));
+
+   SCIPfreeBufferArray(scip, &pathbeg);
+   SCIPlayeredgraphFreeWs(scip, &ws);
+   SCIPlayeredgraphFree(scip, &graph);
+   SCIP_CALL( SCIPfreeClock(scip, &clock) );
+
    return SCIP_OKAY;
 }
 
@@ -320,11 +1153,12 @@ SCIP_DECL_PROBDELORIG(probdelorigOAAR)
 static
 SCIP_DECL_PROBTRANS(probtransOAAR)
 {
-   /* create transform probdata */
+   /* create transform probdata; it shares the topology of the original problem, which is freed after it */
    SCIP_CALL( probdataCreate(scip, targetdata, sourcedata->vars, sourcedata->conss, sourcedata->Nodes,
-         sourcedata->Links, sourcedata->Flows, sourcedata->nNodes, sourcedata->nOpticalNodes, 
-	 sourcedata->nLinks, sourcedata->nOpticalLinks, sourcedata->nFlows, 
+         sourcedata->Links, sourcedata->Flows, &sourcedata->Adjacency, sourcedata->Topology, sourcedata->nNodes,
+         sourcedata->nOpticalNodes, sourcedata->nLinks, sourcedata->nOpticalLinks, sourcedata->nFlows, 
 	 sourcedata->nvars, sourcedata->nCons, sourcedata->nFlowSol) );
+   (*targetdata)->varnames = sourcedata->varnames;
 
    /* transform all constraints */
    SCIP_CALL( SCIPtransformConss(scip, (*targetdata)->nCons, (*targetdata)->conss, (*targetdata)->conss) );
@@ -389,19 +1223,26 @@ SCIP_DECL_PROBEXITSOL(probexitsolOAAR)
  * @{
  */
 
-/** sets up the problem data */
-SCIP_RETCODE SCIPprobdataCreate(
+/** creates the problem, its constraints and initial columns and activates the pricer; the topology is copied if adj
+ *  is NULL and shared otherwise
+ */
+static
+SCIP_RETCODE setupProblem(
    SCIP*                 scip,               /**< SCIP data structure */
    const char*           probname,           /**< problem name */
    OAARNode*             Nodes,              /**< Nodes array */
    OAARLink*             Links,              /**< Links array */
    OAARFlow*             Flows,              /**< Flows array */
-   int                   nNodes,           
-   int                   nOpticalNodes,
-   int                   nLinks,
-   int                   nOpticalLinks,
-   int                   nFlows,
-   int                   nCons
+   OAARAdjacency*        adj,                /**< adjacency to share together with the arrays, or NULL */
+   int                   nNodes,             /**< number of Nodes */
+   int                   nOpticalNodes,      /**< number of optical nodes */
+   int                   nLinks,             /**< number of links, including the artificial ones */
+   int                   nOpticalLinks,      /**< number of optical links */
+   int                   nFlows,             /**< number of flows */
+   int                   nCons,              /**< number of constraints */
+   void*                 storage,            /**< storage of the shared arrays, or NULL */
+   size_t                storagesize,        /**< size of the storage in bytes */
+   SCIP_DECL_PROBDATASTORAGEFREE((*storagefree)) /**< frees the storage together with the problem, or NULL */
    )
 {
    SCIP_PROBDATA* probdata;
@@ -487,8 +1328,9 @@ SCIP_RETCODE SCIPprobdataCreate(
    
    /* create problem data */
    // no variable, and varssize is 0
-   SCIP_CALL( probdataCreate(scip, &probdata, NULL, conss, Nodes, Links, Flows, nNodes, nOpticalNodes,
+   SCIP_CALL( probdataCreate(scip, &probdata, NULL, conss, Nodes, Links, Flows, adj, NULL, nNodes, nOpticalNodes,
       nLinks, nOpticalLinks, nFlows, 0, nCons, nFlowSol) );
+   SCIP_CALL( SCIPgetBoolParam(scip, "reading/oaarreader/varnames", &probdata->varnames) );
 
    SCIP_CALL( createInitialColumns(scip, probdata) );
 
@@ -512,8 +1354,14 @@ SCIP_RETCODE SCIPprobdataCreate(
    /* set user problem data */
    SCIP_CALL( SCIPsetProbData(scip, probdata) );
 
-   SCIP_CALL( SCIPpricerOAARActivate(scip, conss, Nodes, Links, Flows, nNodes, nOpticalNodes,
-      nLinks, nOpticalLinks, nFlows, nCons) );
+   /* the storage belongs to the problem only from here on, so a caller frees it itself if an earlier step fails */
+   probdata->storage = storage;
+   probdata->storagesize = storagesize;
+   probdata->storagefree = storagefree;
+
+   /* the pricer uses the topology arrays of the problem data, which live as long as the problem */
+   SCIP_CALL( SCIPpricerOAARActivate(scip, conss, probdata->Nodes, probdata->Links, probdata->Flows,
+      probdata->Topology, nNodes, nOpticalNodes, nLinks, nOpticalLinks, nFlows, nCons) );
 
    /* free local buffer arrays */
    SCIPfreeBufferArray(scip, &conss);
@@ -522,6 +1370,60 @@ SCIP_RETCODE SCIPprobdataCreate(
    return SCIP_OKAY;
 }
 
+/** sets up the problem data */
+SCIP_RETCODE SCIPprobdataCreate(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const char*           probname,           /**< problem name */
+   OAARNode*             Nodes,              /**< Nodes array */
+   OAARLink*             Links,              /**< Links array */
+   OAARFlow*             Flows,              /**< Flows array */
+   int                   nNodes,           
+   int                   nOpticalNodes,
+   int                   nLinks,
+   int                   nOpticalLinks,
+   int                   nFlows,
+   int                   nCons
+   )
+{
+   SCIP_CALL( setupProblem(scip, probname, Nodes, Links, Flows, NULL, nNodes, nOpticalNodes, nLinks, nOpticalLinks,
+         nFlows, nCons, NULL, 0, NULL) );
+
+   return SCIP_OKAY;
+}
+
+/** sets up the problem data on topology arrays and an adjacency which are used in place instead of being copied, e.g.,
+ *  because they are mapped from a binary file; they must not change while the problem exists, and the storage holding
+ *  them is released by storagefree when the problem is freed
+ *
+ *  If the problem data cannot be attached to the problem, the method fails without taking over the storage, and the
+ *  caller has to release it.
+ */
+SCIP_RETCODE SCIPprobdataCreateShared(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const char*           probname,           /**< problem name */
+   OAARNode*             Nodes,              /**< Nodes array */
+   OAARLink*             Links,              /**< Links array, including the artificial links */
+   OAARFlow*             Flows,              /**< Flows array */
+   OAARAdjacency*        adj,                /**< out- and in-links of each node */
+   int                   nNodes,             /**< number of Nodes */
+   int                   nOpticalNodes,      /**< number of optical nodes */
+   int                   nLinks,             /**< number of links, including the artificial ones */
+   int                   nOpticalLinks,      /**< number of optical links */
+   int                   nFlows,             /**< number of flows */
+   int                   nCons,              /**< number of constraints */
+   void*                 storage,            /**< storage holding the arrays, passed to storagefree */
+   size_t                storagesize,        /**< size of the storage in bytes */
+   SCIP_DECL_PROBDATASTORAGEFREE((*storagefree)) /**< frees the storage together with the problem, or NULL */
+   )
+{
+   assert(adj != NULL);
+
+   SCIP_CALL( setupProblem(scip, probname, Nodes, Links, Flows, adj, nNodes, nOpticalNodes, nLinks, nOpticalLinks,
+         nFlows, nCons, storage, storagesize, storagefree) );
+
+   return SCIP_OKAY;
+}
+
 /** returns array of Nodes */
 OAARNode* SCIPprobdataGetNodes(
    SCIP_PROBDATA*        probdata            /**< problem data */
@@ -586,6 +1488,72 @@ int SCIPprobdataGetNFlows(
    return probdata->nFlows;
 }
 
+/** returns the out- and in-links of each node */
+OAARAdjacency* SCIPprobdataGetAdjacency(
+   SCIP_PROBDATA*        probdata            /**< problem data */
+   )
+{
+   return &probdata->Adjacency;
+}
+
+/** returns the links as struct of arrays with the static parts of their costs */
+OAARTopology* SCIPprobdataGetTopology(
+   SCIP_PROBDATA*        probdata            /**< problem data */
+   )
+{
+   return probdata->Topology;
+}
+
+/** returns whether the columns are named lambda_<flow>_<colid>; otherwise SCIP names them automatically */
+SCIP_Bool SCIPprobdataHasVarNames(
+   SCIP_PROBDATA*        probdata            /**< problem data */
+   )
+{
+   return probdata->varnames;
+}
+
+/** creates the compressed out- and in-link arrays of the topology */
+SCIP_RETCODE SCIPprobdataCreateAdjacency(
+   SCIP*                 scip,               /**< SCIP data structure */
+   OAARAdjacency*        adj,                /**< adjacency to fill */
+   OAARLink*             Links,              /**< Links array */
+   int                   nNodes,             /**< number of Nodes */
+   int                   nLinks,             /**< number of links */
+   int                   nOpticalLinks       /**< number of optical links */
+   )
+{
+   int* fill;
+
+   SCIP_CALL( SCIPallocMemoryArray(scip, &adj->OutBeg, nNodes+1) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &adj->OutOptEnd, nNodes) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &adj->OutLinks, nLinks) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &adj->InBeg, nNodes+1) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &adj->InOptEnd, nNodes) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &adj->InLinks, nLinks) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &fill, nNodes) );
+
+   fillAdjacency(Links, nNodes, nLinks, nOpticalLinks, TRUE, adj->OutBeg, adj->OutOptEnd, adj->OutLinks, fill);
+   fillAdjacency(Links, nNodes, nLinks, nOpticalLinks, FALSE, adj->InBeg, adj->InOptEnd, adj->InLinks, fill);
+
+   SCIPfreeBufferArray(scip, &fill);
+
+   return SCIP_OKAY;
+}
+
+/** frees the compressed out- and in-link arrays of the topology */
+void SCIPprobdataFreeAdjacency(
+   SCIP*                 scip,               /**< SCIP data structure */
+   OAARAdjacency*        adj                 /**< adjacency to free */
+   )
+{
+   SCIPfreeMemoryArray(scip, &adj->InLinks);
+   SCIPfreeMemoryArray(scip, &adj->InOptEnd);
+   SCIPfreeMemoryArray(scip, &adj->InBeg);
+   SCIPfreeMemoryArray(scip, &adj->OutLinks);
+   SCIPfreeMemoryArray(scip, &adj->OutOptEnd);
+   SCIPfreeMemoryArray(scip, &adj->OutBeg);
+}
+
 /** returns array of all variables itemed in the way they got generated */
 SCIP_VAR** SCIPprobdataGetVars(
    SCIP_PROBDATA*        probdata            /**< problem data */
@@ -625,6 +1593,43 @@ int* SCIPprobdataGetNFlowSol(
    return probdata->nFlowSol;
 }
 
+/** returns the number of columns of flow k */
+int SCIPprobdataGetNFlowVars(
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int                   k                   /**< index of the flow */
+   )
+{
+   return probdata->flowcols[k].ncols;
+}
+
+/** returns the positions of the columns of flow k in the variable array; they are sorted */
+int* SCIPprobdataGetFlowVars(
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int                   k                   /**< index of the flow */
+   )
+{
+   return probdata->flowcols[k].cols;
+}
+
+/** returns the bitmap of the columns of flow k in which the original variable j is one, or NULL if it is zero in all
+ *  of them; bit c % 64 of word c / 64 belongs to the c-th column of the flow
+ */
+uint64_t* SCIPprobdataGetFlowVarBits(
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int                   k,                  /**< index of the flow */
+   int                   j                   /**< index of the original variable */
+   )
+{
+   FLOWCOLS* fc;
+   int r;
+
+   fc = &probdata->flowcols[k];
+   if( !SCIPsortedvecFindInt(fc->rowidx, j, fc->nrows, &r) )
+      return NULL;
+
+   return fc->rowbits[r];
+}
+
 /** adds given variable to the problem data */
 SCIP_RETCODE SCIPprobdataAddVar(
    SCIP*                 scip,               /**< SCIP data structure */
@@ -632,9 +1637,9 @@ SCIP_RETCODE SCIPprobdataAddVar(
    SCIP_VAR*             var                 /**< variables to add */
    )
 {
-   char* varname;
-   int varSup, varSub;
-   
+   SCIP_VARDATA* vardata;
+   int flow;
+
    /* check if enough memory is left */
    if( probdata->varssize == probdata->nvars )
    {
@@ -648,18 +1653,19 @@ SCIP_RETCODE SCIPprobdataAddVar(
    probdata->vars[probdata->nvars] = var;
    probdata->nvars++;
 
-   varname = SCIPvarGetName(var);
-   sscanf(varname, "lambda_%d_%d", &varSup, &varSub);
-   
-   if(varSub != probdata->nFlowSol[varSup])
+   vardata = SCIPvarGetData(var);
+   flow = SCIPvardataGetFlow(vardata);
+
+   if( SCIPvardataGetColid(vardata) != probdata->nFlowSol[flow] )
    {
-      SCIPdebugMessage("The subscript of the new variable lambda_%d_%d is incorrect!\n", 
-         varSup, varSub);
+      SCIPdebugMessage("The column id %d of the new variable of flow %d is incorrect!\n",
+         SCIPvardataGetColid(vardata), flow);
    }
-   probdata->nFlowSol[varSup]++;
+   probdata->nFlowSol[flow]++;
 
+   SCIP_CALL( flowcolsAddVar(scip, probdata, probdata->nvars - 1) );
 
-   SCIPdebugMessage("added variable %s to probdata; nvars = %d\n", varname, probdata->nvars);
+   SCIPdebugMessage("added variable %s to probdata; nvars = %d\n", SCIPvarGetName(var), probdata->nvars);
 
    return SCIP_OKAY;
 }
@@ -10,9 +10,20 @@
 #ifndef __SCIP_PROBDATA_BINPACKING__
 #define __SCIP_PROBDATA_BINPACKING__
 
+#include <stdint.h>
+
 #include "scip/scip.h"
 #include "OAARdataStructure.h"
 
+/** frees the storage of topology arrays which are shared with the problem data
+ *
+ *  input:
+ *  - scip            : SCIP main data structure
+ *  - storage         : storage passed to SCIPprobdataCreateShared()
+ *  - size            : size of the storage in bytes
+ */
+#define SCIP_DECL_PROBDATASTORAGEFREE(x) void x (SCIP* scip, void* storage, size_t size)
+
 /** sets up the problem data */
 extern
 SCIP_RETCODE SCIPprobdataCreate(
@@ -29,6 +40,29 @@ SCIP_RETCODE SCIPprobdataCreate(
    int                   nCons
    );
 
+/** sets up the problem data on topology arrays and an adjacency which are used in place instead of being copied, e.g.,
+ *  because they are mapped from a binary file; they must not change while the problem exists, and the storage holding
+ *  them is released by storagefree when the problem is freed
+ */
+extern
+SCIP_RETCODE SCIPprobdataCreateShared(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const char*           probname,           /**< problem name */
+   OAARNode*             Nodes,              /**< Nodes array */
+   OAARLink*             Links,              /**< Links array, including the artificial links */
+   OAARFlow*             Flows,              /**< Flows array */
+   OAARAdjacency*        adj,                /**< out- and in-links of each node */
+   int                   nNodes,             /**< number of Nodes */
+   int                   nOpticalNodes,      /**< number of optical nodes */
+   int                   nLinks,             /**< number of links, including the artificial ones */
+   int                   nOpticalLinks,      /**< number of optical links */
+   int                   nFlows,             /**< number of flows */
+   int                   nCons,              /**< number of constraints */
+   void*                 storage,            /**< storage holding the arrays, passed to storagefree */
+   size_t                storagesize,        /**< size of the storage in bytes */
+   SCIP_DECL_PROBDATASTORAGEFREE((*storagefree)) /**< frees the storage together with the problem, or NULL */
+   );
+
 /** returns array of Nodes */
 extern
 OAARNode* SCIPprobdataGetNodes(
@@ -77,6 +111,42 @@ int SCIPprobdataGetNFlows(
    SCIP_PROBDATA*        probdata
    );
 
+/** returns the out- and in-links of each node */
+extern
+OAARAdjacency* SCIPprobdataGetAdjacency(
+   SCIP_PROBDATA*        probdata            /**< problem data */
+   );
+
+/** returns the links as struct of arrays with the static parts of their costs */
+extern
+OAARTopology* SCIPprobdataGetTopology(
+   SCIP_PROBDATA*        probdata            /**< problem data */
+   );
+
+/** returns whether the columns are named lambda_<flow>_<colid>; otherwise SCIP names them automatically */
+extern
+SCIP_Bool SCIPprobdataHasVarNames(
+   SCIP_PROBDATA*        probdata            /**< problem data */
+   );
+
+/** creates the compressed out- and in-link arrays of the topology */
+extern
+SCIP_RETCODE SCIPprobdataCreateAdjacency(
+   SCIP*                 scip,               /**< SCIP data structure */
+   OAARAdjacency*        adj,                /**< adjacency to fill */
+   OAARLink*             Links,              /**< Links array */
+   int                   nNodes,             /**< number of Nodes */
+   int                   nLinks,             /**< number of links */
+   int                   nOpticalLinks       /**< number of optical links */
+   );
+
+/** frees the compressed out- and in-link arrays of the topology */
+extern
+void SCIPprobdataFreeAdjacency(
+   SCIP*                 scip,               /**< SCIP data structure */
+   OAARAdjacency*        adj                 /**< adjacency to free */
+   );
+
 /** returns array of all variables itemed in the way they got generated */
 extern
 SCIP_VAR** SCIPprobdataGetVars(
@@ -106,6 +176,30 @@ int* SCIPprobdataGetNFlowSol(
    SCIP_PROBDATA*       probdata
    );
 
+/** returns the number of columns of flow k */
+extern
+int SCIPprobdataGetNFlowVars(
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int                   k                   /**< index of the flow */
+   );
+
+/** returns the positions of the columns of flow k in the variable array; they are sorted */
+extern
+int* SCIPprobdataGetFlowVars(
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int                   k                   /**< index of the flow */
+   );
+
+/** returns the bitmap of the columns of flow k in which the original variable j is one, or NULL if it is zero in all
+ *  of them; bit c % 64 of word c / 64 belongs to the c-th column of the flow
+ */
+extern
+uint64_t* SCIPprobdataGetFlowVarBits(
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int                   k,                  /**< index of the flow */
+   int                   j                   /**< index of the original variable */
+   );
+
 /** adds given variable to the problem data */
 extern
 SCIP_RETCODE SCIPprobdataAddVar(
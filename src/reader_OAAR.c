@@ -4,15 +4,35 @@
  *
  * Read data from oaar format files and pass all the data to function SCIPprobdataCreate, which
  * initialize the master problem.
+ *
+ * Uncompressed files are memory mapped and parsed in a single pass by a hand-written scanner; compressed files are read
+ * through SCIPfopen() into memory first and parsed by the same scanner. Lines starting with '#' and empty lines are
+ * skipped; every other line holds one record, and tokens after the expected fields are ignored.
+ *
+ * A second reader handles demand files (.oaard), which contain only the problem name, the number of flows and the
+ * flows. They are solved on the topology given by the parameter reading/oaardreader/topology, an .oaar file whose
+ * flows are ignored. The parsed topology and its adjacency are kept by the reader and reused as long as the parameter
+ * names the same, unchanged file, so a batch of demand files parses the topology only once. The problems share the
+ * cached nodes and adjacency; only the links are copied, since the artificial link of each flow is appended to them.
  */
 
 /*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
 
-#define SCIP_DEBUG
+//#define SCIP_DEBUG
 
 #include <assert.h>
+#include <limits.h>
+#include <math.h>
 #include <string.h>
 
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define OAAR_MMAP
+#endif
+
 //#include "scip/cons_setppc.h"
 
 #include "probdata_OAAR.h"
@@ -27,217 +47,950 @@
 #define READER_DESC             "file reader for OAAR data format"
 #define READER_EXTENSION        "oaar"
 
+#define DEFAULT_INITPATHS       3        /**< number of cheapest paths per flow added as initial columns */
+#define DEFAULT_INITPATHTIME    10.0     /**< time limit in seconds for computing the initial paths */
+#define DEFAULT_GREEDY          TRUE     /**< should a greedy routing of the flows be passed as starting solution? */
+#define DEFAULT_VARNAMES        TRUE     /**< should the columns be named lambda_<flow>_<colid>? */
+
+#define DEMANDREADER_NAME       "oaardreader"
+#define DEMANDREADER_DESC       "file reader for OAAR demand files on a cached topology"
+#define DEMANDREADER_EXTENSION  "oaard"
+
+#define DEFAULT_TOPOLOGY        ""       /**< .oaar file with the topology of the demand files */
+
 /**@} */
 
 
-/**@name Callback methods
+/**@name Local methods
  *
  * @{
  */
 
-/** problem reading method of reader */
+/** scanner over the contents of an .oaar file */
+typedef struct OaarScanner
+{
+   const char*           pos;                /**< current position */
+   const char*           end;                /**< end of the data */
+   const char*           linestart;          /**< start of the current line */
+   int                   lineno;             /**< number of the current line */
+   const char*           filename;           /**< name of the file, for error messages */
+} OAARSCANNER;
+
+/** topology parsed from a topology file, shared by all problems read from demand files on it */
+typedef struct OaarTopology
+{
+   char*                 filename;           /**< name of the topology file */
+   SCIP_Bool             hasstamp;           /**< are size and modification time of the file known? */
+   SCIP_Longint          filesize;           /**< size of the file when it was parsed */
+   SCIP_Longint          filemtime;          /**< modification time of the file when it was parsed */
+   OAARNode*             Nodes;              /**< Nodes array */
+   OAARLink*             Links;              /**< Links array, without artificial links */
+   OAARAdjacency         Adjacency;          /**< out- and in-links of each node */
+   int                   nNodes;             /**< number of nodes */
+   int                   nOpticalNodes;      /**< number of optical nodes */
+   int                   nLinks;             /**< number of links */
+   int                   nOpticalLinks;      /**< number of optical links */
+   int                   nuses;              /**< number of problems using the topology, plus one while it is cached */
+} OAARTOPOLOGY;
+
+/** arrays of a problem read from a demand file, freed together with the problem */
+typedef struct OaarDemand
+{
+   OAARTOPOLOGY*         topology;           /**< topology of the problem */
+   OAARLink*             Links;              /**< links of the topology followed by the artificial link of each flow */
+   OAARFlow*             Flows;              /**< Flows array */
+   OAARAdjacency         Adjacency;          /**< out- and in-links of each node, including the artificial links */
+} OAARDEMAND;
+
+/** data of the demand file reader */
+struct SCIP_ReaderData
+{
+   OAARTOPOLOGY*         topology;           /**< cached topology, or NULL */
+   char*                 topologyfile;       /**< name of the topology file of the demand files */
+};
+
+/** returns whether c separates two tokens on a line */
 static
-SCIP_DECL_READERREAD(readerReadOAAR)
-{  /*lint --e{715}*/
-   SCIP_FILE* file;
-   int nread;
-   int lineno;
-   char format[16];
-   char buffer[SCIP_MAXSTRLEN];
-   int i,j;
-   
-   char probName[SCIP_MAXSTRLEN];
-   OAARNode* Nodes;
-   OAARLink* Links;
-   OAARFlow*  Flows;
-   int nNodes;
-   int nOpticalNodes;
-   int nLinks;
-   int nOpticalLinks;
-   int nFlows;
-   int nCons;
+SCIP_Bool isBlank(
+   char                  c                   /**< character */
+   )
+{
+   return c == ' ' || c == '\t' || c == '\r';
+}
 
-   *result = SCIP_DIDNOTRUN;
+/** skips blanks on the current line */
+static
+void skipBlanks(
+   OAARSCANNER*          scanner             /**< scanner */
+   )
+{
+   while( scanner->pos < scanner->end && isBlank(*scanner->pos) )
+      scanner->pos++;
+}
 
-   /* open file */
-   file = SCIPfopen(filename, "r");
-   if( file == NULL )
+/** returns whether the scanner is at the end of a token */
+static
+SCIP_Bool atTokenEnd(
+   OAARSCANNER*          scanner             /**< scanner */
+   )
+{
+   return scanner->pos == scanner->end || *scanner->pos == '\n' || isBlank(*scanner->pos);
+}
+
+/** moves to the first token of the next line which is neither empty nor a comment; returns FALSE at the end of the
+ *  data
+ */
+static
+SCIP_Bool nextRecord(
+   OAARSCANNER*          scanner             /**< scanner */
+   )
+{
+   const char* newline;
+
+   /* skip the rest of the current line */
+   if( scanner->lineno > 0 )
    {
-      SCIPerrorMessage("cannot open file <%s> for reading\n", filename);
-      SCIPprintSysError(filename);
-      return SCIP_NOFILE;
+      newline = (const char*)memchr(scanner->pos, '\n', (size_t)(scanner->end - scanner->pos));
+      scanner->pos = newline == NULL ? scanner->end : newline + 1;
    }
 
-   lineno = 0;
+   while( scanner->pos < scanner->end )
+   {
+      scanner->linestart = scanner->pos;
+      scanner->lineno++;
+
+      skipBlanks(scanner);
+      if( scanner->pos < scanner->end && *scanner->pos != '\n' && *scanner->pos != '#' )
+         return TRUE;
 
-   /* read problem name */
-   if( !SCIPfeof(file) )
+      newline = (const char*)memchr(scanner->pos, '\n', (size_t)(scanner->end - scanner->pos));
+      scanner->pos = newline == NULL ? scanner->end : newline + 1;
+   }
+
+   return FALSE;
+}
+
+/** reports a syntax error in the current line */
+static
+void syntaxError(
+   SCIP*                 scip,               /**< SCIP data structure */
+   OAARSCANNER*          scanner,            /**< scanner */
+   const char*           expected            /**< description of the expected data */
+   )
+{
+   const char* lineend;
+
+   if( scanner->linestart == NULL || scanner->linestart >= scanner->end )
    {
-      /* get next line */
-      do{ 
-         if( SCIPfgets(buffer, sizeof(buffer), file) == NULL )
-            return SCIP_READERROR;
-         lineno++;
-      } while ( buffer[0] == '#' );
+      SCIPerrorMessage("unexpected end of file <%s> after line %d: expected %s\n", scanner->filename, scanner->lineno,
+         expected);
+      return;
+   }
 
-      sprintf(format, "%%%ds\n", SCIP_MAXSTRLEN);
-      nread = sscanf(buffer, format, probName);
-      if( nread == 0 )
-      {
-         SCIPwarningMessage(scip, "invalid input line %d in file <%s>: <%s>\n", lineno, filename, buffer);
-         return SCIP_READERROR;
-      }
+   lineend = (const char*)memchr(scanner->linestart, '\n', (size_t)(scanner->end - scanner->linestart));
+   if( lineend == NULL )
+      lineend = scanner->end;
+
+   SCIPerrorMessage("invalid input line %d in file <%s>: expected %s: <%.*s>\n", scanner->lineno, scanner->filename,
+      expected, (int)MIN(lineend - scanner->linestart, SCIP_MAXSTRLEN), scanner->linestart);
+}
+
+/** parses an integer of the current line */
+static
+SCIP_Bool scanInt(
+   OAARSCANNER*          scanner,            /**< scanner */
+   int*                  val                 /**< pointer to store the value */
+   )
+{
+   SCIP_Longint v;
+   SCIP_Bool negative;
+   const char* start;
 
-      SCIPdebugMessage("problem name <%s>\n", probName);
+   skipBlanks(scanner);
+
+   negative = FALSE;
+   if( scanner->pos < scanner->end && (*scanner->pos == '-' || *scanner->pos == '+') )
+   {
+      negative = (*scanner->pos == '-');
+      scanner->pos++;
    }
 
-   /* read nNodes and nOpticalNodes */
-   if( !SCIPfeof(file) )
+   v = 0;
+   start = scanner->pos;
+   while( scanner->pos < scanner->end && *scanner->pos >= '0' && *scanner->pos <= '9' )
    {
-      /* get next line */
-      do{
-         if( SCIPfgets(buffer, sizeof(buffer), file) == NULL )
-            return SCIP_READERROR;
-         lineno++;
-      } while ( buffer[0] == '#' );
+      v = 10 * v + (*scanner->pos - '0');
+      if( v > INT_MAX )
+         return FALSE;
+      scanner->pos++;
+   }
 
-      nread = sscanf(buffer, "%d %d %d %d %d\n", &nNodes, &nOpticalNodes, &nLinks, &nOpticalLinks, &nFlows);
-      if( nread == 0 )
+   if( scanner->pos == start || !atTokenEnd(scanner) )
+      return FALSE;
+
+   *val = (int)(negative ? -v : v);
+
+   return TRUE;
+}
+
+/** parses a real number of the current line, in fixed or exponential notation */
+static
+SCIP_Bool scanReal(
+   OAARSCANNER*          scanner,            /**< scanner */
+   SCIP_Real*            val                 /**< pointer to store the value */
+   )
+{
+   static const SCIP_Real pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14,
+      1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+   unsigned long long mantissa;
+   SCIP_Bool negative;
+   SCIP_Bool expnegative;
+   int ndigits;
+   int exponent;
+   int e;
+
+   skipBlanks(scanner);
+
+   negative = FALSE;
+   if( scanner->pos < scanner->end && (*scanner->pos == '-' || *scanner->pos == '+') )
+   {
+      negative = (*scanner->pos == '-');
+      scanner->pos++;
+   }
+
+   /* the first 19 significant digits are kept in the mantissa, further ones only shift the exponent */
+   mantissa = 0;
+   ndigits = 0;
+   exponent = 0;
+   while( scanner->pos < scanner->end && *scanner->pos >= '0' && *scanner->pos <= '9' )
+   {
+      if( mantissa < 1000000000000000000ULL )
+         mantissa = 10 * mantissa + (unsigned long long)(*scanner->pos - '0');
+      else
+         exponent++;
+      ndigits++;
+      scanner->pos++;
+   }
+   if( scanner->pos < scanner->end && *scanner->pos == '.' )
+   {
+      scanner->pos++;
+      while( scanner->pos < scanner->end && *scanner->pos >= '0' && *scanner->pos <= '9' )
       {
-         SCIPwarningMessage(scip, "invalid input line %d in file <%s>: <%s>\n", lineno, filename, buffer);
-         return SCIP_READERROR;
+         if( mantissa < 1000000000000000000ULL )
+         {
+            mantissa = 10 * mantissa + (unsigned long long)(*scanner->pos - '0');
+            exponent--;
+         }
+         ndigits++;
+         scanner->pos++;
+      }
+   }
+   if( ndigits == 0 )
+      return FALSE;
+
+   if( scanner->pos < scanner->end && (*scanner->pos == 'e' || *scanner->pos == 'E') )
+   {
+      scanner->pos++;
+      expnegative = FALSE;
+      if( scanner->pos < scanner->end && (*scanner->pos == '-' || *scanner->pos == '+') )
+      {
+         expnegative = (*scanner->pos == '-');
+         scanner->pos++;
+      }
+      if( scanner->pos == scanner->end || *scanner->pos < '0' || *scanner->pos > '9' )
+         return FALSE;
+      e = 0;
+      while( scanner->pos < scanner->end && *scanner->pos >= '0' && *scanner->pos <= '9' )
+      {
+         if( e < 10000 )
+            e = 10 * e + (*scanner->pos - '0');
+         scanner->pos++;
       }
+      exponent += expnegative ? -e : e;
+   }
+
+   if( !atTokenEnd(scanner) )
+      return FALSE;
 
-      SCIPdebugMessage("nNodes = <%d>, nOpticalNodes = <%d>, nLinks = <%d>, nOpticalLinks = <%d>, nFlows = <%d>\n", nNodes, nOpticalNodes, nLinks, nOpticalLinks, nFlows);
+   /* mantissa and power of ten are exact in the common case, hence the result is correctly rounded */
+   *val = (SCIP_Real)mantissa;
+   if( exponent < 0 )
+      *val = (-exponent <= 22) ? *val / pow10[-exponent] : *val / pow(10.0, (double)-exponent);
+   else if( exponent > 0 )
+      *val = (exponent <= 22) ? *val * pow10[exponent] : *val * pow(10.0, (double)exponent);
+   if( negative )
+      *val = -*val;
+
+   return TRUE;
+}
+
+/** parses a word of the current line */
+static
+SCIP_Bool scanWord(
+   OAARSCANNER*          scanner,            /**< scanner */
+   char*                 word,               /**< buffer to store the word */
+   int                   size                /**< size of the buffer */
+   )
+{
+   int len;
+
+   skipBlanks(scanner);
+
+   len = 0;
+   while( !atTokenEnd(scanner) )
+   {
+      if( len < size - 1 )
+         word[len++] = *scanner->pos;
+      scanner->pos++;
    }
+   word[len] = '\0';
 
+   return len > 0;
+}
 
-   /* allocate memory for Nodes */
-   SCIP_CALL( SCIPallocBufferArray(scip, &Nodes, nNodes) );
+/** parses the flows of an .oaar or .oaard file into the given array */
+static
+SCIP_RETCODE parseFlows(
+   SCIP*                 scip,               /**< SCIP data structure */
+   OAARSCANNER*          scanner,            /**< scanner before the first flow */
+   OAARFlow*             Flows,              /**< array to store the flows */
+   int                   nFlows,             /**< number of flows */
+   int                   nNodes              /**< number of nodes of the topology */
+   )
+{
+   OAARFlow* flow;
+   int i;
 
-   for( i = 0; i < nNodes; i++ )
+   for( i = 0; i < nFlows; i++ )
    {
-      /* get next line */
-      do{
-         if( SCIPfgets(buffer, sizeof(buffer), file) == NULL )
-            return SCIP_READERROR;
-         lineno++;
-      } while ( buffer[0] == '#' );
+      flow = &Flows[i];
 
-      /* parse the line */
-      nread = sscanf(buffer, "%lf %lf %lf %d\n", &(Nodes[i].ProcDelay), 
-         &(Nodes[i].QueueDelay), &(Nodes[i].Jitter), &(Nodes[i].IsOptical));
-      if( nread == 0 )
+      if( !nextRecord(scanner) || !scanInt(scanner, &flow->Source) || !scanInt(scanner, &flow->Destination)
+         || !scanReal(scanner, &flow->Priority) || !scanInt(scanner, &flow->BandWidth)
+         || !scanReal(scanner, &flow->DelayPrice) || !scanReal(scanner, &flow->JitterPrice)
+         || flow->Source < 0 || flow->Source >= nNodes || flow->Destination < 0 || flow->Destination >= nNodes )
       {
-         SCIPwarningMessage(scip, "invalid input line %d in file <%s>: <%s>\n", lineno, filename, buffer);
+         syntaxError(scip, scanner, "si di pi BandWidthi DelayPricei JitterPricei of a flow");
          return SCIP_READERROR;
       }
+   }
+
+   return SCIP_OKAY;
+}
+
+/** parses problem name, sizes, nodes and links of an .oaar file; the arrays are allocated here and have to be freed by
+ *  the caller, also if an error occurred
+ */
+static
+SCIP_RETCODE parseTopology(
+   SCIP*                 scip,               /**< SCIP data structure */
+   OAARSCANNER*          scanner,            /**< scanner at the beginning of the data */
+   char*                 probName,           /**< buffer of size SCIP_MAXSTRLEN to store the problem name */
+   OAARNode**            Nodes,              /**< pointer to store the nodes */
+   OAARLink**            Links,              /**< pointer to store the links */
+   int*                  nNodes,             /**< pointer to store the number of nodes */
+   int*                  nOpticalNodes,      /**< pointer to store the number of optical nodes */
+   int*                  nLinks,             /**< pointer to store the number of links */
+   int*                  nOpticalLinks,      /**< pointer to store the number of optical links */
+   int*                  nFlows,             /**< pointer to store the number of flows */
+   SCIP_Bool             flowlinks           /**< should the links array get room for the artificial links? */
+   )
+{
+   OAARNode* node;
+   OAARLink* link;
+   int i;
 
-      // get next line
-      do{
-         if( SCIPfgets(buffer, sizeof(buffer), file) == NULL )
-            return SCIP_READERROR;
-         lineno++;
-      } while ( buffer[0] == '#' );
+   /* problem name */
+   if( !nextRecord(scanner) || !scanWord(scanner, probName, SCIP_MAXSTRLEN) )
+   {
+      syntaxError(scip, scanner, "the problem name");
+      return SCIP_READERROR;
+   }
+   SCIPdebugMessage("problem name <%s>\n", probName);
 
-      // parse the line
-      nread = sscanf(buffer, "%d %s\n", &(Nodes[i].nConnLinks), buffer);
-      if( nread == 0 )
+   /* sizes */
+   if( !nextRecord(scanner) || !scanInt(scanner, nNodes) || !scanInt(scanner, nOpticalNodes)
+      || !scanInt(scanner, nLinks) || !scanInt(scanner, nOpticalLinks) || !scanInt(scanner, nFlows)
+      || *nNodes < 0 || *nOpticalNodes < 0 || *nOpticalNodes > *nNodes || *nLinks < 0 || *nOpticalLinks < 0
+      || *nOpticalLinks > *nLinks || *nFlows < 0 || *nLinks > INT_MAX - *nFlows )
+   {
+      syntaxError(scip, scanner, "nNodes nOpticalNodes nLinks nOpticalLinks nFlows");
+      return SCIP_READERROR;
+   }
+   SCIPdebugMessage("nNodes = <%d>, nOpticalNodes = <%d>, nLinks = <%d>, nOpticalLinks = <%d>, nFlows = <%d>\n",
+      *nNodes, *nOpticalNodes, *nLinks, *nOpticalLinks, *nFlows);
+
+   /* we allocate extra nFlows links for the artificial links */
+   SCIP_CALL( SCIPallocMemoryArray(scip, Nodes, MAX(*nNodes, 1)) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, Links, MAX(*nLinks + (flowlinks ? *nFlows : 0), 1)) );
+
+   for( i = 0; i < *nNodes; i++ )
+   {
+      node = &(*Nodes)[i];
+
+      if( !nextRecord(scanner) || !scanReal(scanner, &node->ProcDelay) || !scanReal(scanner, &node->QueueDelay)
+         || !scanReal(scanner, &node->Jitter) || !scanInt(scanner, &node->IsOptical) )
       {
-         SCIPwarningMessage(scip, "invalid input line %d in file <%s>: <%s>\n", lineno, filename, buffer);
-	 return SCIP_READERROR;
+         syntaxError(scip, scanner, "ProcDelay QueueDelay Jitter IsOptical of a node");
+         return SCIP_READERROR;
       }
-      SCIP_CALL( SCIPallocBufferArray(scip, &(Nodes[i].ConnLinks), Nodes[i].nConnLinks) );
-      for( j = 0; j < Nodes[i].nConnLinks; j++ )
+
+      /* only the degree is kept, the adjacency is built from the links by the problem data */
+      if( !nextRecord(scanner) || !scanInt(scanner, &node->nConnLinks) )
       {
-         nread == sscanf(buffer, "%d %s", &Nodes[i].ConnLinks[j], buffer);
-	 if( nread == 0 )
-	 {
-	    SCIPwarningMessage(scip, "invalid input line %d in file <%s>: <%s>\n", lineno, filename, buffer);
-	    return SCIP_READERROR;
-	 }
+         syntaxError(scip, scanner, "the number of links of a node");
+         return SCIP_READERROR;
       }
-      
-      SCIPdebugMessage("Read node %d\n", i);
    }
 
-   /* allocate memory for Links */
-   // we allocate extra nFlows for artificial links
-   SCIP_CALL( SCIPallocBufferArray(scip, &Links, nLinks+nFlows) );
-
-   for( i = 0; i < nLinks; i++ )
+   for( i = 0; i < *nLinks; i++ )
    {
-      /* get next line */
-      do{
-         if( SCIPfgets(buffer, sizeof(buffer), file) == NULL )
-            return SCIP_READERROR;
-         lineno++;
-      } while ( buffer[0] == '#' );
+      link = &(*Links)[i];
 
-      /* parse the line */
-      nread = sscanf(buffer, "%d %lf %lf %d\n", &(Links[i].Capacity), 
-         &(Links[i].PropDelay), &(Links[i].BandCost), &(Links[i].IsOptical));
-      if( nread == 0 )
+      if( !nextRecord(scanner) || !scanInt(scanner, &link->Capacity) || !scanReal(scanner, &link->PropDelay)
+         || !scanReal(scanner, &link->BandCost) || !scanInt(scanner, &link->IsOptical) )
       {
-         SCIPwarningMessage(scip, "invalid input line %d in file <%s>: <%s>\n", lineno, filename, buffer);
+         syntaxError(scip, scanner, "Capacity PropDelay BandCost IsOptical of a link");
          return SCIP_READERROR;
       }
-      if(Links[i].IsOptical)
-         Links[i].TransDelay = 0;
+      if( link->IsOptical )
+         link->TransDelay = 0;
+      else if( link->Capacity > 0 )
+         link->TransDelay = 1500 * 8 / link->Capacity;
       else
-         Links[i].TransDelay = 1500 * 8 / Links[i].Capacity;
-
-      // get next line
-      do{
-         if( SCIPfgets(buffer, sizeof(buffer), file) == NULL )
-            return SCIP_READERROR;
-         lineno++;
-      } while ( buffer[0] == '#' );
-
-      // parse the line
-      nread = sscanf(buffer, "%d %d\n", &(Links[i].Head), &(Links[i].Tail));
-      if( nread == 0 )
       {
-         SCIPwarningMessage(scip, "invalid input line %d in file <%s>: <%s>\n", lineno, filename, buffer);
-	 return SCIP_READERROR;
+         syntaxError(scip, scanner, "a positive capacity of an electrical link");
+         return SCIP_READERROR;
+      }
+
+      if( !nextRecord(scanner) || !scanInt(scanner, &link->Head) || !scanInt(scanner, &link->Tail)
+         || link->Head < 0 || link->Head >= *nNodes || link->Tail < 0 || link->Tail >= *nNodes )
+      {
+         syntaxError(scip, scanner, "the end nodes of a link");
+         return SCIP_READERROR;
       }
-            
-      SCIPdebugMessage("Read link %d\n", i);
    }
 
-   // alloc memory for Flows
-   SCIP_CALL( SCIPallocBufferArray(scip, &Flows, nFlows) );
+   return SCIP_OKAY;
+}
+
+/** parses the contents of an .oaar file; the arrays are allocated here and have to be freed by the caller, also if an
+ *  error occurred; the links array has room for the artificial links of the flows
+ */
+static
+SCIP_RETCODE parseProblem(
+   SCIP*                 scip,               /**< SCIP data structure */
+   OAARSCANNER*          scanner,            /**< scanner at the beginning of the data */
+   char*                 probName,           /**< buffer of size SCIP_MAXSTRLEN to store the problem name */
+   OAARNode**            Nodes,              /**< pointer to store the nodes */
+   OAARLink**            Links,              /**< pointer to store the links */
+   OAARFlow**            Flows,              /**< pointer to store the flows */
+   int*                  nNodes,             /**< pointer to store the number of nodes */
+   int*                  nOpticalNodes,      /**< pointer to store the number of optical nodes */
+   int*                  nLinks,             /**< pointer to store the number of links */
+   int*                  nOpticalLinks,      /**< pointer to store the number of optical links */
+   int*                  nFlows              /**< pointer to store the number of flows */
+   )
+{
+   SCIP_CALL( parseTopology(scip, scanner, probName, Nodes, Links, nNodes, nOpticalNodes, nLinks, nOpticalLinks,
+         nFlows, TRUE) );
 
-   // read Flow
-   for( i = 0; i < nFlows; i++ )
+   SCIP_CALL( SCIPallocMemoryArray(scip, Flows, MAX(*nFlows, 1)) );
+   SCIP_CALL( parseFlows(scip, scanner, *Flows, *nFlows, *nNodes) );
+
+   return SCIP_OKAY;
+}
+
+/** parses the contents of an .oaard file; the flows array is allocated here and has to be freed by the caller, also if
+ *  an error occurred
+ */
+static
+SCIP_RETCODE parseDemand(
+   SCIP*                 scip,               /**< SCIP data structure */
+   OAARSCANNER*          scanner,            /**< scanner at the beginning of the data */
+   char*                 probName,           /**< buffer of size SCIP_MAXSTRLEN to store the problem name */
+   OAARFlow**            Flows,              /**< pointer to store the flows */
+   int*                  nFlows,             /**< pointer to store the number of flows */
+   int                   nNodes              /**< number of nodes of the topology */
+   )
+{
+   if( !nextRecord(scanner) || !scanWord(scanner, probName, SCIP_MAXSTRLEN) )
    {
-      do{
-         if( SCIPfgets(buffer, sizeof(buffer), file) == NULL )
-	    return SCIP_READERROR;
-	 lineno++;
-      } while ( buffer[0] == '#' );
-
-      nread = sscanf(buffer, "%d %d %lf %d %lf %lf\n", &(Flows[i].Source), &(Flows[i].Destination),
-         &(Flows[i].Priority), &(Flows[i].BandWidth), &(Flows[i].DelayPrice), &(Flows[i].JitterPrice));
-      if( nread == 0 )
-      { 
-         SCIPwarningMessage(scip, "invalid input line %d in file <%s>: <%s>\n", lineno, filename, buffer);
-	 return SCIP_READERROR;
-      }
+      syntaxError(scip, scanner, "the problem name");
+      return SCIP_READERROR;
    }
 
-   // set artificial links
-   // here, nLinks still stands for the number of original links (excluding the artificial one)
+   if( !nextRecord(scanner) || !scanInt(scanner, nFlows) || *nFlows < 0 )
+   {
+      syntaxError(scip, scanner, "nFlows");
+      return SCIP_READERROR;
+   }
+
+   SCIP_CALL( SCIPallocMemoryArray(scip, Flows, MAX(*nFlows, 1)) );
+   SCIP_CALL( parseFlows(scip, scanner, *Flows, *nFlows, nNodes) );
+
+   return SCIP_OKAY;
+}
+
+/** sets the artificial links, one from the source to the destination of each flow, behind the nLinks links */
+static
+void setArtificialLinks(
+   OAARLink*             Links,              /**< Links array with room for nLinks+nFlows links */
+   OAARFlow*             Flows,              /**< Flows array */
+   int                   nLinks,             /**< number of links without the artificial ones */
+   int                   nFlows              /**< number of flows */
+   )
+{
+   int i;
+
    for( i = nLinks; i < nFlows+nLinks; i++ )
    {
        Links[i].Capacity = Flows[i-nLinks].BandWidth;
+       Links[i].TransDelay = 0.0;
        Links[i].PropDelay = MAX_PROPDELAY;
        Links[i].BandCost = MAX_BANDCOST;
        Links[i].IsOptical = 0;
        Links[i].Head = Flows[i-nLinks].Source;
        Links[i].Tail = Flows[i-nLinks].Destination;
    }
-   //SCIPdebugMessage("MAX_BANDCOST:%d\n", MAX_BANDCOST);
+}
+
+/** returns whether the file is compressed and has to be read through SCIPfopen() */
+static
+SCIP_Bool isCompressed(
+   const char*           filename            /**< name of the file */
+   )
+{
+   const char* ext;
+
+   ext = strrchr(filename, '.');
+
+   return ext != NULL && (strcmp(ext, ".gz") == 0 || strcmp(ext, ".z") == 0 || strcmp(ext, ".Z") == 0
+      || strcmp(ext, ".bz2") == 0 || strcmp(ext, ".zip") == 0);
+}
+
+/** maps an uncompressed file into memory; returns FALSE if this is not possible */
+static
+SCIP_Bool mapFile(
+   const char*           filename,           /**< name of the file */
+   const char**          data,               /**< pointer to store the contents of the file */
+   size_t*               size                /**< pointer to store the size of the file */
+   )
+{
+#ifdef OAAR_MMAP
+   struct stat st;
+   void* addr;
+   int fd;
+
+   if( isCompressed(filename) )
+      return FALSE;
+
+   fd = open(filename, O_RDONLY);
+   if( fd < 0 )
+      return FALSE;
+
+   /* empty files cannot be mapped */
+   if( fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0 )
+   {
+      (void) close(fd);
+      return FALSE;
+   }
+
+   addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   (void) close(fd);
+   if( addr == MAP_FAILED )
+      return FALSE;
+
+   (void) madvise(addr, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+   *data = (const char*)addr;
+   *size = (size_t)st.st_size;
+
+   return TRUE;
+#else
+   return FALSE;
+#endif
+}
+
+/** unmaps a file mapped by mapFile() */
+static
+void unmapFile(
+   const char*           data,               /**< contents of the file */
+   size_t                size                /**< size of the file */
+   )
+{
+#ifdef OAAR_MMAP
+   (void) munmap((void*)data, size);
+#endif
+}
+
+/** reads a file through SCIPfopen(), which also handles compressed files, into memory */
+static
+SCIP_RETCODE readFile(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const char*           filename,           /**< name of the file */
+   char**                data,               /**< pointer to store the contents of the file */
+   size_t*               size                /**< pointer to store the size of the file */
+   )
+{
+   SCIP_FILE* file;
+   SCIP_RETCODE retcode;
+   size_t capacity;
+   size_t nread;
+
+   file = SCIPfopen(filename, "r");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for reading\n", filename);
+      SCIPprintSysError(filename);
+      return SCIP_NOFILE;
+   }
+
+   capacity = 1 << 20;
+   *size = 0;
+   retcode = SCIPallocMemoryArray(scip, data, capacity);
+
+   /* the file is closed on every path, also if the buffer cannot be enlarged */
+   while( retcode == SCIP_OKAY && (nread = SCIPfread(*data + *size, 1, capacity - *size, file)) > 0 )
+   {
+      *size += nread;
+      if( *size == capacity )
+      {
+         capacity *= 2;
+         retcode = SCIPreallocMemoryArray(scip, data, capacity);
+      }
+   }
+
+   (void) SCIPfclose(file);
+
+   if( retcode != SCIP_OKAY )
+   {
+      SCIPerrorMessage("not enough memory to read file <%s>\n", filename);
+      SCIPfreeMemoryArrayNull(scip, data);
+   }
+
+   return retcode;
+}
+
+/** maps a file into memory and points a scanner to its contents; compressed files are decompressed into a buffer */
+static
+SCIP_RETCODE loadFile(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const char*           filename,           /**< name of the file */
+   OAARSCANNER*          scanner,            /**< scanner to initialize */
+   char**                buffer,             /**< pointer to store the buffer, or NULL if the file is mapped */
+   size_t*               size                /**< pointer to store the size of the file */
+   )
+{
+   const char* data;
+
+   *buffer = NULL;
+   if( !mapFile(filename, &data, size) )
+   {
+      SCIP_CALL( readFile(scip, filename, buffer, size) );
+      data = *buffer;
+   }
+
+   scanner->pos = data;
+   scanner->end = data + *size;
+   scanner->linestart = NULL;
+   scanner->lineno = 0;
+   scanner->filename = filename;
+
+   return SCIP_OKAY;
+}
+
+/** releases the contents of a file loaded by loadFile() */
+static
+void unloadFile(
+   SCIP*                 scip,               /**< SCIP data structure */
+   OAARSCANNER*          scanner,            /**< scanner initialized by loadFile() */
+   char**                buffer,             /**< buffer of the file, or NULL if the file is mapped */
+   size_t                size                /**< size of the file */
+   )
+{
+   if( *buffer != NULL )
+      SCIPfreeMemoryArray(scip, buffer);
+   else
+      unmapFile(scanner->end - size, size);
+}
+
+/** gets size and modification time of a file, which identify the version of the file; returns FALSE if they are not
+ *  available
+ */
+static
+SCIP_Bool getFileStamp(
+   const char*           filename,           /**< name of the file */
+   SCIP_Longint*         filesize,           /**< pointer to store the size of the file */
+   SCIP_Longint*         filemtime           /**< pointer to store the modification time of the file */
+   )
+{
+#ifdef OAAR_MMAP
+   struct stat st;
+
+   if( stat(filename, &st) != 0 )
+      return FALSE;
+
+   *filesize = (SCIP_Longint)st.st_size;
+   *filemtime = (SCIP_Longint)st.st_mtime;
+
+   return TRUE;
+#else
+   return FALSE;
+#endif
+}
+
+/** drops a use of a topology and frees it when it is not used anymore */
+static
+void topologyRelease(
+   SCIP*                 scip,               /**< SCIP data structure */
+   OAARTOPOLOGY**        topology            /**< pointer to the topology */
+   )
+{
+   assert(topology != NULL);
+   assert(*topology != NULL);
+   assert((*topology)->nuses > 0);
+
+   (*topology)->nuses--;
+   if( (*topology)->nuses == 0 )
+   {
+      SCIPprobdataFreeAdjacency(scip, &(*topology)->Adjacency);
+      SCIPfreeMemoryArray(scip, &(*topology)->Links);
+      SCIPfreeMemoryArray(scip, &(*topology)->Nodes);
+      SCIPfreeMemoryArray(scip, &(*topology)->filename);
+      SCIPfreeMemory(scip, topology);
+   }
+
+   *topology = NULL;
+}
+
+/** makes sure that the reader caches the topology of the given file, which is parsed only if it is not cached yet or
+ *  changed on disk
+ */
+static
+SCIP_RETCODE loadTopology(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_READERDATA*      readerdata,         /**< data of the demand file reader */
+   const char*           filename            /**< name of the topology file */
+   )
+{
+   OAARTOPOLOGY* topology;
+   OAARSCANNER scanner;
+   SCIP_RETCODE retcode;
+   SCIP_Longint filesize;
+   SCIP_Longint filemtime;
+   SCIP_Bool hasstamp;
+   char probName[SCIP_MAXSTRLEN];
+   char* buffer;
+   size_t size;
+   int nFlows;
+
+   hasstamp = getFileStamp(filename, &filesize, &filemtime);
+
+   topology = readerdata->topology;
+   if( topology != NULL && strcmp(topology->filename, filename) == 0 && hasstamp == topology->hasstamp
+      && (!hasstamp || (filesize == topology->filesize && filemtime == topology->filemtime)) )
+   {
+      SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "reusing topology of file <%s>\n", filename);
+      return SCIP_OKAY;
+   }
+
+   SCIP_CALL( SCIPallocMemory(scip, &topology) );
+   topology->Nodes = NULL;
+   topology->Links = NULL;
+
+   SCIP_CALL( loadFile(scip, filename, &scanner, &buffer, &size) );
+   retcode = parseTopology(scip, &scanner, probName, &topology->Nodes, &topology->Links, &topology->nNodes,
+      &topology->nOpticalNodes, &topology->nLinks, &topology->nOpticalLinks, &nFlows, FALSE);
+   unloadFile(scip, &scanner, &buffer, size);
+
+   if( retcode != SCIP_OKAY )
+   {
+      SCIPfreeMemoryArrayNull(scip, &topology->Links);
+      SCIPfreeMemoryArrayNull(scip, &topology->Nodes);
+      SCIPfreeMemory(scip, &topology);
+      return retcode;
+   }
+
+   SCIP_CALL( SCIPduplicateMemoryArray(scip, &topology->filename, filename, strlen(filename)+1) );
+   SCIP_CALL( SCIPprobdataCreateAdjacency(scip, &topology->Adjacency, topology->Links, topology->nNodes,
+         topology->nLinks, topology->nOpticalLinks) );
+   topology->hasstamp = hasstamp;
+   topology->filesize = hasstamp ? filesize : 0;
+   topology->filemtime = hasstamp ? filemtime : 0;
+   topology->nuses = 1;
+
+   SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "read topology <%s> with %d nodes and %d links from file <%s>\n",
+      probName, topology->nNodes, topology->nLinks, filename);
+
+   /* problems still using the old topology keep it until they are freed */
+   if( readerdata->topology != NULL )
+      topologyRelease(scip, &readerdata->topology);
+   readerdata->topology = topology;
+
+   return SCIP_OKAY;
+}
+
+/** groups the links of the topology followed by one artificial link per flow by one of their end nodes, given the
+ *  grouping of the topology links; the artificial links have the largest indices, so they go behind the topology links
+ *  of their node and the links of each node stay sorted
+ */
+static
+void mergeArtificialLinks(
+   const int*            beg,                /**< start of the topology links of each node (size nNodes+1) */
+   const int*            optend,             /**< end of the optical topology links of each node */
+   const int*            links,              /**< grouped topology links */
+   OAARFlow*             Flows,              /**< Flows array */
+   int                   nNodes,             /**< number of nodes */
+   int                   nLinks,             /**< number of topology links */
+   int                   nFlows,             /**< number of flows */
+   SCIP_Bool             bysource,           /**< group by Head, i.e., source (out-links) instead of Tail (in-links)? */
+   int*                  newbeg,             /**< array to store the start of the links of each node (size nNodes+1) */
+   int*                  newoptend,          /**< array to store the end of the optical links of each node */
+   int*                  newlinks,           /**< array to store the grouped links (size nLinks+nFlows) */
+   int*                  fill                /**< buffer of size nNodes */
+   )
+{
+   int k;
+   int v;
+
+   /* count the artificial links of each node */
+   for( v = 0; v <= nNodes; v++ )
+      newbeg[v] = 0;
+   for( k = 0; k < nFlows; k++ )
+      newbeg[(bysource ? Flows[k].Source : Flows[k].Destination) + 1]++;
+
+   /* copy the topology links of each node and leave room for its artificial links */
+   for( v = 0; v < nNodes; v++ )
+   {
+      newbeg[v+1] += newbeg[v] + beg[v+1] - beg[v];
+      newoptend[v] = newbeg[v] + optend[v] - beg[v];
+      BMScopyMemoryArray(&newlinks[newbeg[v]], &links[beg[v]], beg[v+1] - beg[v]);
+      fill[v] = newbeg[v] + beg[v+1] - beg[v];
+   }
+
+   for( k = 0; k < nFlows; k++ )
+   {
+      v = bysource ? Flows[k].Source : Flows[k].Destination;
+      newlinks[fill[v]] = nLinks + k;
+      fill[v]++;
+   }
+}
+
+/** frees the arrays of a problem read from a demand file and drops its use of the topology */
+static
+SCIP_DECL_PROBDATASTORAGEFREE(demandFree)
+{  /*lint --e{715}*/
+   OAARDEMAND* demand;
+
+   demand = (OAARDEMAND*)storage;
+
+   SCIPprobdataFreeAdjacency(scip, &demand->Adjacency);
+   SCIPfreeMemoryArray(scip, &demand->Flows);
+   SCIPfreeMemoryArray(scip, &demand->Links);
+   topologyRelease(scip, &demand->topology);
+   SCIPfreeMemory(scip, &demand);
+}
+
+/** creates the links and the adjacency of a problem on the topology with the given flows */
+static
+SCIP_RETCODE demandCreate(
+   SCIP*                 scip,               /**< SCIP data structure */
+   OAARDEMAND**          demand,             /**< pointer to store the arrays of the problem */
+   OAARTOPOLOGY*         topology,           /**< topology */
+   OAARFlow*             Flows,              /**< Flows array, taken over by the demand */
+   int                   nFlows              /**< number of flows */
+   )
+{
+   OAARAdjacency* adj;
+   int* fill;
+   int nNodes;
+   int nLinks;
+
+   nNodes = topology->nNodes;
+   nLinks = topology->nLinks + nFlows;
+
+   SCIP_CALL( SCIPallocMemory(scip, demand) );
+   (*demand)->topology = topology;
+   (*demand)->Flows = Flows;
+   topology->nuses++;
+
+   /* the artificial links have to follow the topology links in one array, hence the links are copied */
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*demand)->Links, MAX(nLinks, 1)) );
+   BMScopyMemoryArray((*demand)->Links, topology->Links, topology->nLinks);
+   setArtificialLinks((*demand)->Links, Flows, topology->nLinks, nFlows);
+
+   adj = &(*demand)->Adjacency;
+   SCIP_CALL( SCIPallocMemoryArray(scip, &adj->OutBeg, nNodes+1) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &adj->OutOptEnd, nNodes) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &adj->OutLinks, nLinks) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &adj->InBeg, nNodes+1) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &adj->InOptEnd, nNodes) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &adj->InLinks, nLinks) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &fill, nNodes) );
+
+   mergeArtificialLinks(topology->Adjacency.OutBeg, topology->Adjacency.OutOptEnd, topology->Adjacency.OutLinks,
+      Flows, nNodes, topology->nLinks, nFlows, TRUE, adj->OutBeg, adj->OutOptEnd, adj->OutLinks, fill);
+   mergeArtificialLinks(topology->Adjacency.InBeg, topology->Adjacency.InOptEnd, topology->Adjacency.InLinks,
+      Flows, nNodes, topology->nLinks, nFlows, FALSE, adj->InBeg, adj->InOptEnd, adj->InLinks, fill);
+
+   SCIPfreeBufferArray(scip, &fill);
+
+   return SCIP_OKAY;
+}
+
+/**@} */
+
+
+/**@name Callback methods
+ *
+ * @{
+ */
+
+/** problem reading method of reader */
+static
+SCIP_DECL_READERREAD(readerReadOAAR)
+{  /*lint --e{715}*/
+   OAARSCANNER scanner;
+   SCIP_RETCODE retcode;
+   char* buffer;
+   size_t size;
+
+   char probName[SCIP_MAXSTRLEN];
+   OAARNode* Nodes;
+   OAARLink* Links;
+   OAARFlow*  Flows;
+   int nNodes;
+   int nOpticalNodes;
+   int nLinks;
+   int nOpticalLinks;
+   int nFlows;
+   int nCons;
+
+   *result = SCIP_DIDNOTRUN;
+
+   /* map the file into memory; compressed files are decompressed into a buffer */
+   SCIP_CALL( loadFile(scip, filename, &scanner, &buffer, &size) );
+
+   Nodes = NULL;
+   Links = NULL;
+   Flows = NULL;
+   retcode = parseProblem(scip, &scanner, probName, &Nodes, &Links, &Flows, &nNodes, &nOpticalNodes, &nLinks,
+      &nOpticalLinks, &nFlows);
+
+   unloadFile(scip, &scanner, &buffer, size);
+
+   if( retcode != SCIP_OKAY )
+   {
+      SCIPfreeMemoryArrayNull(scip, &Flows);
+      SCIPfreeMemoryArrayNull(scip, &Links);
+      SCIPfreeMemoryArrayNull(scip, &Nodes);
+      return retcode;
+   }
+
+   // set artificial links
+   // here, nLinks still stands for the number of original links (excluding the artificial one)
+   setArtificialLinks(Links, Flows, nLinks, nFlows);
 
    // update nLinks
    // from now on, nLinks will include the number of artificial links
@@ -259,15 +1012,94 @@ SCIP_DECL_READERREAD(readerReadOAAR)
    /* create a new problem in SCIP */
    SCIP_CALL( SCIPprobdataCreate(scip, probName, Nodes, Links, Flows, nNodes, nOpticalNodes, 
       nLinks, nOpticalLinks, nFlows, nCons) );
-  
-   (void)SCIPfclose(file);
-   SCIPfreeBufferArray(scip, &Flows);
-   SCIPfreeBufferArray(scip, &Links);
-   for( i = 0; i < nNodes; i++ )
+
+   SCIPfreeMemoryArray(scip, &Flows);
+   SCIPfreeMemoryArray(scip, &Links);
+   SCIPfreeMemoryArray(scip, &Nodes);
+
+   *result = SCIP_SUCCESS;
+
+   return SCIP_OKAY;
+}
+
+/** destructor of demand file reader to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_READERFREE(readerFreeOAARD)
+{  /*lint --e{715}*/
+   SCIP_READERDATA* readerdata;
+
+   readerdata = SCIPreaderGetData(reader);
+   assert(readerdata != NULL);
+
+   if( readerdata->topology != NULL )
+      topologyRelease(scip, &readerdata->topology);
+
+   SCIPfreeMemory(scip, &readerdata);
+
+   return SCIP_OKAY;
+}
+
+/** problem reading method of demand file reader */
+static
+SCIP_DECL_READERREAD(readerReadOAARD)
+{  /*lint --e{715}*/
+   SCIP_READERDATA* readerdata;
+   OAARTOPOLOGY* topology;
+   OAARDEMAND* demand;
+   OAARSCANNER scanner;
+   SCIP_RETCODE retcode;
+   OAARFlow* Flows;
+   char probName[SCIP_MAXSTRLEN];
+   char* buffer;
+   size_t size;
+   int nFlows;
+   int nLinks;
+   int nCons;
+
+   readerdata = SCIPreaderGetData(reader);
+   assert(readerdata != NULL);
+
+   *result = SCIP_DIDNOTRUN;
+
+   if( readerdata->topologyfile == NULL || readerdata->topologyfile[0] == '\0' )
+   {
+      SCIPerrorMessage("no topology for demand file <%s>: set parameter reading/"DEMANDREADER_NAME"/topology\n",
+         filename);
+      return SCIP_READERROR;
+   }
+
+   SCIP_CALL( loadTopology(scip, readerdata, readerdata->topologyfile) );
+   topology = readerdata->topology;
+
+   SCIP_CALL( loadFile(scip, filename, &scanner, &buffer, &size) );
+
+   Flows = NULL;
+   retcode = parseDemand(scip, &scanner, probName, &Flows, &nFlows, topology->nNodes);
+
+   unloadFile(scip, &scanner, &buffer, size);
+
+   if( retcode != SCIP_OKAY )
    {
-      SCIPfreeBufferArray(scip, &(Nodes[i].ConnLinks));
+      SCIPfreeMemoryArrayNull(scip, &Flows);
+      return retcode;
+   }
+
+   SCIP_CALL( demandCreate(scip, &demand, topology, Flows, nFlows) );
+
+   nLinks = topology->nLinks + nFlows;
+   nCons = nFlows + (nLinks - topology->nOpticalLinks) + (topology->nOpticalLinks * nWaveLength);
+
+   /* the problem uses the cached nodes and the arrays of the demand in place and frees the demand with it */
+   retcode = SCIPprobdataCreateShared(scip, probName, topology->Nodes, demand->Links, demand->Flows,
+      &demand->Adjacency, topology->nNodes, topology->nOpticalNodes, nLinks, topology->nOpticalLinks, nFlows, nCons,
+      (void*)demand, sizeof(OAARDEMAND), demandFree);
+
+   /* on failure the problem did not take over the demand, which still holds a use of the cached topology */
+   if( retcode != SCIP_OKAY )
+   {
+      demandFree(scip, (void*)demand, sizeof(OAARDEMAND));
+      return retcode;
    }
-   SCIPfreeBufferArray(scip, &Nodes);
 
    *result = SCIP_SUCCESS;
 
@@ -282,7 +1114,7 @@ SCIP_DECL_READERREAD(readerReadOAAR)
  * @{
  */
 
-/** includes the bpa file reader in SCIP */
+/** includes the .oaar file reader and the .oaard demand file reader in SCIP */
 SCIP_RETCODE SCIPincludeReaderOAAR(
    SCIP*                 scip                /**< SCIP data structure */
    )
@@ -299,6 +1131,36 @@ SCIP_RETCODE SCIPincludeReaderOAAR(
 
    SCIP_CALL( SCIPsetReaderRead(scip, reader, readerReadOAAR) );
 
+   /* parameters of the initial columns, which are created while the problem is read */
+   SCIP_CALL( SCIPaddIntParam(scip, "reading/"READER_NAME"/initpaths",
+         "maximal number of cheap paths per flow w.r.t. the static costs which are added as initial columns (found heuristically, not necessarily the cheapest)",
+         NULL, FALSE, DEFAULT_INITPATHS, 0, INT_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddRealParam(scip, "reading/"READER_NAME"/initpathtime",
+         "time limit in seconds for computing the initial paths",
+         NULL, FALSE, DEFAULT_INITPATHTIME, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddBoolParam(scip, "reading/"READER_NAME"/greedy",
+         "should the flows be routed greedily on their cheapest remaining path to get a starting solution?",
+         NULL, FALSE, DEFAULT_GREEDY, NULL, NULL) );
+   SCIP_CALL( SCIPaddBoolParam(scip, "reading/"READER_NAME"/varnames",
+         "should the columns be named lambda_<flow>_<colid>? (FALSE saves memory and time on very large instances)",
+         NULL, FALSE, DEFAULT_VARNAMES, NULL, NULL) );
+
+   /* demand file reader; the initial columns are controlled by the parameters above */
+   SCIP_CALL( SCIPallocMemory(scip, &readerdata) );
+   readerdata->topology = NULL;
+   readerdata->topologyfile = NULL;
+
+   SCIP_CALL( SCIPincludeReaderBasic(scip, &reader, DEMANDREADER_NAME, DEMANDREADER_DESC, DEMANDREADER_EXTENSION,
+         readerdata) );
+   assert(reader != NULL);
+
+   SCIP_CALL( SCIPsetReaderFree(scip, reader, readerFreeOAARD) );
+   SCIP_CALL( SCIPsetReaderRead(scip, reader, readerReadOAARD) );
+
+   SCIP_CALL( SCIPaddStringParam(scip, "reading/"DEMANDREADER_NAME"/topology",
+         ".oaar file with the topology of the demand files (its flows are ignored), parsed again only if it changed",
+         &readerdata->topologyfile, FALSE, DEFAULT_TOPOLOGY, NULL, NULL) );
+
    return SCIP_OKAY;
 }
 
@@ -2,6 +2,8 @@
  * @brief  OAAR file reader
  * @author He Xingqiu
  *
+ * Reads .oaar files, which contain topology and flows, and .oaard demand files, which contain only flows and are
+ * solved on a topology file that is parsed once and cached.
  */
 
 /*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
@@ -14,6 +16,7 @@
 #include "OAARdataStructure.h"
 
 
+/** includes the .oaar file reader and the .oaard demand file reader in SCIP */
 extern
 SCIP_RETCODE SCIPincludeReaderOAAR(
    SCIP*                 scip                /**< SCIP data structure */
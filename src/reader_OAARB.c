@@ -0,0 +1,739 @@
+/**@file   reader_OAARB.c
+ * @brief  OAAR binary file reader and writer
+ * @author He Xingqiu
+ *
+ * The .oaarb format holds the arrays of the problem data in their memory layout, so the reader maps the file and hands
+ * the arrays to SCIPprobdataCreateShared() without parsing or copying them; the mapping is released together with the
+ * problem. Compressed files are read into memory through SCIPfopen() instead.
+ *
+ * Layout (all numbers in the byte order of the writing machine):
+ *  - header (struct OaarbHeader): magic, format version, byte order mark, sizes of OAARNode, OAARLink and OAARFlow,
+ *    the problem dimensions, offset and length of each section, the file size, a checksum of the data and a checksum
+ *    of the header itself
+ *  - sections, each starting at a multiple of OAARB_ALIGN and padded with zeros: problem name, Nodes, Links
+ *    (including the artificial links), Flows, OutBeg, OutOptEnd, OutLinks, InBeg, InOptEnd, InLinks
+ *
+ * A file is only accepted if it was written by a build with the same structure sizes and byte order. The header
+ * checksum is always verified; the checksum of the data and the indices stored in it are verified unless the parameter
+ * reading/oaarbreader/checkdata is FALSE, which saves touching every page of the file.
+ *
+ * The writer stores the problem data of the current problem; "write problem x.oaarb" after reading an .oaar file
+ * converts it.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+//#define SCIP_DEBUG
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define OAARB_MMAP
+#endif
+
+#include "probdata_OAAR.h"
+#include "reader_OAARB.h"
+
+/**@name Reader properties
+ *
+ * @{
+ */
+
+#define READER_NAME             "oaarbreader"
+#define READER_DESC             "file reader and writer for the OAAR binary data format"
+#define READER_EXTENSION        "oaarb"
+
+#define DEFAULT_CHECKDATA       TRUE     /**< should the checksum and the indices of the data be verified? */
+
+/**@} */
+
+/**@name Format
+ *
+ * @{
+ */
+
+#define OAARB_MAGIC             "OAARB\r\n\032"  /**< 8 bytes; the line ends and ^Z expose text mode transfers */
+#define OAARB_VERSION           1u           /**< version of the format, increased on every change of the layout */
+#define OAARB_BYTEORDER         0x01020304u  /**< byte order mark */
+#define OAARB_ALIGN             64           /**< alignment of the sections in bytes */
+
+/** sections of an .oaarb file, in the order in which they are stored */
+enum OaarbSection
+{
+   OAARB_NAME      = 0,                      /**< problem name, terminated by '\0' */
+   OAARB_NODES     = 1,                      /**< Nodes array */
+   OAARB_LINKS     = 2,                      /**< Links array, including the artificial links */
+   OAARB_FLOWS     = 3,                      /**< Flows array */
+   OAARB_OUTBEG    = 4,                      /**< OutBeg of the adjacency */
+   OAARB_OUTOPTEND = 5,                      /**< OutOptEnd of the adjacency */
+   OAARB_OUTLINKS  = 6,                      /**< OutLinks of the adjacency */
+   OAARB_INBEG     = 7,                      /**< InBeg of the adjacency */
+   OAARB_INOPTEND  = 8,                      /**< InOptEnd of the adjacency */
+   OAARB_INLINKS   = 9,                      /**< InLinks of the adjacency */
+   OAARB_NSECTIONS = 10                      /**< number of sections */
+};
+
+/** header at the start of an .oaarb file; all members have their natural alignment, so the struct has no padding */
+typedef struct OaarbHeader
+{
+   char                  magic[8];           /**< OAARB_MAGIC */
+   uint32_t              version;            /**< OAARB_VERSION of the writer */
+   uint32_t              byteorder;          /**< OAARB_BYTEORDER as written by the writer */
+   uint32_t              nodesize;           /**< sizeof(OAARNode) of the writer */
+   uint32_t              linksize;           /**< sizeof(OAARLink) of the writer */
+   uint32_t              flowsize;           /**< sizeof(OAARFlow) of the writer */
+   int32_t               nNodes;             /**< number of Nodes */
+   int32_t               nOpticalNodes;      /**< number of optical nodes */
+   int32_t               nLinks;             /**< number of links, including the artificial ones */
+   int32_t               nOpticalLinks;      /**< number of optical links */
+   int32_t               nFlows;             /**< number of flows */
+   uint64_t              offset[OAARB_NSECTIONS]; /**< offset of each section in the file */
+   uint64_t              length[OAARB_NSECTIONS]; /**< length of each section in bytes, without padding */
+   uint64_t              filesize;           /**< size of the file in bytes */
+   uint64_t              datachecksum;       /**< checksum of the bytes from OAARB_DATASTART to the end of the file */
+   uint64_t              headerchecksum;     /**< checksum of the header bytes before this member */
+} OAARBHEADER;
+
+/** offset of the first section: the header rounded up to the alignment */
+#define OAARB_DATASTART         ((sizeof(OAARBHEADER) + OAARB_ALIGN - 1) / OAARB_ALIGN * OAARB_ALIGN)
+
+/**@} */
+
+
+/**@name Local methods
+ *
+ * @{
+ */
+
+/** rounds a size up to a multiple of the section alignment */
+static
+uint64_t alignSize(
+   uint64_t              size                /**< size in bytes */
+   )
+{
+   return (size + OAARB_ALIGN - 1) / OAARB_ALIGN * OAARB_ALIGN;
+}
+
+/** updates a checksum by the given bytes, whose number must be a multiple of 8
+ *
+ *  Every word is mixed in by an invertible step, so changing a single word always changes the checksum.
+ */
+static
+uint64_t updateChecksum(
+   uint64_t              checksum,           /**< checksum of the preceding bytes */
+   const void*           data,               /**< bytes to add */
+   size_t                size                /**< number of bytes, a multiple of 8 */
+   )
+{
+   const char* bytes;
+   uint64_t word;
+   size_t i;
+
+   assert(size % 8 == 0);
+
+   bytes = (const char*)data;
+   for( i = 0; i < size; i += 8 )
+   {
+      memcpy(&word, bytes + i, 8);
+      checksum = (checksum ^ word) * 0x100000001B3ULL;
+      checksum ^= checksum >> 29;
+   }
+
+   return checksum;
+}
+
+/** returns the checksum of the header bytes before the member headerchecksum */
+static
+uint64_t getHeaderChecksum(
+   const OAARBHEADER*    header              /**< header */
+   )
+{
+   return updateChecksum(0xCBF29CE484222325ULL, header, offsetof(OAARBHEADER, headerchecksum));
+}
+
+/** returns whether the file is compressed and has to be read through SCIPfopen() */
+static
+SCIP_Bool isCompressed(
+   const char*           filename            /**< name of the file */
+   )
+{
+   const char* ext;
+
+   ext = strrchr(filename, '.');
+
+   return ext != NULL && (strcmp(ext, ".gz") == 0 || strcmp(ext, ".z") == 0 || strcmp(ext, ".Z") == 0
+      || strcmp(ext, ".bz2") == 0 || strcmp(ext, ".zip") == 0);
+}
+
+/** maps an uncompressed file into memory; returns FALSE if this is not possible */
+static
+SCIP_Bool mapFile(
+   const char*           filename,           /**< name of the file */
+   char**                data,               /**< pointer to store the contents of the file */
+   size_t*               size                /**< pointer to store the size of the file */
+   )
+{
+#ifdef OAARB_MMAP
+   struct stat st;
+   void* addr;
+   int fd;
+
+   if( isCompressed(filename) )
+      return FALSE;
+
+   fd = open(filename, O_RDONLY);
+   if( fd < 0 )
+      return FALSE;
+
+   if( fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0 )
+   {
+      (void) close(fd);
+      return FALSE;
+   }
+
+   /* the pages are only read when the solver accesses them; writes would be private, but the arrays are never
+    * modified
+    */
+   addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   (void) close(fd);
+   if( addr == MAP_FAILED )
+      return FALSE;
+
+   *data = (char*)addr;
+   *size = (size_t)st.st_size;
+
+   return TRUE;
+#else
+   return FALSE;
+#endif
+}
+
+/** reads a file through SCIPfopen(), which also handles compressed files, into memory */
+static
+SCIP_RETCODE readFile(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const char*           filename,           /**< name of the file */
+   char**                data,               /**< pointer to store the contents of the file */
+   size_t*               size                /**< pointer to store the size of the file */
+   )
+{
+   SCIP_FILE* file;
+   SCIP_RETCODE retcode;
+   size_t capacity;
+   size_t nread;
+
+   file = SCIPfopen(filename, "rb");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open file <%s> for reading\n", filename);
+      SCIPprintSysError(filename);
+      return SCIP_NOFILE;
+   }
+
+   capacity = 1 << 20;
+   *size = 0;
+   retcode = SCIPallocMemoryArray(scip, data, capacity);
+
+   /* the file is closed on every path, also if the buffer cannot be enlarged */
+   while( retcode == SCIP_OKAY && (nread = SCIPfread(*data + *size, 1, capacity - *size, file)) > 0 )
+   {
+      *size += nread;
+      if( *size == capacity )
+      {
+         capacity *= 2;
+         retcode = SCIPreallocMemoryArray(scip, data, capacity);
+      }
+   }
+
+   (void) SCIPfclose(file);
+
+   if( retcode != SCIP_OKAY )
+   {
+      SCIPerrorMessage("not enough memory to read file <%s>\n", filename);
+      SCIPfreeMemoryArrayNull(scip, data);
+   }
+
+   return retcode;
+}
+
+/** unmaps the storage of a problem read from a mapped file */
+static
+SCIP_DECL_PROBDATASTORAGEFREE(storageFreeMapped)
+{  /*lint --e{715}*/
+#ifdef OAARB_MMAP
+   (void) munmap(storage, size);
+#endif
+}
+
+/** frees the storage of a problem read into memory by readFile() */
+static
+SCIP_DECL_PROBDATASTORAGEFREE(storageFreeBuffer)
+{  /*lint --e{715}*/
+   char* buffer;
+
+   buffer = (char*)storage;
+   SCIPfreeMemoryArray(scip, &buffer);
+}
+
+/** checks that the beginnings of the link lists of the adjacency are ascending and that all links exist */
+static
+SCIP_Bool checkAdjacency(
+   const int*            beg,                /**< start of the links of each node (size nNodes+1) */
+   const int*            optend,             /**< end of the optical links of each node */
+   const int*            links,              /**< grouped links */
+   int                   nNodes,             /**< number of Nodes */
+   int                   nLinks              /**< number of links */
+   )
+{
+   int v;
+   int i;
+
+   if( beg[0] != 0 || beg[nNodes] != nLinks )
+      return FALSE;
+
+   for( v = 0; v < nNodes; v++ )
+   {
+      if( beg[v] > optend[v] || optend[v] > beg[v+1] )
+         return FALSE;
+   }
+
+   for( i = 0; i < nLinks; i++ )
+   {
+      if( links[i] < 0 || links[i] >= nLinks )
+         return FALSE;
+   }
+
+   return TRUE;
+}
+
+/** checks the header of an .oaarb file and, if checkdata is TRUE, the checksum and the indices of its data */
+static
+SCIP_RETCODE checkFile(
+   const char*           filename,           /**< name of the file, for error messages */
+   const char*           data,               /**< contents of the file */
+   size_t                size,               /**< size of the file */
+   SCIP_Bool             checkdata,          /**< should the checksum and the indices of the data be verified? */
+   OAARBHEADER*          header              /**< pointer to store the header */
+   )
+{
+   uint64_t expected[OAARB_NSECTIONS];
+   const OAARLink* Links;
+   const OAARFlow* Flows;
+   uint64_t end;
+   int nNodes;
+   int nLinks;
+   int nFlows;
+   int s;
+   int i;
+
+   if( size < sizeof(OAARBHEADER) || memcmp(data, OAARB_MAGIC, 8) != 0 )
+   {
+      SCIPerrorMessage("file <%s> is not an .oaarb file\n", filename);
+      return SCIP_READERROR;
+   }
+
+   memcpy(header, data, sizeof(OAARBHEADER));
+
+   if( header->byteorder != OAARB_BYTEORDER )
+   {
+      SCIPerrorMessage("file <%s> was written on a machine with a different byte order\n", filename);
+      return SCIP_READERROR;
+   }
+   if( header->version != OAARB_VERSION )
+   {
+      SCIPerrorMessage("file <%s> has format version %u, but only version %u is supported\n", filename,
+         (unsigned int)header->version, OAARB_VERSION);
+      return SCIP_READERROR;
+   }
+   if( header->headerchecksum != getHeaderChecksum(header) )
+   {
+      SCIPerrorMessage("file <%s> has a corrupted header (checksum mismatch)\n", filename);
+      return SCIP_READERROR;
+   }
+   if( header->nodesize != sizeof(OAARNode) || header->linksize != sizeof(OAARLink)
+      || header->flowsize != sizeof(OAARFlow) )
+   {
+      SCIPerrorMessage("file <%s> was written with a different layout of the data structures\n", filename);
+      return SCIP_READERROR;
+   }
+   if( header->filesize != size || size % 8 != 0 )
+   {
+      SCIPerrorMessage("file <%s> has %lu bytes, but its header expects %lu bytes\n", filename,
+         (unsigned long)size, (unsigned long)header->filesize);
+      return SCIP_READERROR;
+   }
+
+   nNodes = header->nNodes;
+   nLinks = header->nLinks;
+   nFlows = header->nFlows;
+   if( nNodes < 1 || header->nOpticalNodes < 0 || header->nOpticalNodes > nNodes || nFlows < 0 || nFlows > nLinks
+      || header->nOpticalLinks < 0 || header->nOpticalLinks > nLinks - nFlows )
+   {
+      SCIPerrorMessage("file <%s> has invalid problem dimensions\n", filename);
+      return SCIP_READERROR;
+   }
+
+   expected[OAARB_NAME] = header->length[OAARB_NAME];
+   expected[OAARB_NODES] = (uint64_t)nNodes * sizeof(OAARNode);
+   expected[OAARB_LINKS] = (uint64_t)nLinks * sizeof(OAARLink);
+   expected[OAARB_FLOWS] = (uint64_t)nFlows * sizeof(OAARFlow);
+   expected[OAARB_OUTBEG] = (uint64_t)(nNodes + 1) * sizeof(int);
+   expected[OAARB_OUTOPTEND] = (uint64_t)nNodes * sizeof(int);
+   expected[OAARB_OUTLINKS] = (uint64_t)nLinks * sizeof(int);
+   expected[OAARB_INBEG] = expected[OAARB_OUTBEG];
+   expected[OAARB_INOPTEND] = expected[OAARB_OUTOPTEND];
+   expected[OAARB_INLINKS] = expected[OAARB_OUTLINKS];
+
+   /* the sections must be aligned, so the arrays can be used in place, and must lie within the file */
+   for( s = 0; s < OAARB_NSECTIONS; s++ )
+   {
+      end = header->offset[s] + header->length[s];
+      if( header->length[s] != expected[s] || header->offset[s] % OAARB_ALIGN != 0
+         || header->offset[s] < OAARB_DATASTART || header->offset[s] > size || end < header->offset[s] || end > size )
+      {
+         SCIPerrorMessage("file <%s> has an invalid section %d\n", filename, s);
+         return SCIP_READERROR;
+      }
+   }
+   if( header->length[OAARB_NAME] == 0 || data[header->offset[OAARB_NAME] + header->length[OAARB_NAME] - 1] != '\0' )
+   {
+      SCIPerrorMessage("file <%s> has an invalid problem name\n", filename);
+      return SCIP_READERROR;
+   }
+
+   if( !checkdata )
+      return SCIP_OKAY;
+
+   if( updateChecksum(0xCBF29CE484222325ULL, data + OAARB_DATASTART, size - OAARB_DATASTART) != header->datachecksum )
+   {
+      SCIPerrorMessage("file <%s> is corrupted (checksum mismatch)\n", filename);
+      return SCIP_READERROR;
+   }
+
+   /* a file with a valid checksum could still come from a faulty writer; wrong indices would crash the solver */
+   Links = (const OAARLink*)(data + header->offset[OAARB_LINKS]);
+   Flows = (const OAARFlow*)(data + header->offset[OAARB_FLOWS]);
+   for( i = 0; i < nLinks; i++ )
+   {
+      if( Links[i].Head < 0 || Links[i].Head >= nNodes || Links[i].Tail < 0 || Links[i].Tail >= nNodes )
+      {
+         SCIPerrorMessage("file <%s>: link %d has an invalid end node\n", filename, i);
+         return SCIP_READERROR;
+      }
+   }
+   for( i = 0; i < nFlows; i++ )
+   {
+      if( Flows[i].Source < 0 || Flows[i].Source >= nNodes || Flows[i].Destination < 0
+         || Flows[i].Destination >= nNodes )
+      {
+         SCIPerrorMessage("file <%s>: flow %d has an invalid end node\n", filename, i);
+         return SCIP_READERROR;
+      }
+   }
+   if( !checkAdjacency((const int*)(data + header->offset[OAARB_OUTBEG]),
+         (const int*)(data + header->offset[OAARB_OUTOPTEND]), (const int*)(data + header->offset[OAARB_OUTLINKS]),
+         nNodes, nLinks)
+      || !checkAdjacency((const int*)(data + header->offset[OAARB_INBEG]),
+         (const int*)(data + header->offset[OAARB_INOPTEND]), (const int*)(data + header->offset[OAARB_INLINKS]),
+         nNodes, nLinks) )
+   {
+      SCIPerrorMessage("file <%s> has an invalid adjacency\n", filename);
+      return SCIP_READERROR;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** passes the bytes of a section to the checksum and, if file is not NULL, writes them, followed by the zero padding up
+ *  to the next section
+ */
+static
+void emitSection(
+   FILE*                 file,               /**< output file, or NULL to only compute the checksum */
+   uint64_t*             checksum,           /**< checksum to update */
+   const void*           data,               /**< bytes of the section */
+   uint64_t              length              /**< number of bytes */
+   )
+{
+   char tail[OAARB_ALIGN];
+   uint64_t full;
+   uint64_t rest;
+
+   /* the checksum works on words, so the last partial block is copied and padded */
+   full = length / OAARB_ALIGN * OAARB_ALIGN;
+   rest = length - full;
+
+   *checksum = updateChecksum(*checksum, data, (size_t)full);
+   if( file != NULL )
+      (void) fwrite(data, 1, (size_t)full, file);
+
+   if( rest > 0 )
+   {
+      memset(tail, 0, OAARB_ALIGN);
+      memcpy(tail, (const char*)data + full, (size_t)rest);
+      *checksum = updateChecksum(*checksum, tail, OAARB_ALIGN);
+      if( file != NULL )
+         (void) fwrite(tail, 1, OAARB_ALIGN, file);
+   }
+}
+
+/**@} */
+
+
+/**@name Callback methods
+ *
+ * @{
+ */
+
+/** problem reading method of reader */
+static
+SCIP_DECL_READERREAD(readerReadOAARB)
+{  /*lint --e{715}*/
+   OAARBHEADER header;
+   OAARAdjacency adj;
+   SCIP_RETCODE retcode;
+   SCIP_Bool checkdata;
+   SCIP_Bool mapped;
+   char* data;
+   size_t size;
+   int nCons;
+
+   *result = SCIP_DIDNOTRUN;
+
+   SCIP_CALL( SCIPgetBoolParam(scip, "reading/"READER_NAME"/checkdata", &checkdata) );
+
+   /* map the file into memory; compressed files are decompressed into a buffer */
+   mapped = mapFile(filename, &data, &size);
+   if( !mapped )
+   {
+      SCIP_CALL( readFile(scip, filename, &data, &size) );
+   }
+
+   retcode = checkFile(filename, data, size, checkdata, &header);
+   if( retcode != SCIP_OKAY )
+   {
+      if( mapped )
+         storageFreeMapped(scip, data, size);
+      else
+         storageFreeBuffer(scip, data, size);
+      return retcode;
+   }
+
+   adj.OutBeg = (int*)(data + header.offset[OAARB_OUTBEG]);
+   adj.OutOptEnd = (int*)(data + header.offset[OAARB_OUTOPTEND]);
+   adj.OutLinks = (int*)(data + header.offset[OAARB_OUTLINKS]);
+   adj.InBeg = (int*)(data + header.offset[OAARB_INBEG]);
+   adj.InOptEnd = (int*)(data + header.offset[OAARB_INOPTEND]);
+   adj.InLinks = (int*)(data + header.offset[OAARB_INLINKS]);
+
+   // nCons = nCons1(nFlows) + nCons2(E-E') + nCons3(E'*NLAMBDA), the artificial links count as electrical links
+   nCons = header.nFlows + (header.nLinks - header.nOpticalLinks) + (header.nOpticalLinks * nWaveLength);
+
+   SCIPdebugMessage("mapped problem <%s> with %d nodes, %d links and %d flows\n", data + header.offset[OAARB_NAME],
+      header.nNodes, header.nLinks, header.nFlows);
+
+   /* create a new problem in SCIP on the arrays of the file; the problem releases the file when it is freed */
+   retcode = SCIPprobdataCreateShared(scip, data + header.offset[OAARB_NAME],
+      (OAARNode*)(data + header.offset[OAARB_NODES]), (OAARLink*)(data + header.offset[OAARB_LINKS]),
+      (OAARFlow*)(data + header.offset[OAARB_FLOWS]), &adj, header.nNodes, header.nOpticalNodes, header.nLinks,
+      header.nOpticalLinks, header.nFlows, nCons, data, size, mapped ? storageFreeMapped : storageFreeBuffer);
+
+   /* on failure the problem did not take over the file */
+   if( retcode != SCIP_OKAY )
+   {
+      if( mapped )
+         storageFreeMapped(scip, data, size);
+      else
+         storageFreeBuffer(scip, data, size);
+      return retcode;
+   }
+
+   *result = SCIP_SUCCESS;
+
+   return SCIP_OKAY;
+}
+
+/** problem writing method of reader */
+static
+SCIP_DECL_READERWRITE(readerWriteOAARB)
+{  /*lint --e{715}*/
+   OAARBHEADER header;
+   OAARAdjacency* adj;
+   OAARNode* origNodes;
+   OAARLink* origLinks;
+   OAARFlow* origFlows;
+   OAARNode* Nodes;
+   OAARLink* Links;
+   OAARFlow* Flows;
+   const void* sections[OAARB_NSECTIONS];
+   char headerblock[OAARB_DATASTART];
+   uint64_t checksum;
+   uint64_t offset;
+   int nNodes;
+   int nLinks;
+   int nFlows;
+   int s;
+   int i;
+
+   *result = SCIP_DIDNOTRUN;
+
+   if( probdata == NULL )
+      return SCIP_OKAY;
+
+   nNodes = SCIPprobdataGetNNodes(probdata);
+   nLinks = SCIPprobdataGetNLinks(probdata);
+   nFlows = SCIPprobdataGetNFlows(probdata);
+   adj = SCIPprobdataGetAdjacency(probdata);
+   origNodes = SCIPprobdataGetNodes(probdata);
+   origLinks = SCIPprobdataGetLinks(probdata);
+   origFlows = SCIPprobdataGetFlows(probdata);
+
+   /* copy the records member by member into cleared arrays, such that the padding bytes are zero and the file only
+    * depends on the problem
+    */
+   SCIP_CALL( SCIPallocBufferArray(scip, &Nodes, nNodes) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &Links, nLinks) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &Flows, MAX(nFlows, 1)) );
+   BMSclearMemoryArray(Nodes, nNodes);
+   BMSclearMemoryArray(Links, nLinks);
+   BMSclearMemoryArray(Flows, MAX(nFlows, 1));
+   for( i = 0; i < nNodes; i++ )
+   {
+      Nodes[i].ProcDelay = origNodes[i].ProcDelay;
+      Nodes[i].QueueDelay = origNodes[i].QueueDelay;
+      Nodes[i].Jitter = origNodes[i].Jitter;
+      Nodes[i].IsOptical = origNodes[i].IsOptical;
+      Nodes[i].nConnLinks = origNodes[i].nConnLinks;
+   }
+   for( i = 0; i < nLinks; i++ )
+   {
+      Links[i].Capacity = origLinks[i].Capacity;
+      Links[i].TransDelay = origLinks[i].TransDelay;
+      Links[i].PropDelay = origLinks[i].PropDelay;
+      Links[i].BandCost = origLinks[i].BandCost;
+      Links[i].IsOptical = origLinks[i].IsOptical;
+      Links[i].Head = origLinks[i].Head;
+      Links[i].Tail = origLinks[i].Tail;
+   }
+   for( i = 0; i < nFlows; i++ )
+   {
+      Flows[i].Source = origFlows[i].Source;
+      Flows[i].Destination = origFlows[i].Destination;
+      Flows[i].Priority = origFlows[i].Priority;
+      Flows[i].BandWidth = origFlows[i].BandWidth;
+      Flows[i].DelayPrice = origFlows[i].DelayPrice;
+      Flows[i].JitterPrice = origFlows[i].JitterPrice;
+   }
+
+   memset(&header, 0, sizeof(header));
+   memcpy(header.magic, OAARB_MAGIC, 8);
+   header.version = OAARB_VERSION;
+   header.byteorder = OAARB_BYTEORDER;
+   header.nodesize = sizeof(OAARNode);
+   header.linksize = sizeof(OAARLink);
+   header.flowsize = sizeof(OAARFlow);
+   header.nNodes = nNodes;
+   header.nOpticalNodes = SCIPprobdataGetNOpticalNodes(probdata);
+   header.nLinks = nLinks;
+   header.nOpticalLinks = SCIPprobdataGetNOpticalLinks(probdata);
+   header.nFlows = nFlows;
+
+   sections[OAARB_NAME] = name;
+   sections[OAARB_NODES] = Nodes;
+   sections[OAARB_LINKS] = Links;
+   sections[OAARB_FLOWS] = Flows;
+   sections[OAARB_OUTBEG] = adj->OutBeg;
+   sections[OAARB_OUTOPTEND] = adj->OutOptEnd;
+   sections[OAARB_OUTLINKS] = adj->OutLinks;
+   sections[OAARB_INBEG] = adj->InBeg;
+   sections[OAARB_INOPTEND] = adj->InOptEnd;
+   sections[OAARB_INLINKS] = adj->InLinks;
+
+   header.length[OAARB_NAME] = strlen(name) + 1;
+   header.length[OAARB_NODES] = (uint64_t)nNodes * sizeof(OAARNode);
+   header.length[OAARB_LINKS] = (uint64_t)nLinks * sizeof(OAARLink);
+   header.length[OAARB_FLOWS] = (uint64_t)nFlows * sizeof(OAARFlow);
+   header.length[OAARB_OUTBEG] = (uint64_t)(nNodes + 1) * sizeof(int);
+   header.length[OAARB_OUTOPTEND] = (uint64_t)nNodes * sizeof(int);
+   header.length[OAARB_OUTLINKS] = (uint64_t)nLinks * sizeof(int);
+   header.length[OAARB_INBEG] = header.length[OAARB_OUTBEG];
+   header.length[OAARB_INOPTEND] = header.length[OAARB_OUTOPTEND];
+   header.length[OAARB_INLINKS] = header.length[OAARB_OUTLINKS];
+
+   offset = OAARB_DATASTART;
+   for( s = 0; s < OAARB_NSECTIONS; s++ )
+   {
+      header.offset[s] = offset;
+      offset += alignSize(header.length[s]);
+   }
+   header.filesize = offset;
+
+   /* the checksum of the data goes into the header, which is written first, hence the data is passed twice */
+   header.datachecksum = 0xCBF29CE484222325ULL;
+   for( s = 0; s < OAARB_NSECTIONS; s++ )
+      emitSection(NULL, &header.datachecksum, sections[s], header.length[s]);
+   header.headerchecksum = getHeaderChecksum(&header);
+
+   if( file == NULL )
+      file = stdout;
+
+   memset(headerblock, 0, sizeof(headerblock));
+   memcpy(headerblock, &header, sizeof(header));
+   (void) fwrite(headerblock, 1, sizeof(headerblock), file);
+
+   checksum = 0xCBF29CE484222325ULL;
+   for( s = 0; s < OAARB_NSECTIONS; s++ )
+      emitSection(file, &checksum, sections[s], header.length[s]);
+   assert(checksum == header.datachecksum);
+
+   SCIPfreeBufferArray(scip, &Flows);
+   SCIPfreeBufferArray(scip, &Links);
+   SCIPfreeBufferArray(scip, &Nodes);
+
+   if( ferror(file) )
+   {
+      SCIPerrorMessage("error while writing the .oaarb file\n");
+      return SCIP_WRITEERROR;
+   }
+
+   *result = SCIP_SUCCESS;
+
+   return SCIP_OKAY;
+}
+
+/**@} */
+
+
+/**@name Interface methods
+ *
+ * @{
+ */
+
+/** includes the .oaarb file reader and writer in SCIP */
+SCIP_RETCODE SCIPincludeReaderOAARB(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_READER* reader;
+
+   SCIP_CALL( SCIPincludeReaderBasic(scip, &reader, READER_NAME, READER_DESC, READER_EXTENSION, NULL) );
+   assert(reader != NULL);
+
+   SCIP_CALL( SCIPsetReaderRead(scip, reader, readerReadOAARB) );
+   SCIP_CALL( SCIPsetReaderWrite(scip, reader, readerWriteOAARB) );
+
+   SCIP_CALL( SCIPaddBoolParam(scip, "reading/"READER_NAME"/checkdata",
+         "should the checksum and the indices of the data be verified when reading (touches every page of the file)?",
+         NULL, FALSE, DEFAULT_CHECKDATA, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
+
+/**@} */
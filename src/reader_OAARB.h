@@ -0,0 +1,24 @@
+/**@file   reader_OAARB.h
+ * @brief  OAAR binary file reader and writer
+ * @author He Xingqiu
+ *
+ * The .oaarb format stores the Node, Link (including the artificial links) and Flow arrays and the adjacency of an
+ * OAAR problem in the memory layout used by the solver, such that a mapped file is used without copying.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_READER_OAARB_H__
+#define __SCIP_READER_OAARB_H__
+
+
+#include "scip/scip.h"
+
+
+/** includes the .oaarb file reader and writer in SCIP */
+extern
+SCIP_RETCODE SCIPincludeReaderOAARB(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+#endif
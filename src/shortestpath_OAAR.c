@@ -0,0 +1,411 @@
+/**@file   shortestpath_OAAR.c
+ * @brief  Combinatorial pricing engine: shortest paths over a wavelength-layered graph
+ * @author He Xingqiu
+ *
+ * Each node v of the topology is split into nWaveLength+1 states: one state per wavelength and one electrical state.
+ * The pricing MIP (see initPricing() in pricer_OAAR.c) requires that the wavelengths entering an optical node on
+ * optical links also leave it on optical links (subCons5), except at the destination. Hence, at an optical node the
+ * path either stays in the electrical state and leaves on an electrical link, or it stays on the wavelength layer it
+ * arrived on and leaves on an optical link. At an electrical node the path may switch freely. Running Dijkstra on
+ * these states gives the same optimal paths as the MIP as long as every optical link carries the flow on a single
+ * wavelength.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <string.h>
+
+#include "shortestpath_OAAR.h"
+
+/** @brief Layered graph; it is not modified by the shortest path computation and can be shared between threads */
+struct SCIP_LayeredGraph
+{
+   OAARAdjacency*        adj;                /**< out- and in-links of each node, owned by the problem data */
+   int*                  linktail;           /**< tail node of each link */
+   int                   nNodes;             /**< number of nodes */
+   int                   nOpticalNodes;      /**< number of optical nodes */
+   int                   nLinks;             /**< number of links */
+   int                   nOpticalLinks;      /**< number of optical links */
+   int                   nstates;            /**< number of states, nNodes*(nWaveLength+1) */
+};
+
+/** @brief Working arrays of the label-setting algorithm; each thread needs its own workspace */
+struct SCIP_LayeredGraphWs
+{
+   int                   nstates;            /**< number of states the arrays are allocated for */
+   SCIP_Real*            dist;               /**< distance label of each state */
+   int*                  predstate;          /**< predecessor state on the cheapest path */
+   int*                  predlink;           /**< link used to reach the state */
+   int*                  predwave;           /**< wavelength used to reach the state, -1 for electrical links */
+   int*                  heap;               /**< binary heap of states ordered by distance */
+   int*                  heappos;            /**< position of each state in the heap, -1 if not in the heap */
+   int                   nheap;              /**< number of states in the heap */
+};
+
+/** number of layers: one per wavelength and the electrical layer */
+#define NLAYERS              (nWaveLength+1)
+
+/** index of the electrical layer */
+#define ELECLAYER            nWaveLength
+
+/**@name Local methods
+ *
+ * @{
+ */
+
+/** moves the heap element at position pos up until the heap property holds */
+static
+void heapUp(
+   SCIP_LAYEREDGRAPHWS*  ws,                 /**< workspace */
+   int                   pos                 /**< position in the heap */
+   )
+{
+   int state;
+   int parent;
+
+   state = ws->heap[pos];
+   while( pos > 0 )
+   {
+      parent = (pos - 1) / 2;
+      if( ws->dist[ws->heap[parent]] <= ws->dist[state] )
+         break;
+      ws->heap[pos] = ws->heap[parent];
+      ws->heappos[ws->heap[pos]] = pos;
+      pos = parent;
+   }
+   ws->heap[pos] = state;
+   ws->heappos[state] = pos;
+}
+
+/** moves the heap element at position pos down until the heap property holds */
+static
+void heapDown(
+   SCIP_LAYEREDGRAPHWS*  ws,                 /**< workspace */
+   int                   pos                 /**< position in the heap */
+   )
+{
+   int state;
+   int child;
+
+   state = ws->heap[pos];
+   while( 2 * pos + 1 < ws->nheap )
+   {
+      child = 2 * pos + 1;
+      if( child + 1 < ws->nheap && ws->dist[ws->heap[child+1]] < ws->dist[ws->heap[child]] )
+         child++;
+      if( ws->dist[state] <= ws->dist[ws->heap[child]] )
+         break;
+      ws->heap[pos] = ws->heap[child];
+      ws->heappos[ws->heap[pos]] = pos;
+      pos = child;
+   }
+   ws->heap[pos] = state;
+   ws->heappos[state] = pos;
+}
+
+/** updates the label of a state if the given distance is smaller */
+static
+void relaxState(
+   SCIP_LAYEREDGRAPHWS*  ws,                 /**< workspace */
+   int                   from,               /**< state the arc starts at */
+   int                   to,                 /**< state the arc ends at */
+   SCIP_Real             dist,               /**< distance of to when reached via this arc */
+   int                   link,               /**< link of the arc */
+   int                   wave                /**< wavelength of the arc, -1 for electrical links */
+   )
+{
+   if( dist >= ws->dist[to] )
+      return;
+
+   ws->dist[to] = dist;
+   ws->predstate[to] = from;
+   ws->predlink[to] = link;
+   ws->predwave[to] = wave;
+
+   if( ws->heappos[to] < 0 )
+   {
+      ws->heap[ws->nheap] = to;
+      ws->heappos[to] = ws->nheap;
+      ws->nheap++;
+   }
+   heapUp(ws, ws->heappos[to]);
+}
+
+/** removes and returns the state with the smallest distance label */
+static
+int heapPop(
+   SCIP_LAYEREDGRAPHWS*  ws                  /**< workspace */
+   )
+{
+   int state;
+
+   assert(ws->nheap > 0);
+
+   state = ws->heap[0];
+   ws->heappos[state] = -1;
+   ws->nheap--;
+   if( ws->nheap > 0 )
+   {
+      ws->heap[0] = ws->heap[ws->nheap];
+      ws->heappos[ws->heap[0]] = 0;
+      heapDown(ws, 0);
+   }
+
+   return state;
+}
+
+/**@} */
+
+
+/**@name Interface methods
+ *
+ * @{
+ */
+
+/** creates the layered graph for the given topology */
+SCIP_RETCODE SCIPlayeredgraphCreate(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_LAYEREDGRAPH**   graph,              /**< pointer to store the layered graph */
+   OAARLink*             Links,              /**< Links array */
+   OAARAdjacency*        adj,                /**< out- and in-links of each node; must live as long as the graph */
+   int                   nNodes,             /**< number of nodes */
+   int                   nOpticalNodes,      /**< number of optical nodes */
+   int                   nLinks,             /**< number of links (including the artificial ones) */
+   int                   nOpticalLinks       /**< number of optical links */
+   )
+{
+   int i;
+
+   assert(scip != NULL);
+   assert(graph != NULL);
+   assert(adj != NULL);
+
+   SCIP_CALL( SCIPallocMemory(scip, graph) );
+
+   (*graph)->nNodes = nNodes;
+   (*graph)->nOpticalNodes = nOpticalNodes;
+   (*graph)->nLinks = nLinks;
+   (*graph)->nOpticalLinks = nOpticalLinks;
+   (*graph)->nstates = nNodes * NLAYERS;
+
+   (*graph)->adj = adj;
+
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*graph)->linktail, nLinks) );
+   for( i = 0; i < nLinks; i++ )
+      (*graph)->linktail[i] = Links[i].Tail;
+
+   return SCIP_OKAY;
+}
+
+/** frees the layered graph */
+void SCIPlayeredgraphFree(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_LAYEREDGRAPH**   graph               /**< pointer to the layered graph */
+   )
+{
+   assert(graph != NULL);
+
+   if( *graph == NULL )
+      return;
+
+   SCIPfreeMemoryArray(scip, &(*graph)->linktail);
+   SCIPfreeMemory(scip, graph);
+}
+
+/** creates a workspace for shortest path computations on the given layered graph */
+SCIP_RETCODE SCIPlayeredgraphCreateWs(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_LAYEREDGRAPH*    graph,              /**< layered graph */
+   SCIP_LAYEREDGRAPHWS** ws                  /**< pointer to store the workspace */
+   )
+{
+   assert(scip != NULL);
+   assert(graph != NULL);
+   assert(ws != NULL);
+
+   SCIP_CALL( SCIPallocMemory(scip, ws) );
+
+   (*ws)->nstates = graph->nstates;
+   (*ws)->nheap = 0;
+
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*ws)->dist, graph->nstates) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*ws)->predstate, graph->nstates) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*ws)->predlink, graph->nstates) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*ws)->predwave, graph->nstates) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*ws)->heap, graph->nstates) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*ws)->heappos, graph->nstates) );
+
+   return SCIP_OKAY;
+}
+
+/** frees a workspace */
+void SCIPlayeredgraphFreeWs(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_LAYEREDGRAPHWS** ws                  /**< pointer to the workspace */
+   )
+{
+   assert(ws != NULL);
+
+   if( *ws == NULL )
+      return;
+
+   SCIPfreeMemoryArray(scip, &(*ws)->heappos);
+   SCIPfreeMemoryArray(scip, &(*ws)->heap);
+   SCIPfreeMemoryArray(scip, &(*ws)->predwave);
+   SCIPfreeMemoryArray(scip, &(*ws)->predlink);
+   SCIPfreeMemoryArray(scip, &(*ws)->predstate);
+   SCIPfreeMemoryArray(scip, &(*ws)->dist);
+   SCIPfreeMemory(scip, ws);
+}
+
+/** computes a cheapest path from source to dest with wavelength continuity at the optical nodes
+ *
+ *  The cost of a path is the sum of linkcost over its links plus wavecost[e*nWaveLength+w] for each optical link e
+ *  that is used on wavelength w. Links or wavelengths with cost SCIP_INVALID are forbidden. All costs have to be
+ *  non-negative. The graph is only read, so several threads may compute paths at the same time as long as each of
+ *  them uses its own workspace.
+ */
+SCIP_RETCODE SCIPlayeredgraphShortestPath(
+   SCIP_LAYEREDGRAPH*    graph,              /**< layered graph */
+   SCIP_LAYEREDGRAPHWS*  ws,                 /**< workspace of the calling thread */
+   int                   source,             /**< source node */
+   int                   dest,               /**< destination node */
+   SCIP_Real*            linkcost,           /**< cost of each link */
+   SCIP_Real*            wavecost,           /**< cost of each wavelength of each optical link */
+   SCIP_Bool             opticalallowed,     /**< may optical links be used at all? */
+   int*                  pathlinks,          /**< array of size nNodes*(nWaveLength+1) to store the links of the path,
+                                              *   ordered from source to dest */
+   int*                  pathwaves,          /**< array of the same size to store the wavelength of each path link,
+                                              *   -1 for electrical links */
+   int*                  npathlinks,         /**< pointer to store the number of links of the path */
+   SCIP_Real*            pathcost,           /**< pointer to store the cost of the path */
+   SCIP_Bool*            found               /**< pointer to store whether dest is reachable */
+   )
+{
+   int state;
+   int layer;
+   int v;
+   int t;
+   int e;
+   int w;
+   int wfirst;
+   int wlast;
+   int idx;
+   int n;
+   int i;
+
+   assert(graph != NULL);
+   assert(ws != NULL);
+   assert(ws->nstates == graph->nstates);
+   assert(linkcost != NULL);
+   assert(wavecost != NULL);
+   assert(pathlinks != NULL);
+   assert(pathwaves != NULL);
+   assert(npathlinks != NULL);
+   assert(pathcost != NULL);
+   assert(found != NULL);
+   assert(0 <= source && source < graph->nNodes);
+   assert(0 <= dest && dest < graph->nNodes);
+
+   *found = FALSE;
+   *npathlinks = 0;
+   *pathcost = SCIP_INVALID;
+
+   for( i = 0; i < graph->nstates; i++ )
+   {
+      ws->dist[i] = SCIP_INVALID;
+      ws->heappos[i] = -1;
+   }
+   ws->nheap = 0;
+
+   /* the path starts in the electrical layer: a lightpath cannot begin at an optical source node (subCons5) */
+   relaxState(ws, -1, source * NLAYERS + ELECLAYER, 0.0, -1, -1);
+
+   while( ws->nheap > 0 )
+   {
+      state = heapPop(ws);
+      v = state / NLAYERS;
+      layer = state % NLAYERS;
+
+      if( v == dest )
+      {
+         *found = TRUE;
+         *pathcost = ws->dist[state];
+         break;
+      }
+
+      for( idx = graph->adj->OutBeg[v]; idx < graph->adj->OutBeg[v+1]; idx++ )
+      {
+         e = graph->adj->OutLinks[idx];
+         t = graph->linktail[e];
+
+         if( linkcost[e] >= SCIP_INVALID )
+            continue;
+
+         if( e >= graph->nOpticalLinks )
+         {
+            /* a wavelength entering an optical node has to leave it on an optical link */
+            if( v < graph->nOpticalNodes && layer != ELECLAYER )
+               continue;
+
+            relaxState(ws, state, t * NLAYERS + ELECLAYER, ws->dist[state] + linkcost[e], e, -1);
+         }
+         else
+         {
+            if( !opticalallowed )
+               continue;
+
+            /* at an optical node the wavelength is fixed by the incoming optical link */
+            if( v < graph->nOpticalNodes )
+            {
+               if( layer == ELECLAYER )
+                  continue;
+               wfirst = layer;
+               wlast = layer;
+            }
+            else
+            {
+               wfirst = 0;
+               wlast = nWaveLength - 1;
+            }
+
+            for( w = wfirst; w <= wlast; w++ )
+            {
+               if( wavecost[e*nWaveLength+w] >= SCIP_INVALID )
+                  continue;
+
+               relaxState(ws, state, t * NLAYERS + (t < graph->nOpticalNodes ? w : ELECLAYER),
+                  ws->dist[state] + linkcost[e] + wavecost[e*nWaveLength+w], e, w);
+            }
+         }
+      }
+   }
+
+   if( !(*found) )
+      return SCIP_OKAY;
+
+   /* collect the path backwards and reverse it */
+   n = 0;
+   while( ws->predstate[state] >= 0 )
+   {
+      pathlinks[n] = ws->predlink[state];
+      pathwaves[n] = ws->predwave[state];
+      n++;
+      state = ws->predstate[state];
+   }
+   for( i = 0; i < n / 2; i++ )
+   {
+      e = pathlinks[i];
+      pathlinks[i] = pathlinks[n-1-i];
+      pathlinks[n-1-i] = e;
+      w = pathwaves[i];
+      pathwaves[i] = pathwaves[n-1-i];
+      pathwaves[n-1-i] = w;
+   }
+   *npathlinks = n;
+
+   return SCIP_OKAY;
+}
+
+/**@} */
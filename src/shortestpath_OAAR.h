@@ -0,0 +1,81 @@
+/**@file   shortestpath_OAAR.h
+ * @brief  Combinatorial pricing engine: shortest paths over a wavelength-layered graph
+ * @author He Xingqiu
+ *
+ * The pricing problem of a flow is a cheapest source-destination path in which optical links keep the same
+ * wavelength while passing optical nodes. This file provides a label-setting (Dijkstra) algorithm on a graph with one
+ * layer per wavelength plus one electrical layer, which solves that problem without a MIP.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_SHORTESTPATH_OAAR__
+#define __SCIP_SHORTESTPATH_OAAR__
+
+#include "scip/scip.h"
+#include "OAARdataStructure.h"
+
+typedef struct SCIP_LayeredGraph SCIP_LAYEREDGRAPH;
+typedef struct SCIP_LayeredGraphWs SCIP_LAYEREDGRAPHWS;
+
+/** creates the layered graph for the given topology */
+extern
+SCIP_RETCODE SCIPlayeredgraphCreate(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_LAYEREDGRAPH**   graph,              /**< pointer to store the layered graph */
+   OAARLink*             Links,              /**< Links array */
+   OAARAdjacency*        adj,                /**< out- and in-links of each node; must live as long as the graph */
+   int                   nNodes,             /**< number of nodes */
+   int                   nOpticalNodes,      /**< number of optical nodes */
+   int                   nLinks,             /**< number of links (including the artificial ones) */
+   int                   nOpticalLinks       /**< number of optical links */
+   );
+
+/** frees the layered graph */
+extern
+void SCIPlayeredgraphFree(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_LAYEREDGRAPH**   graph               /**< pointer to the layered graph */
+   );
+
+/** creates a workspace for shortest path computations on the given layered graph */
+extern
+SCIP_RETCODE SCIPlayeredgraphCreateWs(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_LAYEREDGRAPH*    graph,              /**< layered graph */
+   SCIP_LAYEREDGRAPHWS** ws                  /**< pointer to store the workspace */
+   );
+
+/** frees a workspace */
+extern
+void SCIPlayeredgraphFreeWs(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_LAYEREDGRAPHWS** ws                  /**< pointer to the workspace */
+   );
+
+/** computes a cheapest path from source to dest with wavelength continuity at the optical nodes
+ *
+ *  The cost of a path is the sum of linkcost over its links plus wavecost[e*nWaveLength+w] for each optical link e
+ *  that is used on wavelength w. Links or wavelengths with cost SCIP_INVALID are forbidden. All costs have to be
+ *  non-negative. The graph is only read, so several threads may compute paths at the same time as long as each of
+ *  them uses its own workspace.
+ */
+extern
+SCIP_RETCODE SCIPlayeredgraphShortestPath(
+   SCIP_LAYEREDGRAPH*    graph,              /**< layered graph */
+   SCIP_LAYEREDGRAPHWS*  ws,                 /**< workspace of the calling thread */
+   int                   source,             /**< source node */
+   int                   dest,               /**< destination node */
+   SCIP_Real*            linkcost,           /**< cost of each link */
+   SCIP_Real*            wavecost,           /**< cost of each wavelength of each optical link */
+   SCIP_Bool             opticalallowed,     /**< may optical links be used at all? */
+   int*                  pathlinks,          /**< array of size nNodes*(nWaveLength+1) to store the links of the path,
+                                              *   ordered from source to dest */
+   int*                  pathwaves,          /**< array of the same size to store the wavelength of each path link,
+                                              *   -1 for electrical links */
+   int*                  npathlinks,         /**< pointer to store the number of links of the path */
+   SCIP_Real*            pathcost,           /**< pointer to store the cost of the path */
+   SCIP_Bool*            found               /**< pointer to store whether dest is reachable */
+   );
+
+#endif
@@ -0,0 +1,73 @@
+/**@file   table_OAAR.c
+ * @brief  statistics table of the OAAR pricer
+ * @author He Xingqiu
+ *
+ * Statistics tables exist since SCIP 5.0. With older versions, nothing is included here and the pricer prints the
+ * statistics at the end of the solve instead.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+
+#include "pricer_OAAR.h"
+#include "table_OAAR.h"
+
+/**@name Table properties
+ *
+ * @{
+ */
+
+#define TABLE_NAME             "oaar"
+#define TABLE_DESC             "pricing statistics of the OAAR pricer"
+#define TABLE_POSITION         17500    /**< the position of the statistics table */
+#define TABLE_EARLIEST_STAGE   SCIP_STAGE_SOLVING /**< output of the statistics table is only printed from this stage onwards */
+
+/**@} */
+
+#if SCIP_VERSION >= 500
+
+/**@name Callback methods
+ *
+ * @{
+ */
+
+/** output method of statistics table to output file stream 'file' */
+static
+SCIP_DECL_TABLEOUTPUT(tableOutputOAAR)
+{  /*lint --e{715}*/
+   assert(scip != NULL);
+   assert(table != NULL);
+
+   SCIP_CALL( SCIPpricerOAARPrintStatistics(scip, file) );
+
+   return SCIP_OKAY;
+}
+
+/**@} */
+
+#endif
+
+
+/**@name Interface methods
+ *
+ * @{
+ */
+
+/** creates the OAAR statistics table and includes it in SCIP; the OAAR pricer has to be included before */
+SCIP_RETCODE SCIPincludeTableOAAR(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   assert(scip != NULL);
+   assert(SCIPfindPricer(scip, "OAAR") != NULL);
+
+#if SCIP_VERSION >= 500
+   SCIP_CALL( SCIPincludeTable(scip, TABLE_NAME, TABLE_DESC, TRUE, NULL, NULL, NULL, NULL, NULL, NULL,
+         tableOutputOAAR, NULL, TABLE_POSITION, TABLE_EARLIEST_STAGE) );
+#endif
+
+   return SCIP_OKAY;
+}
+
+/**@} */
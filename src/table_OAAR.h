@@ -0,0 +1,22 @@
+/**@file   table_OAAR.h
+ * @brief  statistics table of the OAAR pricer
+ * @author He Xingqiu
+ *
+ * The table is part of the output of "display statistics" and shows the pricing statistics of each flow. With
+ * pricing/oaar/statsmachine, it is printed as comma separated lines which can be extracted with grep.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_TABLE_OAAR__
+#define __SCIP_TABLE_OAAR__
+
+#include "scip/scip.h"
+
+/** creates the OAAR statistics table and includes it in SCIP; the OAAR pricer has to be included before */
+extern
+SCIP_RETCODE SCIPincludeTableOAAR(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+#endif
@@ -0,0 +1,260 @@
+/**@file   threadpool_OAAR.c
+ * @brief  Pool of worker threads which process a batch of independent jobs
+ * @author He Xingqiu
+ *
+ * Jobs of a batch are handed out through a shared counter, so a thread which finishes early picks up the next job.
+ * The result of a job must only depend on its index and not on the thread which runs it; the caller collects the
+ * results after SCIPthreadpoolRun() returned, which keeps the overall outcome deterministic.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <pthread.h>
+
+#include "threadpool_OAAR.h"
+
+/** @brief Data of one worker thread */
+typedef struct SCIP_ThreadPoolWorker
+{
+   SCIP_THREADPOOL*      pool;               /**< thread pool the worker belongs to */
+   int                   id;                 /**< index of the worker, 1 <= id < nthreads */
+   pthread_t             thread;             /**< thread handle */
+} SCIP_THREADPOOLWORKER;
+
+/** @brief Thread pool data */
+struct SCIP_ThreadPool
+{
+   SCIP_THREADPOOLWORKER* workers;           /**< worker threads, the calling thread is not included */
+   int                   nworkers;           /**< number of worker threads */
+   pthread_mutex_t       mutex;              /**< mutex protecting the data below */
+   pthread_cond_t        workcond;           /**< signaled when a new batch is available or the pool shuts down */
+   pthread_cond_t        donecond;           /**< signaled when the last worker finished the current batch */
+   SCIP_DECL_THREADPOOLJOB((*jobfunc));      /**< method processing a single job of the current batch */
+   void*                 jobdata;            /**< data of the current batch */
+   int                   njobs;              /**< number of jobs of the current batch */
+   int                   nextjob;            /**< next job which is not yet started */
+   int                   nbusy;              /**< number of workers still working on the current batch */
+   unsigned int          batch;              /**< number of the current batch */
+   SCIP_RETCODE          retcode;            /**< first error of a job in the current batch */
+   SCIP_Bool             shutdown;           /**< should the workers terminate? */
+};
+
+/**@name Local methods
+ *
+ * @{
+ */
+
+/** processes jobs of the current batch until none is left */
+static
+void processJobs(
+   SCIP_THREADPOOL*      pool,               /**< thread pool */
+   int                   thread              /**< index of the calling thread */
+   )
+{
+   SCIP_RETCODE retcode;
+   int job;
+
+   while( TRUE ) /*lint !e716*/
+   {
+      pthread_mutex_lock(&pool->mutex);
+      job = pool->nextjob;
+      if( job < pool->njobs && pool->retcode == SCIP_OKAY )
+         pool->nextjob++;
+      else
+         job = -1;
+      pthread_mutex_unlock(&pool->mutex);
+
+      if( job < 0 )
+         break;
+
+      retcode = pool->jobfunc(pool->jobdata, job, thread);
+
+      if( retcode != SCIP_OKAY )
+      {
+         pthread_mutex_lock(&pool->mutex);
+         if( pool->retcode == SCIP_OKAY )
+            pool->retcode = retcode;
+         pthread_mutex_unlock(&pool->mutex);
+      }
+   }
+}
+
+/** main loop of a worker thread */
+static
+void* workerMain(
+   void*                 arg                 /**< worker data */
+   )
+{
+   SCIP_THREADPOOLWORKER* worker;
+   SCIP_THREADPOOL* pool;
+   unsigned int batch;
+
+   worker = (SCIP_THREADPOOLWORKER*)arg;
+   pool = worker->pool;
+
+   /* all workers are started before the first batch, hence a worker must not skip batch 1 even if it starts late */
+   batch = 0;
+
+   pthread_mutex_lock(&pool->mutex);
+
+   while( TRUE ) /*lint !e716*/
+   {
+      while( !pool->shutdown && pool->batch == batch )
+         pthread_cond_wait(&pool->workcond, &pool->mutex);
+
+      if( pool->shutdown )
+         break;
+
+      batch = pool->batch;
+      pthread_mutex_unlock(&pool->mutex);
+
+      processJobs(pool, worker->id);
+
+      pthread_mutex_lock(&pool->mutex);
+      pool->nbusy--;
+      if( pool->nbusy == 0 )
+         pthread_cond_signal(&pool->donecond);
+   }
+
+   pthread_mutex_unlock(&pool->mutex);
+
+   return NULL;
+}
+
+/**@} */
+
+
+/**@name Interface methods
+ *
+ * @{
+ */
+
+/** creates a thread pool with the given number of threads (including the calling thread) */
+SCIP_RETCODE SCIPthreadpoolCreate(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_THREADPOOL**     pool,               /**< pointer to store the thread pool */
+   int                   nthreads            /**< number of threads, at least 1 */
+   )
+{
+   int i;
+
+   assert(scip != NULL);
+   assert(pool != NULL);
+   assert(nthreads >= 1);
+
+   SCIP_CALL( SCIPallocMemory(scip, pool) );
+
+   (*pool)->nworkers = nthreads - 1;
+   (*pool)->jobfunc = NULL;
+   (*pool)->jobdata = NULL;
+   (*pool)->njobs = 0;
+   (*pool)->nextjob = 0;
+   (*pool)->nbusy = 0;
+   (*pool)->batch = 0;
+   (*pool)->retcode = SCIP_OKAY;
+   (*pool)->shutdown = FALSE;
+
+   pthread_mutex_init(&(*pool)->mutex, NULL);
+   pthread_cond_init(&(*pool)->workcond, NULL);
+   pthread_cond_init(&(*pool)->donecond, NULL);
+
+   (*pool)->workers = NULL;
+   if( (*pool)->nworkers == 0 )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*pool)->workers, (*pool)->nworkers) );
+
+   for( i = 0; i < (*pool)->nworkers; i++ )
+   {
+      (*pool)->workers[i].pool = *pool;
+      (*pool)->workers[i].id = i + 1;
+
+      if( pthread_create(&(*pool)->workers[i].thread, NULL, workerMain, &(*pool)->workers[i]) != 0 )
+      {
+         SCIPerrorMessage("could not start pricing thread %d\n", i + 1);
+         (*pool)->nworkers = i;
+         SCIPthreadpoolFree(scip, pool);
+         return SCIP_ERROR;
+      }
+   }
+
+   return SCIP_OKAY;
+}
+
+/** stops the worker threads and frees the thread pool */
+void SCIPthreadpoolFree(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_THREADPOOL**     pool                /**< pointer to the thread pool */
+   )
+{
+   int i;
+
+   assert(pool != NULL);
+
+   if( *pool == NULL )
+      return;
+
+   pthread_mutex_lock(&(*pool)->mutex);
+   (*pool)->shutdown = TRUE;
+   pthread_cond_broadcast(&(*pool)->workcond);
+   pthread_mutex_unlock(&(*pool)->mutex);
+
+   for( i = 0; i < (*pool)->nworkers; i++ )
+      pthread_join((*pool)->workers[i].thread, NULL);
+
+   pthread_cond_destroy(&(*pool)->donecond);
+   pthread_cond_destroy(&(*pool)->workcond);
+   pthread_mutex_destroy(&(*pool)->mutex);
+
+   SCIPfreeMemoryArrayNull(scip, &(*pool)->workers);
+   SCIPfreeMemory(scip, pool);
+}
+
+/** runs njobs jobs on the pool and waits until all of them are finished; returns the first error of a job, if any */
+SCIP_RETCODE SCIPthreadpoolRun(
+   SCIP_THREADPOOL*      pool,               /**< thread pool */
+   SCIP_DECL_THREADPOOLJOB((*jobfunc)),      /**< method processing a single job */
+   void*                 jobdata,            /**< data of the batch, passed to each job */
+   int                   njobs               /**< number of jobs */
+   )
+{
+   assert(pool != NULL);
+   assert(jobfunc != NULL);
+
+   if( njobs <= 0 )
+      return SCIP_OKAY;
+
+   pthread_mutex_lock(&pool->mutex);
+   pool->jobfunc = jobfunc;
+   pool->jobdata = jobdata;
+   pool->njobs = njobs;
+   pool->nextjob = 0;
+   pool->retcode = SCIP_OKAY;
+   pool->nbusy = pool->nworkers;
+   pool->batch++;
+   pthread_cond_broadcast(&pool->workcond);
+   pthread_mutex_unlock(&pool->mutex);
+
+   /* the calling thread works on the batch as well */
+   processJobs(pool, 0);
+
+   pthread_mutex_lock(&pool->mutex);
+   while( pool->nbusy > 0 )
+      pthread_cond_wait(&pool->donecond, &pool->mutex);
+   pthread_mutex_unlock(&pool->mutex);
+
+   return pool->retcode;
+}
+
+/** returns the number of threads of the pool (including the calling thread) */
+int SCIPthreadpoolGetNThreads(
+   SCIP_THREADPOOL*      pool                /**< thread pool */
+   )
+{
+   assert(pool != NULL);
+
+   return pool->nworkers + 1;
+}
+
+/**@} */
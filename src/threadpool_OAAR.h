@@ -0,0 +1,58 @@
+/**@file   threadpool_OAAR.h
+ * @brief  Pool of worker threads which process a batch of independent jobs
+ * @author He Xingqiu
+ *
+ * The pool is used by the pricer to solve the pricing problems of different flows in parallel. The workers are started
+ * once and wait for batches; the calling thread takes part in each batch as thread 0. Jobs must not call any method
+ * of the master SCIP which modifies it.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_THREADPOOL_OAAR__
+#define __SCIP_THREADPOOL_OAAR__
+
+#include "scip/scip.h"
+
+typedef struct SCIP_ThreadPool SCIP_THREADPOOL;
+
+/** processes job number job of the current batch
+ *
+ *  input:
+ *  - jobdata         : data of the batch given to SCIPthreadpoolRun()
+ *  - job             : index of the job, 0 <= job < njobs
+ *  - thread          : index of the thread which runs the job, 0 <= thread < SCIPthreadpoolGetNThreads()
+ */
+#define SCIP_DECL_THREADPOOLJOB(x) SCIP_RETCODE x (void* jobdata, int job, int thread)
+
+/** creates a thread pool with the given number of threads (including the calling thread) */
+extern
+SCIP_RETCODE SCIPthreadpoolCreate(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_THREADPOOL**     pool,               /**< pointer to store the thread pool */
+   int                   nthreads            /**< number of threads, at least 1 */
+   );
+
+/** stops the worker threads and frees the thread pool */
+extern
+void SCIPthreadpoolFree(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_THREADPOOL**     pool                /**< pointer to the thread pool */
+   );
+
+/** runs njobs jobs on the pool and waits until all of them are finished; returns the first error of a job, if any */
+extern
+SCIP_RETCODE SCIPthreadpoolRun(
+   SCIP_THREADPOOL*      pool,               /**< thread pool */
+   SCIP_DECL_THREADPOOLJOB((*jobfunc)),      /**< method processing a single job */
+   void*                 jobdata,            /**< data of the batch, passed to each job */
+   int                   njobs               /**< number of jobs */
+   );
+
+/** returns the number of threads of the pool (including the calling thread) */
+extern
+int SCIPthreadpoolGetNThreads(
+   SCIP_THREADPOOL*      pool                /**< thread pool */
+   );
+
+#endif
@@ -16,13 +16,19 @@
  *  Therefore, the variable data
  *  contains the ids of constraints in which the variable is part of. 
  *  Hence, that data give us a column view.
+ *
+ *  The path of the column is stored as the sorted indices of the original variables with value one, a few entries per
+ *  link of the path instead of one per original variable.
  */
 struct SCIP_VarData
 {
    int*                  consids;
    int                   nconsids;
-   int*                  oriFlowVars;
-   int                   nOriFlowVars;
+   int*                  oriVars;            /**< sorted indices of the original variables with value one */
+   int                   nOriVars;           /**< number of original variables with value one */
+   int                   nOriFlowVars;       /**< number of original variables of a column */
+   int                   flow;               /**< index of the flow the column routes */
+   int                   colid;              /**< number of the column among the columns of its flow */
 };
 
 /**@name Local methods
@@ -37,19 +43,43 @@ SCIP_RETCODE vardataCreate(
    SCIP_VARDATA**        vardata,            /**< pointer to vardata */
    int*                  consids,            /**< array of constraints ids */
    int                   nconsids,           /**< number of constraints */
-   int*                  oriFlowVars,
-   int                   nOriFlowVars
+   int*                  oriFlowVars,        /**< value (0 or 1) of each original variable */
+   int                   nOriFlowVars,       /**< number of original variables */
+   int                   flow,               /**< index of the flow the column routes */
+   int                   colid               /**< number of the column among the columns of its flow */
    )
 {
+   int nOriVars;
+   int i;
+
    SCIP_CALL( SCIPallocBlockMemory(scip, vardata) );
 
    SCIP_CALL( SCIPduplicateBlockMemoryArray(scip, &(*vardata)->consids, consids, nconsids) );
-   SCIP_CALL( SCIPduplicateBlockMemoryArray(scip, &(*vardata)->oriFlowVars, oriFlowVars, 
-      nOriFlowVars) );
    SCIPsortInt((*vardata)->consids, nconsids);
 
+   nOriVars = 0;
+   for( i = 0; i < nOriFlowVars; i++ )
+   {
+      if( oriFlowVars[i] == 1 )
+         nOriVars++;
+   }
+
+   SCIP_CALL( SCIPallocBlockMemoryArray(scip, &(*vardata)->oriVars, nOriVars) );
+   nOriVars = 0;
+   for( i = 0; i < nOriFlowVars; i++ )
+   {
+      if( oriFlowVars[i] == 1 )
+      {
+         (*vardata)->oriVars[nOriVars] = i;
+         nOriVars++;
+      }
+   }
+
    (*vardata)->nconsids = nconsids;
+   (*vardata)->nOriVars = nOriVars;
    (*vardata)->nOriFlowVars = nOriFlowVars;
+   (*vardata)->flow = flow;
+   (*vardata)->colid = colid;
 
    return SCIP_OKAY;
 }
@@ -62,7 +92,7 @@ SCIP_RETCODE vardataDelete(
    )
 {
    SCIPfreeBlockMemoryArray(scip, &(*vardata)->consids, (*vardata)->nconsids);
-   SCIPfreeBlockMemoryArray(scip, &(*vardata)->oriFlowVars, (*vardata)->nOriFlowVars);
+   SCIPfreeBlockMemoryArray(scip, &(*vardata)->oriVars, (*vardata)->nOriVars);
    SCIPfreeBlockMemory(scip, vardata);
 
    return SCIP_OKAY;
@@ -99,11 +129,13 @@ SCIP_RETCODE SCIPvardataCreateOAAR(
    SCIP_VARDATA**        vardata,            /**< pointer to vardata */
    int*                  consids,            /**< array of constraints ids */
    int                   nconsids,           /**< number of constraints */
-   int*                  oriFlowVars,
-   int                   nOriFlowVars
+   int*                  oriFlowVars,        /**< value (0 or 1) of each original variable */
+   int                   nOriFlowVars,       /**< number of original variables */
+   int                   flow,               /**< index of the flow the column routes */
+   int                   colid               /**< number of the column among the columns of its flow */
    )
 {
-   SCIP_CALL( vardataCreate(scip, vardata, consids, nconsids, oriFlowVars, nOriFlowVars) );
+   SCIP_CALL( vardataCreate(scip, vardata, consids, nconsids, oriFlowVars, nOriFlowVars, flow, colid) );
 
    return SCIP_OKAY;
 }
@@ -132,17 +164,83 @@ int* SCIPvardataGetConsids(
 
    return vardata->consids;
 }
+
+/** returns the number of original variables of a column */
 int SCIPvardataGetNOriFlowVars(
-   SCIP_VARDATA*       vardata
+   SCIP_VARDATA*         vardata             /**< variable data */
    )
 {
    return vardata->nOriFlowVars;
 }
-int* SCIPvardataGetOriFlowVars(
-   SCIP_VARDATA*       vardata
+
+/** returns the number of original variables with value one in the column */
+int SCIPvardataGetNOriVars(
+   SCIP_VARDATA*         vardata             /**< variable data */
    )
 {
-   return vardata->oriFlowVars;
+   return vardata->nOriVars;
+}
+
+/** returns the sorted indices of the original variables with value one in the column */
+int* SCIPvardataGetOriVars(
+   SCIP_VARDATA*         vardata             /**< variable data */
+   )
+{
+   return vardata->oriVars;
+}
+
+/** returns whether the original variable j has value one in the column */
+SCIP_Bool SCIPvardataHasOriVar(
+   SCIP_VARDATA*         vardata,            /**< variable data */
+   int                   j                   /**< index of the original variable */
+   )
+{
+   int pos;
+
+   assert(0 <= j && j < vardata->nOriFlowVars);
+
+   return SCIPsortedvecFindInt(vardata->oriVars, j, vardata->nOriVars, &pos);
+}
+
+/** returns whether the column has the given values of the original variables */
+SCIP_Bool SCIPvardataEqualsOriFlowVars(
+   SCIP_VARDATA*         vardata,            /**< variable data */
+   int*                  oriFlowVars         /**< value (0 or 1) of each original variable */
+   )
+{
+   int nOriVars;
+   int i;
+
+   for( i = 0; i < vardata->nOriVars; i++ )
+   {
+      if( oriFlowVars[vardata->oriVars[i]] != 1 )
+         return FALSE;
+   }
+
+   nOriVars = 0;
+   for( i = 0; i < vardata->nOriFlowVars; i++ )
+   {
+      if( oriFlowVars[i] == 1 )
+         nOriVars++;
+   }
+
+   return nOriVars == vardata->nOriVars;
+}
+
+/** returns the index of the flow the column routes */
+int SCIPvardataGetFlow(
+   SCIP_VARDATA*         vardata             /**< variable data */
+   )
+{
+   return vardata->flow;
+}
+
+/** returns the number of the column among the columns of its flow */
+int SCIPvardataGetColid(
+   SCIP_VARDATA*         vardata             /**< variable data */
+   )
+{
+   return vardata->colid;
 }
 
 
@@ -189,6 +287,7 @@ void SCIPvardataPrint(
 {
    int i;
 
+   SCIPinfoMessage(scip, file, "flow = %d, colid = %d\n", vardata->flow, vardata->colid);
    SCIPinfoMessage(scip, file, "consids = {");
 
    for( i = 0; i < vardata->nconsids; ++i )
@@ -201,11 +300,12 @@ void SCIPvardataPrint(
 
    SCIPinfoMessage(scip, file, "}\n");
 
-   SCIPinfoMessage(scip, file, "oriFlowVars = {");
-   for(i = 0; i < vardata->nOriFlowVars; i++)
+   SCIPinfoMessage(scip, file, "oriVars = {");
+   for( i = 0; i < vardata->nOriVars; i++ )
    {
-      SCIPinfoMessage(scip, file, "%d", vardata->oriFlowVars[i]);
-      if(i < vardata->nOriFlowVars)
+      SCIPinfoMessage(scip, file, "%d", vardata->oriVars[i]);
+
+      if( i < vardata->nOriVars - 1 )
          SCIPinfoMessage(scip, file, ",");
    }
    SCIPinfoMessage(scip, file, "}\n");
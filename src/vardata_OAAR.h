@@ -19,8 +19,10 @@ SCIP_RETCODE SCIPvardataCreateOAAR(
    SCIP_VARDATA**        vardata,            /**< pointer to vardata */
    int*                  consids,            /**< array of constraints ids */
    int                   nconss,             /**< number of constraints */
-   int*                  oriFlowVars,
-   int                   nOriFlowVars
+   int*                  oriFlowVars,        /**< value (0 or 1) of each original variable */
+   int                   nOriFlowVars,       /**< number of original variables */
+   int                   flow,               /**< index of the flow the column routes */
+   int                   colid               /**< number of the column among the columns of its flow */
    );
 
 /** get number of constraints */
@@ -35,14 +37,48 @@ int* SCIPvardataGetConsids(
    SCIP_VARDATA*         vardata             /**< variable data */
    );
 
+/** returns the number of original variables of a column */
 extern
-int* SCIPvardataGetOriFlowVars(
-   SCIP_VARDATA*         vardata
+int SCIPvardataGetNOriFlowVars(
+   SCIP_VARDATA*         vardata             /**< variable data */
    );
 
+/** returns the number of original variables with value one in the column */
 extern
-int SCIPvardataGetNOriFlowVars(
-   SCIP_VARDATA*         vardata
+int SCIPvardataGetNOriVars(
+   SCIP_VARDATA*         vardata             /**< variable data */
+   );
+
+/** returns the sorted indices of the original variables with value one in the column */
+extern
+int* SCIPvardataGetOriVars(
+   SCIP_VARDATA*         vardata             /**< variable data */
+   );
+
+/** returns whether the original variable j has value one in the column */
+extern
+SCIP_Bool SCIPvardataHasOriVar(
+   SCIP_VARDATA*         vardata,            /**< variable data */
+   int                   j                   /**< index of the original variable */
+   );
+
+/** returns whether the column has the given values of the original variables */
+extern
+SCIP_Bool SCIPvardataEqualsOriFlowVars(
+   SCIP_VARDATA*         vardata,            /**< variable data */
+   int*                  oriFlowVars         /**< value (0 or 1) of each original variable */
+   );
+
+/** returns the index of the flow the column routes */
+extern
+int SCIPvardataGetFlow(
+   SCIP_VARDATA*         vardata             /**< variable data */
+   );
+
+/** returns the number of the column among the columns of its flow */
+extern
+int SCIPvardataGetColid(
+   SCIP_VARDATA*         vardata             /**< variable data */
    );
 
 /** creates variable */